@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench_fileIO"
+  "../bin/bench_fileIO.pdb"
+  "CMakeFiles/bench_fileIO.dir/bench_fileIO.cpp.o"
+  "CMakeFiles/bench_fileIO.dir/bench_fileIO.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_fileIO.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench_matPlot"
+  "../bin/bench_matPlot.pdb"
+  "CMakeFiles/bench_matPlot.dir/bench_matPlot.cpp.o"
+  "CMakeFiles/bench_matPlot.dir/bench_matPlot.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_matPlot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench_outputSink"
+  "../bin/bench_outputSink.pdb"
+  "CMakeFiles/bench_outputSink.dir/bench_outputSink.cpp.o"
+  "CMakeFiles/bench_outputSink.dir/bench_outputSink.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_outputSink.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
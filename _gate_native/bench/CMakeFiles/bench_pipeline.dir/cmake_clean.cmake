@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench_pipeline"
+  "../bin/bench_pipeline.pdb"
+  "CMakeFiles/bench_pipeline.dir/bench_pipeline.cpp.o"
+  "CMakeFiles/bench_pipeline.dir/bench_pipeline.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_pipeline.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/plotting.dir/plotRenderer.cpp.o"
+  "CMakeFiles/plotting.dir/plotRenderer.cpp.o.d"
+  "CMakeFiles/plotting.dir/pointOneNavPlot.cpp.o"
+  "CMakeFiles/plotting.dir/pointOneNavPlot.cpp.o.d"
+  "libplotting.a"
+  "libplotting.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/plotting.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,35 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pointonenav_objects.dir/asyncOutputSink.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/asyncOutputSink.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/bufferedWriter.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/bufferedWriter.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/downsample.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/downsample.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/filterStats.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/filterStats.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/inputCache.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/inputCache.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/latencyHistogram.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/latencyHistogram.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/measurementSource.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/measurementSource.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/outputPyramid.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/outputPyramid.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/perfCounters.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/perfCounters.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/plotWorkers.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/plotWorkers.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/pointOneNav.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/pointOneNav.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/stageProfiler.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/stageProfiler.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/textParser.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/textParser.cpp.o.d"
+  "CMakeFiles/pointonenav_objects.dir/traceEvents.cpp.o"
+  "CMakeFiles/pointonenav_objects.dir/traceEvents.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pointonenav_objects.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_bufferedWriter"
+  "../bin/test_bufferedWriter.pdb"
+  "CMakeFiles/test_bufferedWriter.dir/test_bufferedWriter.cpp.o"
+  "CMakeFiles/test_bufferedWriter.dir/test_bufferedWriter.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_bufferedWriter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
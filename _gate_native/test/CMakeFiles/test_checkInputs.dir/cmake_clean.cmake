@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_checkInputs"
+  "../bin/test_checkInputs.pdb"
+  "CMakeFiles/test_checkInputs.dir/test_checkInputs.cpp.o"
+  "CMakeFiles/test_checkInputs.dir/test_checkInputs.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_checkInputs.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_clockSimulator"
+  "../bin/test_clockSimulator.pdb"
+  "CMakeFiles/test_clockSimulator.dir/test_clockSimulator.cpp.o"
+  "CMakeFiles/test_clockSimulator.dir/test_clockSimulator.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_clockSimulator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_getVectorValues"
+  "../bin/test_getVectorValues.pdb"
+  "CMakeFiles/test_getVectorValues.dir/test_getVectorValues.cpp.o"
+  "CMakeFiles/test_getVectorValues.dir/test_getVectorValues.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_getVectorValues.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_goldenHarness"
+  "../bin/test_goldenHarness.pdb"
+  "CMakeFiles/test_goldenHarness.dir/test_goldenHarness.cpp.o"
+  "CMakeFiles/test_goldenHarness.dir/test_goldenHarness.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_goldenHarness.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
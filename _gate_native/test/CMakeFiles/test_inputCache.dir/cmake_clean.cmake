@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_inputCache"
+  "../bin/test_inputCache.pdb"
+  "CMakeFiles/test_inputCache.dir/test_inputCache.cpp.o"
+  "CMakeFiles/test_inputCache.dir/test_inputCache.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_inputCache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
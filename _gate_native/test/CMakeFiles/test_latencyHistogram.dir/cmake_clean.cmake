@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_latencyHistogram"
+  "../bin/test_latencyHistogram.pdb"
+  "CMakeFiles/test_latencyHistogram.dir/test_latencyHistogram.cpp.o"
+  "CMakeFiles/test_latencyHistogram.dir/test_latencyHistogram.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_latencyHistogram.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
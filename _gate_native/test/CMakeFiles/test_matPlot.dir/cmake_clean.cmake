@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_matPlot"
+  "../bin/test_matPlot.pdb"
+  "CMakeFiles/test_matPlot.dir/test_matPlot.cpp.o"
+  "CMakeFiles/test_matPlot.dir/test_matPlot.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_matPlot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
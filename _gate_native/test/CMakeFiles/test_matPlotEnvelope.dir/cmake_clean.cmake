@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_matPlotEnvelope"
+  "../bin/test_matPlotEnvelope.pdb"
+  "CMakeFiles/test_matPlotEnvelope.dir/test_matPlotEnvelope.cpp.o"
+  "CMakeFiles/test_matPlotEnvelope.dir/test_matPlotEnvelope.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_matPlotEnvelope.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
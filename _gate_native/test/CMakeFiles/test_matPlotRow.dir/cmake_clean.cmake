@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_matPlotRow"
+  "../bin/test_matPlotRow.pdb"
+  "CMakeFiles/test_matPlotRow.dir/test_matPlotRow.cpp.o"
+  "CMakeFiles/test_matPlotRow.dir/test_matPlotRow.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_matPlotRow.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
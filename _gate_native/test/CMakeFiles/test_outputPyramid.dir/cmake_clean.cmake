@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_outputPyramid"
+  "../bin/test_outputPyramid.pdb"
+  "CMakeFiles/test_outputPyramid.dir/test_outputPyramid.cpp.o"
+  "CMakeFiles/test_outputPyramid.dir/test_outputPyramid.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_outputPyramid.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
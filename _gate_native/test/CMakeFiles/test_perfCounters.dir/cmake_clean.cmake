@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_perfCounters"
+  "../bin/test_perfCounters.pdb"
+  "CMakeFiles/test_perfCounters.dir/test_perfCounters.cpp.o"
+  "CMakeFiles/test_perfCounters.dir/test_perfCounters.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perfCounters.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
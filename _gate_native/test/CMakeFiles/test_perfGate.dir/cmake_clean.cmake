@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_perfGate"
+  "../bin/test_perfGate.pdb"
+  "CMakeFiles/test_perfGate.dir/test_perfGate.cpp.o"
+  "CMakeFiles/test_perfGate.dir/test_perfGate.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perfGate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
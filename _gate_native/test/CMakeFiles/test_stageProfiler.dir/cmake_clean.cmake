@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_stageProfiler"
+  "../bin/test_stageProfiler.pdb"
+  "CMakeFiles/test_stageProfiler.dir/test_stageProfiler.cpp.o"
+  "CMakeFiles/test_stageProfiler.dir/test_stageProfiler.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stageProfiler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
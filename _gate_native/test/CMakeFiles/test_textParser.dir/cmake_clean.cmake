@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_textParser"
+  "../bin/test_textParser.pdb"
+  "CMakeFiles/test_textParser.dir/test_textParser.cpp.o"
+  "CMakeFiles/test_textParser.dir/test_textParser.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_textParser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
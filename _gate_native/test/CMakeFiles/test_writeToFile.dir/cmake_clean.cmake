@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_writeToFile"
+  "../bin/test_writeToFile.pdb"
+  "CMakeFiles/test_writeToFile.dir/test_writeToFile.cpp.o"
+  "CMakeFiles/test_writeToFile.dir/test_writeToFile.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_writeToFile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/goldenCompare"
+  "../bin/goldenCompare.pdb"
+  "CMakeFiles/goldenCompare.dir/goldenCompare.cpp.o"
+  "CMakeFiles/goldenCompare.dir/goldenCompare.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/goldenCompare.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
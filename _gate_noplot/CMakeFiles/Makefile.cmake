@@ -0,0 +1,114 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/GTest/GTestConfig.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestConfigVersion.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets-release.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/bench/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGTest.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GoogleTest.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/eigen3/cmake/Eigen3Config.cmake"
+  "/usr/share/eigen3/cmake/Eigen3ConfigVersion.cmake"
+  "/usr/share/eigen3/cmake/Eigen3Targets.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "bench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/pgo.dir/DependInfo.cmake"
+  "src/CMakeFiles/pointonenav_objects.dir/DependInfo.cmake"
+  "src/CMakeFiles/pointonenav.dir/DependInfo.cmake"
+  "src/CMakeFiles/pointonenav_shared.dir/DependInfo.cmake"
+  "src/CMakeFiles/pointonenav_testing.dir/DependInfo.cmake"
+  "src/CMakeFiles/ekf.dir/DependInfo.cmake"
+  "tools/CMakeFiles/replay.dir/DependInfo.cmake"
+  "tools/CMakeFiles/pyramidQuery.dir/DependInfo.cmake"
+  "tools/CMakeFiles/generateDataset.dir/DependInfo.cmake"
+  "tools/CMakeFiles/goldenCompare.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_getInputData.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_getInputDataVec.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_simpleEKF.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_readFromFile.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_writeToFile.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_getVectorValues.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_checkInputs.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_bufferedWriter.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_asyncOutputSink.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_measurementSource.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_inputCache.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_textParser.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_nativePlot.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_downsample.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_plotWorkers.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_outputPyramid.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_filterStats.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_clockSimulator.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_stageProfiler.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_latencyHistogram.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_traceEvents.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_perfCounters.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_goldenHarness.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_perfGate.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_simpleEKF.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_fileIO.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_pipeline.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_outputSink.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench.dir/DependInfo.cmake"
+  )
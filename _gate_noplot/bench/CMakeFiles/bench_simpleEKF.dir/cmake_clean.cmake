@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench_simpleEKF"
+  "../bin/bench_simpleEKF.pdb"
+  "CMakeFiles/bench_simpleEKF.dir/bench_simpleEKF.cpp.o"
+  "CMakeFiles/bench_simpleEKF.dir/bench_simpleEKF.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_simpleEKF.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
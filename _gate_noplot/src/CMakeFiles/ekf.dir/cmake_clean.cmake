@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/ekf"
+  "../bin/ekf.pdb"
+  "CMakeFiles/ekf.dir/main.cpp.o"
+  "CMakeFiles/ekf.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ekf.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libpointonenav.a"
+  "libpointonenav.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pointonenav.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
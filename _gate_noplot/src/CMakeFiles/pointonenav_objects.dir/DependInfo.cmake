@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/asyncOutputSink.cpp" "src/CMakeFiles/pointonenav_objects.dir/asyncOutputSink.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/asyncOutputSink.cpp.o.d"
+  "/root/repo/src/bufferedWriter.cpp" "src/CMakeFiles/pointonenav_objects.dir/bufferedWriter.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/bufferedWriter.cpp.o.d"
+  "/root/repo/src/downsample.cpp" "src/CMakeFiles/pointonenav_objects.dir/downsample.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/downsample.cpp.o.d"
+  "/root/repo/src/filterStats.cpp" "src/CMakeFiles/pointonenav_objects.dir/filterStats.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/filterStats.cpp.o.d"
+  "/root/repo/src/inputCache.cpp" "src/CMakeFiles/pointonenav_objects.dir/inputCache.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/inputCache.cpp.o.d"
+  "/root/repo/src/latencyHistogram.cpp" "src/CMakeFiles/pointonenav_objects.dir/latencyHistogram.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/latencyHistogram.cpp.o.d"
+  "/root/repo/src/measurementSource.cpp" "src/CMakeFiles/pointonenav_objects.dir/measurementSource.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/measurementSource.cpp.o.d"
+  "/root/repo/src/outputPyramid.cpp" "src/CMakeFiles/pointonenav_objects.dir/outputPyramid.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/outputPyramid.cpp.o.d"
+  "/root/repo/src/perfCounters.cpp" "src/CMakeFiles/pointonenav_objects.dir/perfCounters.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/perfCounters.cpp.o.d"
+  "/root/repo/src/plotWorkers.cpp" "src/CMakeFiles/pointonenav_objects.dir/plotWorkers.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/plotWorkers.cpp.o.d"
+  "/root/repo/src/pointOneNav.cpp" "src/CMakeFiles/pointonenav_objects.dir/pointOneNav.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/pointOneNav.cpp.o.d"
+  "/root/repo/src/pointOneNavPlot.cpp" "src/CMakeFiles/pointonenav_objects.dir/pointOneNavPlot.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/pointOneNavPlot.cpp.o.d"
+  "/root/repo/src/stageProfiler.cpp" "src/CMakeFiles/pointonenav_objects.dir/stageProfiler.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/stageProfiler.cpp.o.d"
+  "/root/repo/src/textParser.cpp" "src/CMakeFiles/pointonenav_objects.dir/textParser.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/textParser.cpp.o.d"
+  "/root/repo/src/traceEvents.cpp" "src/CMakeFiles/pointonenav_objects.dir/traceEvents.cpp.o" "gcc" "src/CMakeFiles/pointonenav_objects.dir/traceEvents.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libpointonenav.pdb"
+  "libpointonenav.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pointonenav_shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/clockSimulator.cpp" "src/CMakeFiles/pointonenav_testing.dir/clockSimulator.cpp.o" "gcc" "src/CMakeFiles/pointonenav_testing.dir/clockSimulator.cpp.o.d"
+  "/root/repo/src/goldenHarness.cpp" "src/CMakeFiles/pointonenav_testing.dir/goldenHarness.cpp.o" "gcc" "src/CMakeFiles/pointonenav_testing.dir/goldenHarness.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_noplot/src/CMakeFiles/pointonenav.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
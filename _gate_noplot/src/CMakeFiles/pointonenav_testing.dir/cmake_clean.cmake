@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pointonenav_testing.dir/clockSimulator.cpp.o"
+  "CMakeFiles/pointonenav_testing.dir/clockSimulator.cpp.o.d"
+  "CMakeFiles/pointonenav_testing.dir/goldenHarness.cpp.o"
+  "CMakeFiles/pointonenav_testing.dir/goldenHarness.cpp.o.d"
+  "libpointonenav_testing.a"
+  "libpointonenav_testing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pointonenav_testing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
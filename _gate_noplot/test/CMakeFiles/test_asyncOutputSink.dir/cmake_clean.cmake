@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_asyncOutputSink"
+  "../bin/test_asyncOutputSink.pdb"
+  "CMakeFiles/test_asyncOutputSink.dir/test_asyncOutputSink.cpp.o"
+  "CMakeFiles/test_asyncOutputSink.dir/test_asyncOutputSink.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_asyncOutputSink.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_downsample"
+  "../bin/test_downsample.pdb"
+  "CMakeFiles/test_downsample.dir/test_downsample.cpp.o"
+  "CMakeFiles/test_downsample.dir/test_downsample.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_downsample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
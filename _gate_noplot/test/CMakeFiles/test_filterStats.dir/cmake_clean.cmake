@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_filterStats"
+  "../bin/test_filterStats.pdb"
+  "CMakeFiles/test_filterStats.dir/test_filterStats.cpp.o"
+  "CMakeFiles/test_filterStats.dir/test_filterStats.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_filterStats.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
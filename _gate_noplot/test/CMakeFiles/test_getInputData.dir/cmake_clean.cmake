@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_getInputData"
+  "../bin/test_getInputData.pdb"
+  "CMakeFiles/test_getInputData.dir/test_getInputData.cpp.o"
+  "CMakeFiles/test_getInputData.dir/test_getInputData.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_getInputData.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
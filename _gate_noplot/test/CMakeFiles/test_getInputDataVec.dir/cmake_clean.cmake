@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_getInputDataVec"
+  "../bin/test_getInputDataVec.pdb"
+  "CMakeFiles/test_getInputDataVec.dir/test_getInputDataVec.cpp.o"
+  "CMakeFiles/test_getInputDataVec.dir/test_getInputDataVec.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_getInputDataVec.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_measurementSource"
+  "../bin/test_measurementSource.pdb"
+  "CMakeFiles/test_measurementSource.dir/test_measurementSource.cpp.o"
+  "CMakeFiles/test_measurementSource.dir/test_measurementSource.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_measurementSource.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_nativePlot"
+  "../bin/test_nativePlot.pdb"
+  "CMakeFiles/test_nativePlot.dir/test_nativePlot.cpp.o"
+  "CMakeFiles/test_nativePlot.dir/test_nativePlot.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_nativePlot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
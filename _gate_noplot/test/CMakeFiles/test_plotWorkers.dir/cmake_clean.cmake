@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_plotWorkers"
+  "../bin/test_plotWorkers.pdb"
+  "CMakeFiles/test_plotWorkers.dir/test_plotWorkers.cpp.o"
+  "CMakeFiles/test_plotWorkers.dir/test_plotWorkers.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_plotWorkers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
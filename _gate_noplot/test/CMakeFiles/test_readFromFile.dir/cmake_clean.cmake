@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_readFromFile"
+  "../bin/test_readFromFile.pdb"
+  "CMakeFiles/test_readFromFile.dir/test_readFromFile.cpp.o"
+  "CMakeFiles/test_readFromFile.dir/test_readFromFile.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_readFromFile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_simpleEKF"
+  "../bin/test_simpleEKF.pdb"
+  "CMakeFiles/test_simpleEKF.dir/test_simpleEKF.cpp.o"
+  "CMakeFiles/test_simpleEKF.dir/test_simpleEKF.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_simpleEKF.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_traceEvents"
+  "../bin/test_traceEvents.pdb"
+  "CMakeFiles/test_traceEvents.dir/test_traceEvents.cpp.o"
+  "CMakeFiles/test_traceEvents.dir/test_traceEvents.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_traceEvents.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_gate_noplot/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(perf_gate "/root/repo/_gate_noplot/bin/test_perfGate" "--baseline" "/root/repo/test/perf_baseline.txt")
+set_tests_properties(perf_gate PROPERTIES  LABELS "perf" RUN_SERIAL "TRUE" TIMEOUT "300" WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;78;add_test;/root/repo/test/CMakeLists.txt;0;")
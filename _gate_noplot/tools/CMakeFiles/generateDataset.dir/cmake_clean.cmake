@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/generateDataset"
+  "../bin/generateDataset.pdb"
+  "CMakeFiles/generateDataset.dir/generateDataset.cpp.o"
+  "CMakeFiles/generateDataset.dir/generateDataset.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/generateDataset.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/pyramidQuery"
+  "../bin/pyramidQuery.pdb"
+  "CMakeFiles/pyramidQuery.dir/pyramidQuery.cpp.o"
+  "CMakeFiles/pyramidQuery.dir/pyramidQuery.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pyramidQuery.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,118 @@
+#ifndef BENCH_HISTORY_H
+#define BENCH_HISTORY_H
+
+/// Std includes
+#include <string>
+#include <cstdint>
+#include <cstdio>
+
+/// Google Benchmark
+#include <benchmark/benchmark.h>
+
+/// Main header include
+#include "../src/pointOneNav.h"
+
+/**
+ * @file benchHistory.h
+ * @brief synthetic filter inputs of any length shared by the benchmarks, and the history lengths they are run for
+ */
+
+/// Longest history benchmarked, 10^6 unless configured otherwise (cmake -DBENCH_MAX_EPOCHS=100000000)
+#ifndef BENCH_MAX_EPOCHS
+#define BENCH_MAX_EPOCHS 1000000
+#endif
+
+/// Synthetic inputs are written next to the filter outputs; getInputData reads relative to ../filter_input/
+static const std::string bench_history_file = "bench_measurement_history.txt";
+static const std::string bench_history_input = "../filter_output/bench_measurement_history.txt";
+
+/**
+ * @brief benchHistoryLengths history lengths from 10^3 up to BENCH_MAX_EPOCHS (or max_epochs if lower), one decade apart
+ */
+static void benchHistoryLengths(benchmark::internal::Benchmark* b, const std::int64_t max_epochs)
+{
+	b->RangeMultiplier(10)->Range(1000, std::min<std::int64_t>(max_epochs, BENCH_MAX_EPOCHS))->Unit(benchmark::kMillisecond);
+}
+
+static void benchHistoryLengths(benchmark::internal::Benchmark* b)
+{
+	benchHistoryLengths(b, BENCH_MAX_EPOCHS);
+}
+
+/**
+ * @brief benchMeasurements measurements of a drifting clock, shaped like filter_input/measurement_history.txt
+ * @param epochs number of columns
+ * @return 2 x epochs matrix, clock bias and clock rate
+ */
+static mat benchMeasurements(const std::int64_t epochs)
+{
+	mat history(2, epochs);
+	double bias = -32168.8;
+	std::uint64_t state = 0x9E3779B97F4A7C15ull;
+	auto noise = [&state]()
+	{
+		/// xorshift, uniform in [-0.5, 0.5)
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5;
+	};
+	for (std::int64_t k=0; k<epochs; ++k)
+	{
+		bias += 26.08 + 0.4 * noise();
+		history(0, k) = bias + 14.0 * noise();
+		history(1, k) = 26.08 + 0.8 * noise();
+	}
+	return history;
+}
+
+/**
+ * @brief benchInputs the filter inputs of filter_input/ with a synthetic measurement history of the given length
+ */
+static filter_input benchInputs(const std::int64_t epochs)
+{
+	filter_input f_in;
+	f_in.initial_state_estimate = mat(2, 1);
+	f_in.initial_state_estimate << -32186.470260709215, 26.078408449552480;
+	f_in.initial_state_estimate_covariance = mat(2, 2);
+	f_in.initial_state_estimate_covariance << 49.0, 0.0, 0.0, 0.04;
+	f_in.measurement_noise_covariance = mat(2, 2);
+	f_in.measurement_noise_covariance << 49.0, 0.0, 0.0, 0.04;
+	f_in.process_noise_covariance = mat(2, 2);
+	f_in.process_noise_covariance << 2.0814695877451838e-02, 1.7740716135125494e-02, 1.7740716135125494e-02, 3.5481432270250989e-02;
+	f_in.measurement_history = benchMeasurements(epochs);
+	return f_in;
+}
+
+/**
+ * @brief benchWriteHistoryFile write a synthetic measurement history of the given length in the filter input format
+ * @return size of the file in bytes, 0 if it could not be written
+ */
+static std::int64_t benchWriteHistoryFile(const std::int64_t epochs)
+{
+	twoStateClockModel model(false, 1);
+	if (!model.writeToFile(bench_history_file, benchMeasurements(epochs)))
+	{
+		return 0;
+	}
+	std::FILE* file = std::fopen(bench_history_input.c_str(), "rb");
+	if (file == NULL)
+	{
+		return 0;
+	}
+	std::fseek(file, 0, SEEK_END);
+	std::int64_t size = std::ftell(file);
+	std::fclose(file);
+	return size;
+}
+
+/**
+ * @brief benchRemoveHistoryFile remove the synthetic history and its cache sidecar
+ */
+static void benchRemoveHistoryFile()
+{
+	std::remove(bench_history_input.c_str());
+	std::remove((bench_history_input + ".p1cache").c_str());
+}
+
+#endif // BENCH_HISTORY_H
@@ -0,0 +1,198 @@
+/**
+ * @file bench_fileIO.cpp
+ * @brief throughput of the filter input parsing and of the filter output writing, for histories of 10^3 epochs and up
+ * @function twoStateClockModel::readFromFile, twoStateClockModel::getInputData, twoStateClockModel::writeToFile,
+ *           outputPyramid::write, outputPyramid::read
+ * @note getInputData is measured parsing the text file, with 1 to as many threads as cores, and loading its cache sidecar;
+ *       bytes/s are of the text file. BM_writeToFile_ofstream is the std::ofstream writer writeToFile replaced, the baseline of
+ *       BM_writeToFile
+ */
+
+#include <thread>
+#include <fstream>
+#include <iomanip>
+
+#include "benchHistory.h"
+#include "../src/outputPyramid.h"
+
+namespace
+{
+	void BM_readFromFile(benchmark::State& state)
+	{
+		const std::int64_t bytes = benchWriteHistoryFile(state.range(0));
+		if (bytes == 0)
+		{
+			state.SkipWithError("could not write the measurement history");
+			return;
+		}
+		twoStateClockModel model(false, 1);
+		for (auto _ : state)
+		{
+			std::vector<std::vector<double> > values;
+			model.readFromFile(bench_history_input, values);
+			benchmark::DoNotOptimize(values.data());
+		}
+		state.SetBytesProcessed(state.iterations() * bytes);
+		benchRemoveHistoryFile();
+	}
+	BENCHMARK(BM_readFromFile)->Apply(benchHistoryLengths);
+
+	void BM_getInputData(benchmark::State& state)
+	{
+		const std::int64_t bytes = benchWriteHistoryFile(state.range(0));
+		if (bytes == 0)
+		{
+			state.SkipWithError("could not write the measurement history");
+			return;
+		}
+		twoStateClockModel model(false, 1);
+		model.setInputCache(false);
+		for (auto _ : state)
+		{
+			mat history;
+			model.getInputData(bench_history_input, history);
+			benchmark::DoNotOptimize(history.data());
+		}
+		state.SetBytesProcessed(state.iterations() * bytes);
+		benchRemoveHistoryFile();
+	}
+	BENCHMARK(BM_getInputData)->Apply(benchHistoryLengths);
+
+	/// Parse of a 10^6 epoch history for an increasing number of threads, bounded by the cores and the memory bandwidth
+	void BM_getInputData_threads(benchmark::State& state)
+	{
+		const std::int64_t bytes = benchWriteHistoryFile(std::min(1000000, BENCH_MAX_EPOCHS));
+		if (bytes == 0)
+		{
+			state.SkipWithError("could not write the measurement history");
+			return;
+		}
+		twoStateClockModel model(false, 1);
+		model.setInputCache(false);
+		model.setParseThreads(state.range(0));
+		for (auto _ : state)
+		{
+			mat history;
+			model.getInputData(bench_history_input, history);
+			benchmark::DoNotOptimize(history.data());
+		}
+		state.SetBytesProcessed(state.iterations() * bytes);
+		benchRemoveHistoryFile();
+	}
+	BENCHMARK(BM_getInputData_threads)->ArgName("threads")->RangeMultiplier(2)
+		->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	/// Every iteration after the first loads the sidecar written by the first
+	void BM_getInputData_cached(benchmark::State& state)
+	{
+		const std::int64_t bytes = benchWriteHistoryFile(state.range(0));
+		if (bytes == 0)
+		{
+			state.SkipWithError("could not write the measurement history");
+			return;
+		}
+		twoStateClockModel model(false, 1);
+		model.setInputCache(true);
+		mat history;
+		model.getInputData(bench_history_input, history);
+		for (auto _ : state)
+		{
+			model.getInputData(bench_history_input, history);
+			benchmark::DoNotOptimize(history.data());
+		}
+		state.SetBytesProcessed(state.iterations() * bytes);
+		benchRemoveHistoryFile();
+	}
+	BENCHMARK(BM_getInputData_cached)->Apply(benchHistoryLengths);
+
+	const std::string bench_output = "../filter_output/bench_filter_output.txt";
+
+	/// Size of a written file in bytes, 0 if it cannot be opened
+	std::int64_t benchFileSize(const std::string& file_name)
+	{
+		std::int64_t bytes = 0;
+		std::FILE* file = std::fopen(file_name.c_str(), "rb");
+		if (file != NULL)
+		{
+			std::fseek(file, 0, SEEK_END);
+			bytes = std::ftell(file);
+			std::fclose(file);
+		}
+		return bytes;
+	}
+
+	/// filter_output.txt of the given length, bytes/s of the text written
+	void BM_writeToFile(benchmark::State& state)
+	{
+		twoStateClockModel model(false, 1);
+		mat xhat_hist = benchMeasurements(state.range(0) + 1);
+		for (auto _ : state)
+		{
+			model.writeToFile("bench_filter_output.txt", xhat_hist);
+		}
+		state.SetBytesProcessed(state.iterations() * benchFileSize(bench_output));
+		std::remove(bench_output.c_str());
+	}
+	BENCHMARK(BM_writeToFile)->Apply(benchHistoryLengths);
+
+	/// The same file streamed through std::ofstream, as writeToFile did before bufferedWriter; the values are padded to a
+	/// fixed width, so the file is somewhat larger
+	void BM_writeToFile_ofstream(benchmark::State& state)
+	{
+		mat xhat_hist = benchMeasurements(state.range(0) + 1);
+		for (auto _ : state)
+		{
+			std::ofstream file(bench_output);
+			file << std::setprecision(16) << std::scientific << xhat_hist;
+			file.close();
+		}
+		state.SetBytesProcessed(state.iterations() * benchFileSize(bench_output));
+		std::remove(bench_output.c_str());
+	}
+	BENCHMARK(BM_writeToFile_ofstream)->Apply(benchHistoryLengths);
+
+	const std::string bench_pyramid = "../filter_output/bench_filter_output.p1pyr";
+
+	/// filter_output.p1pyr of the given length with the NIS channel, as ekf writes it; O(N), bytes/s of the file written
+	void BM_outputPyramid_write(benchmark::State& state)
+	{
+		mat xhat_hist = benchMeasurements(state.range(0));
+		mat nis_hist = xhat_hist.row(1).cwiseAbs();
+		for (auto _ : state)
+		{
+			outputPyramid::write(bench_pyramid, {&xhat_hist, &nis_hist}, 0.0, 1.0);
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * 3 * sizeof(double));
+		std::remove(bench_pyramid.c_str());
+	}
+	BENCHMARK(BM_outputPyramid_write)->Apply(benchHistoryLengths);
+
+	/// One window of 10^5 epochs (half the run when shorter) read at the level picked for 2000 points, the same time whatever
+	/// the length of the run
+	void BM_outputPyramid_query(benchmark::State& state)
+	{
+		const std::int64_t epochs = state.range(0);
+		mat xhat_hist = benchMeasurements(epochs);
+		mat nis_hist = xhat_hist.row(1).cwiseAbs();
+		outputPyramid pyramid;
+		if (!outputPyramid::write(bench_pyramid, {&xhat_hist, &nis_hist}, 0.0, 1.0) or !pyramid.open(bench_pyramid))
+		{
+			state.SkipWithError("could not write the output pyramid");
+			return;
+		}
+		const double span = std::min<double>(100000.0, epochs / 2);
+		pyramid_window window;
+		std::int64_t q = 0;
+		for (auto _ : state)
+		{
+			double t_begin = std::fmod(q++ * 7919.0 * 1237.0, epochs - span);
+			pyramid.read(t_begin, t_begin + span, pyramid.levelFor(t_begin, t_begin + span, 2000), window);
+			benchmark::DoNotOptimize(window.values.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+		std::remove(bench_pyramid.c_str());
+	}
+	BENCHMARK(BM_outputPyramid_query)->Apply(benchHistoryLengths)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,139 @@
+/**
+ * @file bench_matPlot.cpp
+ * @brief cost of handing a history row to the plotting library and drawing it headless, for histories of 10^3 epochs and up
+ * @function twoStateClockModel::matPlot(row_view, double, double, std::string, std::string, std::string, float),
+ *           twoStateClockModel::matPlot(row_view, row_view, double, double, double, std::string, std::string, std::string),
+ *           plotRenderer::draw(plot_figure, std::string, bool), downsample::select
+ * @note decimated rows are reduced to the 4000 points ekf plots, so past that length the time is the decimation pass plus a
+ *       fixed drawing cost; undecimated rows hand every sample over and are only run up to 10^5 epochs
+ */
+
+#include <fstream>
+#include <numeric>
+#include <random>
+
+#include "benchHistory.h"
+#include "../src/downsample.h"
+#include "../src/plotRenderer.h"
+
+namespace
+{
+	const std::string caption = "bench_matPlot";
+
+	void removePlots()
+	{
+		std::remove(("../filter_output/" + caption + ".png").c_str());
+		std::remove(("../filter_output/" + caption + ".svg").c_str());
+	}
+
+	void BM_matPlot(benchmark::State& state)
+	{
+		twoStateClockModel model(false, 1);
+		model.setHeadless(true);
+		model.setPlotDecimation(state.range(1) ? decimation_method::lttb : decimation_method::none, 4000);
+		mat xhat_hist = benchMeasurements(state.range(0));
+		for (auto _ : state)
+		{
+			model.matPlot(xhat_hist.row(0), 0.0, 1.0, caption, "Receiver time, s", "Clock bias estimate, m", 0.0);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		removePlots();
+	}
+	BENCHMARK(BM_matPlot)->ArgNames({"epochs", "decimated"})->ArgsProduct({benchmark::CreateRange(1000, BENCH_MAX_EPOCHS, 10), {1}})
+		->Unit(benchmark::kMillisecond);
+	BENCHMARK(BM_matPlot)->ArgNames({"epochs", "decimated"})->ArgsProduct({benchmark::CreateRange(1000, std::min(100000, BENCH_MAX_EPOCHS), 10), {0}})
+		->Unit(benchmark::kMillisecond);
+
+	/// The bias row with its +-2 sigma envelope, the variances read in place from the 2x2 covariance history; decimated like
+	/// BM_matPlot/decimated:1, so the envelope should stay under twice the time of the line alone at every length
+	void BM_matPlot_envelope(benchmark::State& state)
+	{
+		twoStateClockModel model(false, 1);
+		model.setHeadless(true);
+		model.setPlotDecimation(decimation_method::lttb, 4000);
+		mat xhat_hist = benchMeasurements(state.range(0));
+		std::vector<Eigen::Matrix<double,2,2> > xcov_hist(state.range(0), Eigen::Matrix<double,2,2>::Identity());
+		Eigen::Map<const Eigen::RowVectorXd, 0, Eigen::InnerStride<4> > bias_variance(xcov_hist.front().data(), state.range(0));
+		for (auto _ : state)
+		{
+			model.matPlot(xhat_hist.row(0), bias_variance, 2.0, 0.0, 1.0, caption, "Receiver time, s", "Clock bias estimate, m");
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		removePlots();
+	}
+	BENCHMARK(BM_matPlot_envelope)->Apply(benchHistoryLengths);
+
+	/// Decimation of an NIS-like series to the 4000 points ekf plots, lttb=1 or min_max=0; O(N), the time per sample stays
+	/// flat with the length
+	void BM_downsample_select(benchmark::State& state)
+	{
+		std::mt19937_64 rng(7);
+		std::exponential_distribution<double> dist(0.5);
+		std::vector<double> t(state.range(0)), nis(state.range(0));
+		for (std::size_t i=0; i<t.size(); ++i)
+		{
+			t[i] = static_cast<double>(i);
+			nis[i] = dist(rng);
+		}
+		const decimation_method method = state.range(1) ? decimation_method::lttb : decimation_method::min_max;
+		std::vector<std::size_t> kept;
+		for (auto _ : state)
+		{
+			downsample::select(method, t, nis, 4000, kept, 5.9915);
+			benchmark::DoNotOptimize(kept.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_downsample_select)->ArgNames({"epochs", "lttb"})->ArgsProduct({benchmark::CreateRange(10000, std::max(10000, BENCH_MAX_EPOCHS), 10), {0, 1}})
+		->Unit(benchmark::kMillisecond);
+
+	/// Resident set size of the process in kB
+	long residentKB()
+	{
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line))
+		{
+			if (line.compare(0, 6, "VmRSS:") == 0)
+			{
+				return std::atol(line.c_str() + 6);
+			}
+		}
+		return 0;
+	}
+
+	/// Undecimated history handed to the renderer: in_place=1 as the strided row of the matrix, in_place=0 through the text
+	/// file and std::vector round trip main.cpp used to do; resident_MB is the memory the handoff added
+	void BM_plot_handoff(benchmark::State& state)
+	{
+		twoStateClockModel model(false, 1);
+		mat xhat_hist = benchMeasurements(state.range(0));
+		long rss_before = residentKB();
+		for (auto _ : state)
+		{
+			plot_figure figure;
+			std::vector<std::vector<double> > values;
+			std::vector<double> y;
+			if (state.range(1))
+			{
+				figure.lines.push_back({NULL, 0.0, 1.0, xhat_hist.data(), xhat_hist.rows(), static_cast<std::size_t>(xhat_hist.cols()), ""});
+			}
+			else
+			{
+				model.getVectorValues(xhat_hist, caption + ".txt", values);
+				y.resize(values[0].size());
+				std::iota(y.begin(), y.end(), 0);
+				figure.lines.push_back({y.data(), 0.0, 0.0, values[0].data(), 1, y.size(), ""});
+			}
+			plotRenderer::draw(figure, "../filter_output/" + caption, true);
+		}
+		state.counters["resident_MB"] = (residentKB() - rss_before) / 1024.0;
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		std::remove(("../filter_output/" + caption + ".txt").c_str());
+		removePlots();
+	}
+	BENCHMARK(BM_plot_handoff)->ArgNames({"epochs", "in_place"})->ArgsProduct({{std::min(1000000, BENCH_MAX_EPOCHS)}, {0, 1}})
+		->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_MAIN();
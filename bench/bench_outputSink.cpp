@@ -0,0 +1,67 @@
+/**
+ * @file bench_outputSink.cpp
+ * @brief filter step of main.cpp with the per-epoch results handed to the asynchronous output sink, against slow storage
+ * @function asyncOutputSink::push(epoch_result)
+ * @note sink=0 runs the filter loop alone, sink=1 pushes every epoch to a sink whose destination takes 50 us per 4 kB chunk;
+ *       the two times per epoch should stay close, the filter does not wait for the storage. The iterations are fixed, the
+ *       backlog left in the ring is written when the sink is destroyed
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "benchHistory.h"
+#include "../src/asyncOutputSink.h"
+
+namespace
+{
+	void BM_filter_outputSink(benchmark::State& state)
+	{
+		const filter_input f_in = benchInputs(state.range(0));
+		const bool with_sink = state.range(1) != 0;
+		twoStateClockModel model(false, 1);
+		mat w_k = mat::Zero(2,1);
+		mat v_kp1 = mat::Zero(2,1);
+
+		/// Slow storage: every chunk of formatted output takes 50 us to be taken, the ring grows meanwhile
+		bufferedWriter::destination slow = [](const char*, std::size_t)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+			return true;
+		};
+		asyncOutputSink sink(slow, sink_format::text, backpressure_policy::grow, 4096, 4096);
+
+		std::uint64_t epoch = 0;
+		for (auto _ : state)
+		{
+			mat xk_est = f_in.initial_state_estimate;
+			mat xcovk_est = f_in.initial_state_estimate_covariance;
+			for (int kp1=0; kp1<f_in.measurement_history.cols(); ++kp1)
+			{
+				model.simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, f_in.measurement_history.col(kp1), v_kp1,
+					f_in.measurement_noise_covariance);
+				xk_est = model.get_xkp1();
+				xcovk_est = model.get_xcov_kp1();
+				if (with_sink)
+				{
+					epoch_result result;
+					result.epoch = epoch++;
+					result.state[0] = xk_est(0);
+					result.state[1] = xk_est(1);
+					for (int i=0; i<4; ++i)
+					{
+						result.covariance[i] = xcovk_est(i);
+					}
+					result.nis = 0.0;
+					sink.push(result);
+				}
+			}
+			benchmark::DoNotOptimize(xk_est.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.counters["queued"] = static_cast<double>(epoch - sink.written());
+	}
+	BENCHMARK(BM_filter_outputSink)->ArgNames({"epochs", "sink"})->ArgsProduct({{10000}, {0, 1}})->Iterations(20)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_MAIN();
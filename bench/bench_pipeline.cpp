@@ -0,0 +1,84 @@
+/**
+ * @file bench_pipeline.cpp
+ * @brief end-to-end batch run of main.cpp without the plots: parse the inputs, run the filter, write filter_output.txt,
+ *        nis_hist.txt and the output pyramid, for measurement histories of 10^3 epochs and up
+ * @note the inputs are parsed from text on every iteration (no cache sidecar) and the outputs are flushed to disk as in ekf
+ */
+
+#include "benchHistory.h"
+#include "../src/filterStats.h"
+
+namespace
+{
+	/// The batch path of main.cpp, with the output files prefixed by bench_
+	bool runPipeline(twoStateClockModel& model)
+	{
+		filter_input f_in;
+		model.getInputData("initial_state_estimate.txt", f_in.initial_state_estimate);
+		model.getInputData("initial_state_estimate_covariance.txt", f_in.initial_state_estimate_covariance);
+		model.getInputData("measurement_noise_covariance.txt", f_in.measurement_noise_covariance);
+		model.getInputData("process_noise_covariance.txt", f_in.process_noise_covariance);
+		model.getInputData(bench_history_input, f_in.measurement_history);
+		if (!model.checkInputs(f_in))
+		{
+			return false;
+		}
+
+		int n = f_in.measurement_history.cols();
+		mat xk_est = f_in.initial_state_estimate;
+		mat xcovk_est = f_in.initial_state_estimate_covariance;
+		mat w_k = mat::Zero(2,1);
+		mat v_kp1 = mat::Zero(2,1);
+		mat xhat_hist = mat::Zero(2,n+1);
+		mat nis_hist = mat::Zero(1, n+1);
+		std::vector<Eigen::Matrix<double,2,2> > xcov_hist(n+1);
+		xhat_hist.col(0) = f_in.initial_state_estimate;
+		xcov_hist[0] = f_in.initial_state_estimate_covariance;
+		filterStats nis_stats(2, 0.1, 100);
+
+		for (auto kp1=0; kp1<n; kp1++)
+		{
+			model.simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, f_in.measurement_history.col(kp1), v_kp1,
+				f_in.measurement_noise_covariance);
+			xhat_hist.col(kp1+1) = model.get_xkp1();
+			xcov_hist.at(kp1+1) = model.get_xcov_kp1();
+			mat temp = (model.get_zkp1().transpose()) * ((model.get_skp1()).inverse() * model.get_zkp1());
+			nis_hist(0, kp1+1) = temp(0);
+			nis_stats.add(temp(0));
+			xk_est = model.get_xkp1();
+			xcovk_est = model.get_xcov_kp1();
+		}
+		benchmark::DoNotOptimize(nis_stats.mean());
+
+		return model.writeToFile("bench_filter_output.txt", xhat_hist) and model.writeToFile("bench_nis_hist.txt", nis_hist) and
+			model.writePyramid("bench_filter_output.p1pyr", {&xhat_hist, &nis_hist}, 0.0, 1.0);
+	}
+
+	void BM_pipeline(benchmark::State& state)
+	{
+		if (benchWriteHistoryFile(state.range(0)) == 0)
+		{
+			state.SkipWithError("could not write the measurement history");
+			return;
+		}
+		twoStateClockModel model(false, 1);
+		model.setInputCache(false);
+		model.setSyncOutputs(true);
+		for (auto _ : state)
+		{
+			if (!runPipeline(model))
+			{
+				state.SkipWithError("the pipeline failed");
+				break;
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		benchRemoveHistoryFile();
+		std::remove("../filter_output/bench_filter_output.txt");
+		std::remove("../filter_output/bench_nis_hist.txt");
+		std::remove("../filter_output/bench_filter_output.p1pyr");
+	}
+	BENCHMARK(BM_pipeline)->Apply(benchHistoryLengths)->UseRealTime();
+}
+
+BENCHMARK_MAIN();
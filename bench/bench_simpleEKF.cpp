@@ -0,0 +1,138 @@
+/**
+ * @file bench_simpleEKF.cpp
+ * @brief microbenchmarks of the filter step: the dynamics and measurement functions, one EKF epoch, and the filter loop of
+ *        main.cpp over histories of 10^3 epochs and up; the cost of timing one step into a latency histogram (ekf --latency)
+ *        and of adding its NIS to the consistency statistics
+ * @function twoStateClockModel::f, twoStateClockModel::h, twoStateClockModel::simpleEKF, latencyHistogram::recordTicks,
+ *           filterStats::add
+ */
+
+#include <random>
+
+#include "benchHistory.h"
+#include "../src/latencyHistogram.h"
+#include "../src/filterStats.h"
+
+namespace
+{
+	void BM_f(benchmark::State& state)
+	{
+		twoStateClockModel model(false, 1);
+		mat x_k = benchInputs(1).initial_state_estimate;
+		mat w_k = mat::Zero(2, 1);
+		for (auto _ : state)
+		{
+			model.f(x_k, w_k);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_f);
+
+	void BM_h(benchmark::State& state)
+	{
+		twoStateClockModel model(false, 1);
+		mat x_kp1_k = benchInputs(1).initial_state_estimate;
+		mat v_kp1 = mat::Zero(2, 1);
+
+		/// h reads the propagated state f leaves in the model, as in simpleEKF
+		model.f(x_kp1_k, mat::Zero(2, 1));
+		for (auto _ : state)
+		{
+			model.h(x_kp1_k, v_kp1);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_h);
+
+	/// One epoch, the estimate fed back as in main.cpp
+	void BM_simpleEKF_epoch(benchmark::State& state)
+	{
+		twoStateClockModel model(false, 1);
+		filter_input f_in = benchInputs(1024);
+		mat xk_est = f_in.initial_state_estimate;
+		mat xcovk_est = f_in.initial_state_estimate_covariance;
+		mat w_k = mat::Zero(2, 1);
+		mat v_kp1 = mat::Zero(2, 1);
+		std::int64_t k = 0;
+		for (auto _ : state)
+		{
+			model.simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, f_in.measurement_history.col(k++ & 1023), v_kp1,
+				f_in.measurement_noise_covariance);
+			xk_est = model.get_xkp1();
+			xcovk_est = model.get_xcov_kp1();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_simpleEKF_epoch);
+
+	/// The filter loop of main.cpp, filling the state, covariance and NIS histories
+	void BM_simpleEKF_history(benchmark::State& state)
+	{
+		const std::int64_t n = state.range(0);
+		twoStateClockModel model(false, 1);
+		filter_input f_in = benchInputs(n);
+		mat w_k = mat::Zero(2, 1);
+		mat v_kp1 = mat::Zero(2, 1);
+		mat xhat_hist = mat::Zero(2, n+1);
+		mat nis_hist = mat::Zero(1, n+1);
+		std::vector<Eigen::Matrix<double,2,2> > xcov_hist(n+1);
+		for (auto _ : state)
+		{
+			mat xk_est = f_in.initial_state_estimate;
+			mat xcovk_est = f_in.initial_state_estimate_covariance;
+			for (std::int64_t kp1=0; kp1<n; kp1++)
+			{
+				model.simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, f_in.measurement_history.col(kp1), v_kp1,
+					f_in.measurement_noise_covariance);
+				xhat_hist.col(kp1+1) = model.get_xkp1();
+				xcov_hist[kp1+1] = model.get_xcov_kp1();
+				mat temp = (model.get_zkp1().transpose()) * ((model.get_skp1()).inverse() * model.get_zkp1());
+				nis_hist(0, kp1+1) = temp(0);
+				xk_est = model.get_xkp1();
+				xcovk_est = model.get_xcov_kp1();
+			}
+			benchmark::DoNotOptimize(nis_hist.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+	BENCHMARK(BM_simpleEKF_history)->Apply(benchHistoryLengths);
+
+	/// Two counter reads and a histogram record, what "--latency" adds to every timed operation
+	void BM_latencyHistogram_record(benchmark::State& state)
+	{
+		latencyHistogram histogram;
+		cycleClock::nanosecondsPerTick();
+		for (auto _ : state)
+		{
+			const std::uint64_t start = cycleClock::now();
+			histogram.recordTicks(start, cycleClock::now());
+		}
+		benchmark::DoNotOptimize(histogram.count());
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_latencyHistogram_record);
+
+	/// One epoch of the consistency statistics, O(1) whatever the window length and however long the run
+	void BM_filterStats_add(benchmark::State& state)
+	{
+		std::mt19937_64 generator(11);
+		std::chi_squared_distribution<double> chi_square(2.0);
+		std::vector<double> values(1 << 16);
+		for (double& v : values)
+		{
+			v = chi_square(generator);
+		}
+		filterStats stats(2, 0.05, state.range(0));
+		std::size_t k = 0;
+		for (auto _ : state)
+		{
+			stats.add(values[k++ & (values.size() - 1)]);
+		}
+		benchmark::DoNotOptimize(stats.windowMean());
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_filterStats_add)->ArgName("window")->Arg(100)->Arg(100000);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+## Compares two sets of Google Benchmark JSON results, run by "make pgo" with cmake -P: the real time of every benchmark in
+## BASE_DIR and in NEW_DIR, and the speedup. Variables: BASE_DIR, NEW_DIR, BENCHMARKS (comma separated); needs CMake 3.19 for string(JSON)
+
+if (CMAKE_VERSION VERSION_LESS 3.19)
+	message(STATUS "Benchmark results in ${BASE_DIR} and ${NEW_DIR} (CMake 3.19 or later prints the comparison)")
+	return ()
+endif ()
+string(REPLACE "," ";" BENCHMARKS "${BENCHMARKS}")
+
+## Reads the real time of every benchmark of a result file into <prefix>_<name>, and the names into <prefix>_names
+function (readResults file prefix)
+	file(READ ${file} json)
+	set(${prefix}_names PARENT_SCOPE)
+	if (NOT json MATCHES "\"benchmarks\"")
+		return ()
+	endif ()
+	string(JSON count LENGTH "${json}" benchmarks)
+	set(names)
+	math(EXPR last "${count} - 1")
+	foreach (i RANGE ${last})
+		string(JSON name GET "${json}" benchmarks ${i} name)
+		string(JSON time GET "${json}" benchmarks ${i} real_time)
+		string(JSON unit GET "${json}" benchmarks ${i} time_unit)
+		list(APPEND names ${name})
+		set(${prefix}_${name} "${time} ${unit}" PARENT_SCOPE)
+	endforeach ()
+	set(${prefix}_names ${names} PARENT_SCOPE)
+endfunction ()
+
+## Fixed-point value of a decimal number, in thousandths: math(EXPR) only has integers
+function (thousandths number out)
+	string(REGEX MATCH "^([0-9]+)(\\.([0-9]*))?$" matched "${number}")
+	if (NOT matched)
+		set(${out} 0 PARENT_SCOPE)
+		return ()
+	endif ()
+	set(integer ${CMAKE_MATCH_1})
+	string(SUBSTRING "${CMAKE_MATCH_3}000" 0 3 fraction)
+	string(REGEX REPLACE "^0+([0-9])" "\\1" fraction "${fraction}")
+	math(EXPR value "${integer} * 1000 + ${fraction}")
+	set(${out} ${value} PARENT_SCOPE)
+endfunction ()
+
+foreach (bench ${BENCHMARKS})
+	if (NOT EXISTS ${BASE_DIR}/${bench}.json OR NOT EXISTS ${NEW_DIR}/${bench}.json)
+		continue ()
+	endif ()
+	readResults(${BASE_DIR}/${bench}.json base)
+	readResults(${NEW_DIR}/${bench}.json new)
+	message(STATUS "${bench}:")
+	foreach (name ${new_names})
+		if (DEFINED base_${name})
+			separate_arguments(base_time UNIX_COMMAND "${base_${name}}")
+			separate_arguments(new_time UNIX_COMMAND "${new_${name}}")
+			list(GET base_time 0 base_value)
+			list(GET new_time 0 new_value)
+			list(GET new_time 1 unit)
+			thousandths(${base_value} base_fixed)
+			thousandths(${new_value} new_fixed)
+			if (new_fixed GREATER 0)
+				math(EXPR speedup "${base_fixed} * 100 / ${new_fixed}")
+				math(EXPR speedup_integer "${speedup} / 100")
+				math(EXPR speedup_fraction "${speedup} % 100")
+				if (speedup_fraction LESS 10)
+					set(speedup_fraction 0${speedup_fraction})
+				endif ()
+				message(STATUS "  ${name}: ${base_value} -> ${new_value} ${unit}, x${speedup_integer}.${speedup_fraction}")
+			endif ()
+		endif ()
+	endforeach ()
+endforeach ()
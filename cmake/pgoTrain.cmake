@@ -0,0 +1,36 @@
+## Training workload of the profile-guided build, run by "make pgo" with cmake -P between the instrumented build and the
+## optimized one. Every run is the release path of ekf, so the profiles weigh the parse, filter and write loops as deployed:
+## - a simulated dataset of PGO_EPOCHS epochs with dropouts and outliers, in the filter_input layout
+## - ekf on its text files (parse, filter, write the outputs and the pyramid), then on the cache sidecars it wrote
+## - the benchmarks given in BENCHMARKS, on the histories matching BENCH_FILTER, so they can measure the speedup
+## Variables: BIN (the instrumented executables), PROFILE_DIR, PGO_EPOCHS, BENCHMARKS (comma separated), BENCH_FILTER, PROFDATA (Clang only)
+## Run from the build folder: ekf reads and writes relative to it, like ./bin/ekf
+
+string(REPLACE "," ";" BENCHMARKS "${BENCHMARKS}")
+
+set(DATASET ../filter_output/pgo_training)
+
+function (run)
+	execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+	if (NOT result EQUAL 0)
+		message(FATAL_ERROR "PGO training step failed (${result}): ${ARGN}")
+	endif ()
+endfunction ()
+
+message(STATUS "PGO training: ${PGO_EPOCHS} simulated epochs")
+run(${BIN}/generateDataset --epochs ${PGO_EPOCHS} --dropouts 0.01 --outliers 0.001 --seed 3 --out ${DATASET})
+run(${BIN}/ekf --input-dir ${DATASET} --no-plot)
+run(${BIN}/ekf --input-dir ${DATASET} --no-plot)
+
+foreach (bench ${BENCHMARKS})
+	message(STATUS "PGO training: ${bench}")
+	run(${BIN}/${bench} --benchmark_filter=${BENCH_FILTER} --benchmark_min_time=0.05)
+endforeach ()
+
+file(REMOVE_RECURSE ${DATASET})
+
+## Clang writes one raw profile per process, merged into the one -fprofile-use reads; GCC reads its .gcda files as they are
+if (PROFDATA)
+	file(GLOB raw_profiles ${PROFILE_DIR}/*.profraw)
+	run(${PROFDATA} merge -output=${PROFILE_DIR}/ekf.profdata ${raw_profiles})
+endif ()
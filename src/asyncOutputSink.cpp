@@ -0,0 +1,257 @@
+#include "asyncOutputSink.h"
+
+/// Std includes
+#include <chrono>
+#include <sstream>
+#include <iostream>
+
+/// Spans of the writer thread
+#include "traceEvents.h"
+
+/**
+ * @file asyncOutputSink.cpp
+ * @brief contains all the asyncOutputSink member function definitions declared in .h file
+ */
+
+/// ring constructor, the capacity is rounded up to a power of two so positions wrap with a mask
+asyncOutputSink::ring_segment::ring_segment(const std::size_t capacity)
+	: head(0), tail(0), next(NULL)
+{
+	std::size_t size = 2;
+	while (size < capacity)
+	{
+		size *= 2;
+	}
+	this->slots.resize(size);
+	this->mask = size - 1;
+}
+
+/// class constructor, writes into the filter output folder
+asyncOutputSink::asyncOutputSink(const std::string file_name, const sink_format out_format, const backpressure_policy bp_policy,
+									const std::size_t capacity, const std::size_t buffer_size)
+	: policy(bp_policy), record_format(out_format), style(number_style::fixed16), writer(buffer_size)
+{
+	std::stringstream ss;
+	ss << "../filter_output/" << file_name;
+	this->writer_open = this->writer.open(ss.str());
+	if (!this->writer_open)
+	{
+		std::cerr << "Error opening the output file " << file_name << std::endl;
+	}
+	start(capacity);
+}
+
+/// class constructor, writes into a custom destination
+asyncOutputSink::asyncOutputSink(const bufferedWriter::destination dest, const sink_format out_format, const backpressure_policy bp_policy,
+									const std::size_t capacity, const std::size_t buffer_size)
+	: policy(bp_policy), record_format(out_format), style(number_style::fixed16), writer(buffer_size)
+{
+	this->writer_open = this->writer.open(dest);
+	start(capacity);
+}
+
+/// class destructor, drains the ring and frees the chained segments
+asyncOutputSink::~asyncOutputSink()
+{
+	shutdown();
+	while (this->consume_segment != NULL)
+	{
+		ring_segment* next = this->consume_segment->next.load(std::memory_order_acquire);
+		delete this->consume_segment;
+		this->consume_segment = next;
+	}
+}
+
+/// Allocate the first ring and start the writer thread
+void asyncOutputSink::start(const std::size_t capacity)
+{
+	this->produce_segment = new ring_segment(capacity);
+	this->consume_segment = this->produce_segment;
+	this->cached_head = 0;
+	this->stopping = false;
+	this->stopped = false;
+	this->write_ok = false;
+	this->dropped_count = 0;
+	this->written_count = 0;
+	this->worker = std::thread(&asyncOutputSink::run, this);
+}
+
+/// Number formatting of the text records
+void asyncOutputSink::setNumberStyle(const number_style number_fmt)
+{
+	this->style = number_fmt;
+}
+
+/// Hand a result to the writer thread; only the filter loop calls this
+bool asyncOutputSink::push(const epoch_result& result)
+{
+	ring_segment* segment = this->produce_segment;
+	std::size_t tail = segment->tail.load(std::memory_order_relaxed);
+
+	/// Only look at the consumer position when the last one seen says the ring is full
+	if (tail - this->cached_head > segment->mask)
+	{
+		this->cached_head = segment->head.load(std::memory_order_acquire);
+		if (tail - this->cached_head > segment->mask)
+		{
+			if (this->policy == backpressure_policy::drop)
+			{
+				this->dropped_count.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else if (this->policy == backpressure_policy::grow)
+			{
+				/// Fill the first slot of a ring twice the size, then publish it to the writer thread
+				ring_segment* bigger = new ring_segment(2 * (segment->mask + 1));
+				bigger->slots[0] = result;
+				bigger->tail.store(1, std::memory_order_relaxed);
+				segment->next.store(bigger, std::memory_order_release);
+				this->produce_segment = bigger;
+				this->cached_head = 0;
+				return true;
+			}
+
+			while (tail - this->cached_head > segment->mask)
+			{
+				std::this_thread::yield();
+				this->cached_head = segment->head.load(std::memory_order_acquire);
+			}
+		}
+	}
+
+	segment->slots[tail & segment->mask] = result;
+	segment->tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+/// Take the next result out of the ring; only the writer thread calls this
+bool asyncOutputSink::pop(epoch_result& result)
+{
+	ring_segment* segment = this->consume_segment;
+	std::size_t head = segment->head.load(std::memory_order_relaxed);
+
+	if (head == segment->tail.load(std::memory_order_acquire))
+	{
+		/// The producer only moves on to the next ring after its last write to this one
+		ring_segment* next = segment->next.load(std::memory_order_acquire);
+		if (next == NULL)
+		{
+			return false;
+		}
+		if (head == segment->tail.load(std::memory_order_acquire))
+		{
+			delete segment;
+			this->consume_segment = next;
+			return pop(result);
+		}
+	}
+
+	result = segment->slots[head & segment->mask];
+	segment->head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+/// Add a single result to the output buffer
+void asyncOutputSink::format(const epoch_result& result)
+{
+	if (this->record_format == sink_format::binary)
+	{
+		this->writer.putBytes(reinterpret_cast<const char*>(&result), sizeof(result));
+		return;
+	}
+
+	this->writer.putUnsigned(result.epoch);
+	for (int i=0; i<2; ++i)
+	{
+		this->writer.putChar(',');
+		this->writer.putDouble(result.state[i], this->style);
+	}
+	for (int i=0; i<4; ++i)
+	{
+		this->writer.putChar(',');
+		this->writer.putDouble(result.covariance[i], this->style);
+	}
+	this->writer.putChar(',');
+	this->writer.putDouble(result.nis, this->style);
+	this->writer.putChar('\n');
+}
+
+/// Writer thread: format everything queued, flush once the ring runs empty, back off while idle
+void asyncOutputSink::run()
+{
+	TRACE_THREAD_NAME("asyncOutputSink writer");
+	epoch_result result;
+	bool pending = false;
+	unsigned idle = 0;
+
+	while (true)
+	{
+		if (pop(result))
+		{
+			format(result);
+			this->written_count.fetch_add(1, std::memory_order_relaxed);
+			pending = true;
+			idle = 0;
+			continue;
+		}
+
+		if (this->stopping.load(std::memory_order_acquire))
+		{
+			/// Everything pushed before the stop request is visible now
+			while (pop(result))
+			{
+				format(result);
+				this->written_count.fetch_add(1, std::memory_order_relaxed);
+			}
+			break;
+		}
+
+		if (pending)
+		{
+			TRACE_SCOPE(trace, "flush", "io", NULL);
+			this->writer.flush();
+			pending = false;
+		}
+
+		if (++idle < 64)
+		{
+			std::this_thread::yield();
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	}
+
+	this->write_ok = this->writer_open and this->writer.close();
+}
+
+/// Stop the writer thread once it has written everything queued
+bool asyncOutputSink::shutdown()
+{
+	if (!this->stopped)
+	{
+		this->stopping.store(true, std::memory_order_release);
+		this->worker.join();
+		this->stopped = true;
+	}
+	return this->write_ok;
+}
+
+/// Check if the output destination could be opened
+bool asyncOutputSink::isOpen() const
+{
+	return this->writer_open;
+}
+
+/// Return the number of results dropped because the ring was full
+std::uint64_t asyncOutputSink::dropped() const
+{
+	return this->dropped_count.load(std::memory_order_relaxed);
+}
+
+/// Return the number of results written by the writer thread
+std::uint64_t asyncOutputSink::written() const
+{
+	return this->written_count.load(std::memory_order_relaxed);
+}
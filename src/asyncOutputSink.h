@@ -0,0 +1,193 @@
+#ifndef ASYNC_OUTPUT_SINK_H
+#define ASYNC_OUTPUT_SINK_H
+
+/// Std includes
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/// Buffered output formatting
+#include "bufferedWriter.h"
+
+/**
+ * @file asyncOutputSink.h
+ * @brief contains the declaration of the asynchronous output sink used to write per-epoch filter results from a background thread
+ */
+
+/**
+ * @brief epoch_result struct holding the filter outputs of a single epoch
+ */
+struct epoch_result
+{
+	std::uint64_t epoch;
+	double state[2];      /// a posteriori state [clock bias, clock rate]
+	double covariance[4]; /// a posteriori covariance, column-major 2x2
+	double nis;           /// normalized innovation squared
+};
+
+/**
+ * @brief backpressure_policy what the filter loop does when the output ring is full
+ * - block: wait until the writer thread frees a slot
+ * - drop: discard the result and count it
+ * - grow: chain a larger ring, the filter never waits
+ */
+enum class backpressure_policy
+{
+	block,
+	drop,
+	grow
+};
+
+/**
+ * @brief sink_format encoding of the per-epoch results in the output
+ * - text: one comma separated line per epoch, "epoch,bias,rate,P00,P10,P01,P11,nis"
+ * - binary: the raw epoch_result records
+ */
+enum class sink_format
+{
+	text,
+	binary
+};
+
+/**
+ * @brief The asyncOutputSink class takes per-epoch results from the filter loop through a lock-free single producer,
+ * single consumer ring and formats and writes them on a background thread, so the filter never waits on the storage
+ */
+class asyncOutputSink
+{
+private:
+	/// One ring of result slots; with the grow policy, full rings are chained to a larger successor
+	struct ring_segment
+	{
+		std::vector<epoch_result> slots;
+		std::size_t mask;
+
+		/// Consumer and producer positions on their own cache lines
+		char pad_0[64];
+		std::atomic<std::size_t> head;
+		char pad_1[64];
+		std::atomic<std::size_t> tail;
+		char pad_2[64];
+		std::atomic<ring_segment*> next;
+
+		explicit ring_segment(const std::size_t capacity);
+	};
+
+	/// Segment written by the filter loop, last head value seen by the producer
+	ring_segment* produce_segment;
+	std::size_t cached_head;
+
+	/// Segment read by the writer thread
+	ring_segment* consume_segment;
+
+	backpressure_policy policy;
+	sink_format record_format;
+	number_style style;
+
+	/// Output buffer, only touched by the writer thread once it is started
+	bufferedWriter writer;
+	bool writer_open;
+
+	std::thread worker;
+	std::atomic<bool> stopping;
+	bool stopped;
+
+	/// Set by the writer thread when it closed the output, valid once the thread is joined
+	bool write_ok;
+
+	std::atomic<std::uint64_t> dropped_count;
+	std::atomic<std::uint64_t> written_count;
+
+	/**
+	 * @brief start allocate the first ring and start the writer thread
+	 * @param capacity number of slots in the first ring
+	 */
+	void start(const std::size_t capacity);
+
+	/**
+	 * @brief run writer thread loop: drain the ring, format the results and flush when idle
+	 */
+	void run();
+
+	/**
+	 * @brief pop take the next result out of the ring, moving on to a chained ring when needed
+	 * @param result holds the result taken out
+	 * @return boolean value, false when the ring is empty
+	 */
+	bool pop(epoch_result& result);
+
+	/**
+	 * @brief format add a single result to the output buffer
+	 * @param result the result to write
+	 */
+	void format(const epoch_result& result);
+
+public:
+	/**
+	 * @brief asyncOutputSink class constructor, writes to the given file in the filter output folder
+	 * @param file_name the file name, to write the output to
+	 * @param out_format text or binary records
+	 * @param bp_policy what to do when the ring is full
+	 * @param capacity number of results the ring holds, rounded up to a power of two
+	 * @param buffer_size size of the output buffer of the writer thread in bytes
+	 */
+	asyncOutputSink(const std::string file_name, const sink_format out_format, const backpressure_policy bp_policy,
+					const std::size_t capacity = 4096, const std::size_t buffer_size = 1 << 20);
+
+	/**
+	 * @brief asyncOutputSink class constructor, writes to a custom destination
+	 * @param dest function receiving each chunk of formatted output
+	 * @param out_format text or binary records
+	 * @param bp_policy what to do when the ring is full
+	 * @param capacity number of results the ring holds, rounded up to a power of two
+	 * @param buffer_size size of the output buffer of the writer thread in bytes
+	 */
+	asyncOutputSink(const bufferedWriter::destination dest, const sink_format out_format, const backpressure_policy bp_policy,
+					const std::size_t capacity = 4096, const std::size_t buffer_size = 1 << 20);
+
+	/**
+	 * @brief ~asyncOutputSink class destructor, flushes everything still queued
+	 */
+	~asyncOutputSink();
+
+	/**
+	 * @brief setNumberStyle choose the number formatting of the text output, call before the first push
+	 * @param number_fmt fixed 16-digit scientific or shortest round-trip
+	 */
+	void setNumberStyle(const number_style number_fmt);
+
+	/**
+	 * @brief push hand a result to the writer thread, called from the filter loop only
+	 * @param result the filter outputs of one epoch
+	 * @return boolean value, false if the result was dropped
+	 */
+	bool push(const epoch_result& result);
+
+	/**
+	 * @brief shutdown write everything still queued, flush the output and stop the writer thread
+	 * @return boolean value, false if any write failed
+	 */
+	bool shutdown();
+
+	/**
+	 * @brief isOpen check if the output destination could be opened
+	 * @return boolean value
+	 */
+	bool isOpen() const;
+
+	/**
+	 * @brief dropped getter function for the number of results dropped because the ring was full
+	 * @return number of dropped results
+	 */
+	std::uint64_t dropped() const;
+
+	/**
+	 * @brief written getter function for the number of results formatted by the writer thread
+	 * @return number of written results
+	 */
+	std::uint64_t written() const;
+};
+
+#endif // ASYNC_OUTPUT_SINK_H
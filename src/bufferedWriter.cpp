@@ -0,0 +1,259 @@
+#include "bufferedWriter.h"
+
+/// Std includes
+#include <cstdio>  // std::snprintf
+#include <cstdlib> // std::strtod
+#include <algorithm> // std::min
+#include <cerrno>
+#include <cstring> // std::memcpy
+
+/// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+
+/// std::to_chars for doubles is only available from C++17 on recent standard libraries
+#if defined(__has_include)
+#  if __has_include(<charconv>) && __cplusplus >= 201703L
+#    include <charconv>
+#  endif
+#endif
+
+/**
+ * @file bufferedWriter.cpp
+ * @brief contains all the bufferedWriter member function definitions declared in .h file
+ */
+
+/// class constructor, allocates the output buffer
+bufferedWriter::bufferedWriter(const std::size_t buffer_size)
+	: fd(-1), buffer(buffer_size < 64 ? 64 : buffer_size), used(0), bytes_written(0), write_error(false)
+{
+}
+
+/// class destructor, make sure nothing buffered is lost
+bufferedWriter::~bufferedWriter()
+{
+	close();
+}
+
+/// Create or truncate the output file
+bool bufferedWriter::open(const std::string file_name)
+{
+	close();
+	this->used = 0;
+	this->bytes_written = 0;
+	this->write_error = false;
+
+	this->fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	return this->fd >= 0;
+}
+
+/// Send the output to a custom destination
+bool bufferedWriter::open(const destination dest)
+{
+	close();
+	this->used = 0;
+	this->bytes_written = 0;
+	this->write_error = false;
+
+	this->sink = dest;
+	return static_cast<bool>(this->sink);
+}
+
+/// Format a single value, using std::to_chars when available
+char* bufferedWriter::formatDouble(char* first, const double value, const number_style style)
+{
+#if defined(__cpp_lib_to_chars)
+	if (style == number_style::fixed16)
+	{
+		return std::to_chars(first, first + 32, value, std::chars_format::scientific, 16).ptr;
+	}
+	return std::to_chars(first, first + 32, value).ptr;
+#else
+	if (style == number_style::fixed16)
+	{
+		return first + std::snprintf(first, 32, "%.16e", value);
+	}
+
+	/// Shortest round-trip: use the fewest significant digits that read back to the same value
+	int n = 0;
+	for (int precision = 15; precision <= 17; ++precision)
+	{
+		n = std::snprintf(first, 32, "%.*g", precision, value);
+		if (std::strtod(first, NULL) == value or value != value)
+		{
+			break;
+		}
+	}
+	return first + n;
+#endif
+}
+
+/// Flush the buffer first if the next n bytes would not fit
+void bufferedWriter::reserve(const std::size_t n)
+{
+	if (this->used + n > this->buffer.size())
+	{
+		flush();
+	}
+}
+
+/// Add a single formatted value to the buffer
+void bufferedWriter::putDouble(const double value, const number_style style)
+{
+	reserve(32);
+	char* first = &this->buffer[this->used];
+	this->used = formatDouble(first, value, style) - &this->buffer[0];
+}
+
+/// Add an integer value to the buffer, digits are produced back to front
+void bufferedWriter::putUnsigned(std::uint64_t value)
+{
+	char digits[20];
+	int n = 0;
+	do
+	{
+		digits[n++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value > 0);
+
+	reserve(n);
+	while (n > 0)
+	{
+		this->buffer[this->used++] = digits[--n];
+	}
+}
+
+/// Add a single character to the buffer
+void bufferedWriter::putChar(const char c)
+{
+	reserve(1);
+	this->buffer[this->used++] = c;
+}
+
+/// Add raw bytes to the buffer, large blocks go through several flushes
+void bufferedWriter::putBytes(const char* data, const std::size_t n)
+{
+	std::size_t offset = 0;
+	while (offset < n)
+	{
+		reserve(1);
+		std::size_t chunk = std::min(n - offset, this->buffer.size() - this->used);
+		std::memcpy(&this->buffer[this->used], data + offset, chunk);
+		this->used += chunk;
+		offset += chunk;
+	}
+}
+
+/// Add a whole matrix to the buffer in the requested orientation
+void bufferedWriter::putMatrix(const Eigen::MatrixXd& output, const matrix_layout layout, const number_style style)
+{
+	if (layout == matrix_layout::matrix)
+	{
+		for (int i=0; i<output.rows(); ++i)
+		{
+			for (int j=0; j<output.cols(); ++j)
+			{
+				if (j > 0)
+				{
+					putChar(' ');
+				}
+				putDouble(output(i,j), style);
+			}
+			/// No newline after the last row, same as streaming the matrix through operator<<
+			if (i+1 < output.rows())
+			{
+				putChar('\n');
+			}
+		}
+	}
+	else
+	{
+		/// Matrices are column-major, so one epoch per line walks the memory in order
+		for (int j=0; j<output.cols(); ++j)
+		{
+			for (int i=0; i<output.rows(); ++i)
+			{
+				if (i > 0)
+				{
+					putChar(',');
+				}
+				putDouble(output(i,j), style);
+			}
+			putChar('\n');
+		}
+	}
+}
+
+/// Hand the buffered bytes to the file or the destination, retrying on short writes
+bool bufferedWriter::flush()
+{
+	const char* data = &this->buffer[0];
+	std::size_t remaining = this->used;
+
+	if (this->sink and remaining > 0 and !this->write_error)
+	{
+		if (this->sink(data, remaining))
+		{
+			this->bytes_written += remaining;
+		}
+		else
+		{
+			this->write_error = true;
+		}
+		remaining = 0;
+	}
+
+	while (remaining > 0 and this->fd >= 0 and !this->write_error)
+	{
+		ssize_t n = ::write(this->fd, data, remaining);
+		if (n < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			this->write_error = true;
+			break;
+		}
+		data += n;
+		remaining -= n;
+		this->bytes_written += n;
+	}
+
+	this->used = 0;
+	return (this->fd >= 0 or this->sink) and !this->write_error;
+}
+
+/// Flush and close the output file
+bool bufferedWriter::close(const bool sync)
+{
+	if (this->sink)
+	{
+		bool ok = flush();
+		this->sink = destination();
+		return ok;
+	}
+
+	if (this->fd < 0)
+	{
+		return false;
+	}
+
+	bool ok = flush();
+	if (sync and ::fsync(this->fd) != 0)
+	{
+		ok = false;
+	}
+	if (::close(this->fd) != 0)
+	{
+		ok = false;
+	}
+	this->fd = -1;
+	return ok;
+}
+
+/// Return the number of bytes written so far
+std::size_t bufferedWriter::bytesWritten() const
+{
+	return this->bytes_written;
+}
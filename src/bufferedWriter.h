@@ -0,0 +1,163 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <cstdint>
+
+/// Eigen includes
+#include <Eigen/Dense>
+
+/**
+ * @file bufferedWriter.h
+ * @brief contains the declaration of the buffered output writer used for the filter output text files
+ */
+
+/**
+ * @brief number_style selects how every value is converted to text
+ * - fixed16: scientific notation with 16 decimal digits, as the filter outputs have always been written
+ * - shortest: shortest text that still reads back to the exact same double
+ */
+enum class number_style
+{
+	fixed16,
+	shortest
+};
+
+/**
+ * @brief matrix_layout selects the orientation of a matrix in the output file
+ * - matrix: one line per matrix row, values separated by a space (rows are the states, columns the epochs)
+ * - csv_rows: one line per matrix column (epoch), values separated by a comma
+ */
+enum class matrix_layout
+{
+	matrix,
+	csv_rows
+};
+
+/**
+ * @brief The bufferedWriter class formats numbers straight into a large memory buffer and hands it to the
+ * file descriptor in a few big writes, instead of streaming every value through std::ofstream
+ */
+class bufferedWriter
+{
+public:
+	/// Destination that receives the buffered bytes instead of a file, returns false when the write failed
+	typedef std::function<bool(const char*, std::size_t)> destination;
+
+private:
+	/// Output file descriptor, -1 when nothing is open
+	int fd;
+
+	/// Output destination used instead of the file descriptor, if set
+	destination sink;
+
+	/// Output buffer and the number of bytes used in it
+	std::vector<char> buffer;
+	std::size_t used;
+
+	/// Total number of bytes handed to the file so far
+	std::size_t bytes_written;
+
+	/// Set once any write to the file failed
+	bool write_error;
+
+	/**
+	 * @brief reserve make sure at least n bytes are free in the buffer, flushing it if needed
+	 * @param n number of bytes needed
+	 */
+	void reserve(const std::size_t n);
+
+public:
+	/**
+	 * @brief bufferedWriter class constructor
+	 * @param buffer_size size of the output buffer in bytes, the file is written in chunks of this size
+	 */
+	explicit bufferedWriter(const std::size_t buffer_size = 1 << 20);
+
+	/**
+	 * @brief ~bufferedWriter class destructor, flushes and closes the file if still open
+	 */
+	~bufferedWriter();
+
+	/**
+	 * @brief open create or truncate the given file for writing
+	 * @param file_name path of the file to write
+	 * @return boolean value
+	 */
+	bool open(const std::string file_name);
+
+	/**
+	 * @brief open send the buffered bytes to the given destination instead of a file
+	 * @param dest function receiving each flushed chunk
+	 * @return boolean value
+	 */
+	bool open(const destination dest);
+
+	/**
+	 * @brief putDouble format a single value into the buffer
+	 * @param value the value to write
+	 * @param style number formatting to use
+	 */
+	void putDouble(const double value, const number_style style);
+
+	/**
+	 * @brief putUnsigned format an integer value, such as an epoch counter, into the buffer
+	 * @param value the value to write
+	 */
+	void putUnsigned(std::uint64_t value);
+
+	/**
+	 * @brief putChar add a single character to the buffer
+	 * @param c the character to write
+	 */
+	void putChar(const char c);
+
+	/**
+	 * @brief putBytes add raw bytes to the buffer, used for binary output
+	 * @param data the bytes to write
+	 * @param n number of bytes
+	 */
+	void putBytes(const char* data, const std::size_t n);
+
+	/**
+	 * @brief putMatrix format a whole matrix into the buffer
+	 * @param output matrix to write
+	 * @param layout orientation of the matrix in the file
+	 * @param style number formatting to use
+	 */
+	void putMatrix(const Eigen::MatrixXd& output, const matrix_layout layout, const number_style style);
+
+	/**
+	 * @brief flush hand the buffered bytes to the file
+	 * @return boolean value, false if any write failed so far
+	 */
+	bool flush();
+
+	/**
+	 * @brief close flush the buffer and close the file
+	 * @param sync also wait for the data to reach the storage device (fsync)
+	 * @return boolean value, false if any write failed
+	 */
+	bool close(const bool sync = false);
+
+	/**
+	 * @brief bytesWritten getter function for the number of bytes written to the file so far
+	 * @return number of bytes
+	 */
+	std::size_t bytesWritten() const;
+
+	/**
+	 * @brief formatDouble format a single value into the given character range
+	 * @param first beginning of the output range, must have room for at least 32 characters
+	 * @param value the value to write
+	 * @param style number formatting to use
+	 * @return pointer one past the last written character
+	 */
+	static char* formatDouble(char* first, const double value, const number_style style);
+};
+
+#endif // BUFFERED_WRITER_H
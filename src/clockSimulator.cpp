@@ -0,0 +1,495 @@
+#include "clockSimulator.h"
+
+/// Std includes
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+
+/// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/// Number formatting shared with the filter outputs, sidecars of the parsed-input cache
+#include "bufferedWriter.h"
+#include "inputCache.h"
+
+/// Filter input files read as the filter reads them
+#include "pointOneNav.h"
+
+/**
+ * @file clockSimulator.cpp
+ * @brief contains all the clockSimulator member function definitions declared in .h file
+ */
+
+/// splitmix64 step, spreads a seed over the 64 bits
+static std::uint64_t simulationMix(std::uint64_t x)
+{
+	x += 0x9E3779B97F4A7C15ull;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+	return x ^ (x >> 31);
+}
+
+/**
+ * @brief simulation_stream struct is the random stream of one block (xoshiro256**), with the same values on every platform:
+ * the uniforms and the normals (Box-Muller) are computed here instead of with the implementation-defined std distributions
+ */
+struct simulation_stream
+{
+	std::uint64_t s[4];
+
+	simulation_stream(const std::uint64_t seed, const unsigned clock, const std::uint64_t block)
+	{
+		std::uint64_t x = simulationMix(seed) ^ simulationMix(0x5851F42D4C957F2Dull * (clock + 1)) ^ simulationMix(block);
+		for (int i=0; i<4; ++i)
+		{
+			x = simulationMix(x);
+			this->s[i] = x;
+		}
+	}
+
+	std::uint64_t next()
+	{
+		const std::uint64_t result = rotate(this->s[1] * 5, 7) * 9;
+		const std::uint64_t t = this->s[1] << 17;
+		this->s[2] ^= this->s[0];
+		this->s[3] ^= this->s[1];
+		this->s[1] ^= this->s[2];
+		this->s[0] ^= this->s[3];
+		this->s[2] ^= t;
+		this->s[3] = rotate(this->s[3], 45);
+		return result;
+	}
+
+	static std::uint64_t rotate(const std::uint64_t x, const int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	/// Uniform in [0, 1)
+	double uniform()
+	{
+		return (this->next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	/// Two standard normal values
+	void normals(double& a, double& b)
+	{
+		const double radius = std::sqrt(-2.0 * std::log(1.0 - this->uniform()));
+		const double angle = 6.283185307179586 * this->uniform();
+		a = radius * std::cos(angle);
+		b = radius * std::sin(angle);
+	}
+};
+
+/// Lower Cholesky factor of a 2x2 covariance, zero for a zero covariance
+static Eigen::Matrix2d simulationFactor(const Eigen::Matrix2d& covariance)
+{
+	Eigen::LLT<Eigen::Matrix2d> llt(covariance);
+	if (llt.info() == Eigen::Success)
+	{
+		return llt.matrixL();
+	}
+	Eigen::Matrix2d factor = Eigen::Matrix2d::Zero();
+	factor(0, 0) = std::sqrt(std::max(covariance(0, 0), 0.0));
+	factor(1, 1) = std::sqrt(std::max(covariance(1, 1), 0.0));
+	return factor;
+}
+
+/// Create the directory and its parents, existing ones are fine
+static bool simulationMakeDirectory(const std::string directory)
+{
+	for (std::size_t slash=directory.find('/', 1); ; slash=directory.find('/', slash + 1))
+	{
+		std::string path = directory.substr(0, slash);
+		struct stat st;
+		if (!path.empty() and ::stat(path.c_str(), &st) != 0 and ::mkdir(path.c_str(), 0755) != 0)
+		{
+			std::cerr << "Error creating the directory " << path << std::endl;
+			return false;
+		}
+		if (slash == std::string::npos)
+		{
+			return true;
+		}
+	}
+}
+
+/// Write the whole range at the given offset, short writes are continued
+static bool simulationWriteAt(const int fd, const char* data, const std::size_t size, const std::uint64_t offset)
+{
+	std::size_t written = 0;
+	while (written < size)
+	{
+		ssize_t n = ::pwrite(fd, data + written, size - written, offset + written);
+		if (n <= 0)
+		{
+			return false;
+		}
+		written += n;
+	}
+	return true;
+}
+
+/// Small matrices, one row per line
+static bool simulationWriteMatrix(const std::string file_name, const Eigen::MatrixXd& values)
+{
+	std::string text;
+	char field[clockSimulator::value_width];
+	for (Eigen::Index i=0; i<values.rows(); ++i)
+	{
+		for (Eigen::Index j=0; j<values.cols(); ++j)
+		{
+			clockSimulator::formatValue(field, values(i, j));
+			text.append(field, sizeof(field));
+		}
+		text.push_back('\n');
+	}
+	int fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	bool ok = fd >= 0 and simulationWriteAt(fd, text.data(), text.size(), 0);
+	if (fd < 0 or ::close(fd) != 0 or !ok)
+	{
+		std::cerr << "Error writing " << file_name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+const std::uint64_t clockSimulator::block_epochs;
+const std::size_t clockSimulator::value_width;
+
+/// class constructor, the effect of every block on a zero state is found in parallel and chained over the blocks
+clockSimulator::clockSimulator(const simulation_config& config)
+	: config(config)
+{
+	if (this->config.threads == 0)
+	{
+		this->config.threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	this->process_factor = simulationFactor(config.process_noise_covariance);
+	this->measurement_factor = simulationFactor(config.measurement_noise_covariance);
+	this->initial_factor = simulationFactor(config.initial_covariance);
+
+	const std::uint64_t blocks = (config.epochs + block_epochs - 1) / block_epochs;
+	std::vector<std::vector<Eigen::Vector2d> > offsets(config.clocks, std::vector<Eigen::Vector2d>(blocks));
+	this->forEachBlock([this, &offsets](const unsigned clock, const std::uint64_t block)
+	{
+		const std::uint64_t end = std::min(block_epochs, this->config.epochs - block * block_epochs);
+		offsets[clock][block] = this->simulateBlock(clock, block, 0, end, Eigen::Vector2d::Zero(), NULL, NULL);
+		return true;
+	});
+
+	/// x(0) has a stream of its own, after the one of the last possible block
+	this->block_start.assign(config.clocks, std::vector<Eigen::Vector2d>(blocks));
+	for (unsigned clock=0; clock<config.clocks; ++clock)
+	{
+		simulation_stream stream(config.seed, clock, std::numeric_limits<std::uint64_t>::max());
+		Eigen::Vector2d normal;
+		stream.normals(normal(0), normal(1));
+		Eigen::Vector2d state = config.initial_state + this->initial_factor * normal;
+		for (std::uint64_t block=0; block<blocks; ++block)
+		{
+			this->block_start[clock][block] = state;
+			const double length = static_cast<double>(std::min(block_epochs, config.epochs - block * block_epochs));
+			state(0) += length * config.dt * state(1);
+			state += offsets[clock][block];
+		}
+	}
+}
+
+/// Every epoch draws the same number of values, so the stream of a block does not depend on which of its epochs are kept
+Eigen::Vector2d clockSimulator::simulateBlock(const unsigned clock, const std::uint64_t block, const std::uint64_t begin, const std::uint64_t end,
+	const Eigen::Vector2d start, double* truth, double* measurements) const
+{
+	simulation_stream stream(this->config.seed, clock, block);
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	Eigen::Vector2d x = start;
+	for (std::uint64_t k=0; k<end; ++k)
+	{
+		Eigen::Vector2d w, v;
+		double jump, spare;
+		stream.normals(w(0), w(1));
+		stream.normals(v(0), v(1));
+		stream.normals(jump, spare);
+		const double u_jump = stream.uniform();
+		const double u_outlier = stream.uniform();
+		const double u_dropout = stream.uniform();
+
+		x(0) += this->config.dt * x(1);
+		x += this->process_factor * w;
+		if (u_jump < this->config.jump_rate)
+		{
+			x(0) += this->config.jump_sigma * jump;
+		}
+		if (k < begin or truth == NULL)
+		{
+			continue;
+		}
+
+		Eigen::Vector2d y = x + (u_outlier < this->config.outlier_rate ? this->config.outlier_scale : 1.0) * (this->measurement_factor * v);
+		const std::uint64_t column = 2 * (k - begin);
+		truth[column] = x(0);
+		truth[column + 1] = x(1);
+		measurements[column] = u_dropout < this->config.dropout_rate ? nan : y(0);
+		measurements[column + 1] = u_dropout < this->config.dropout_rate ? nan : y(1);
+	}
+	return x;
+}
+
+/// Blocks are handed out one at a time, the clocks one after the other
+bool clockSimulator::forEachBlock(const std::function<bool(const unsigned clock, const std::uint64_t block)>& job) const
+{
+	const std::uint64_t blocks = (this->config.epochs + block_epochs - 1) / block_epochs;
+	const std::uint64_t tasks = blocks * this->config.clocks;
+	std::atomic<std::uint64_t> next(0);
+	std::atomic<bool> ok(true);
+	auto worker = [&]()
+	{
+		for (std::uint64_t task=next++; task<tasks and ok; task=next++)
+		{
+			if (!job(static_cast<unsigned>(task / blocks), task % blocks))
+			{
+				ok = false;
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	const unsigned threads = static_cast<unsigned>(std::min<std::uint64_t>(this->config.threads, tasks));
+	for (unsigned t=1; t<threads; ++t)
+	{
+		workers.push_back(std::thread(worker));
+	}
+	worker();
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+	return ok;
+}
+
+bool clockSimulator::simulate(const unsigned clock, const std::uint64_t first, const std::uint64_t count, Eigen::MatrixXd& truth,
+	Eigen::MatrixXd& measurements) const
+{
+	if (clock >= this->config.clocks or first + count > this->config.epochs or first + count < first)
+	{
+		return false;
+	}
+	truth.resize(2, count);
+	measurements.resize(2, count);
+	for (std::uint64_t epoch=first; epoch<first + count; )
+	{
+		const std::uint64_t block = epoch / block_epochs;
+		const std::uint64_t begin = epoch - block * block_epochs;
+		const std::uint64_t end = std::min(block_epochs, first + count - block * block_epochs);
+		this->simulateBlock(clock, block, begin, end, this->block_start[clock][block], truth.data() + 2 * (epoch - first),
+			measurements.data() + 2 * (epoch - first));
+		epoch += end - begin;
+	}
+	return true;
+}
+
+std::string clockSimulator::clockDirectory(const std::string directory, const unsigned clock) const
+{
+	return this->config.clocks == 1 ? directory : directory + "/clock_" + std::to_string(clock);
+}
+
+void clockSimulator::formatValue(char* first, const double value)
+{
+	char digits[32];
+	const char* last = std::isnan(value) ? std::strcpy(digits, "nan") + 3 : bufferedWriter::formatDouble(digits, value, number_style::fixed16);
+	const std::size_t length = std::min<std::size_t>(last - digits, value_width - 1);
+	std::memset(first, ' ', value_width - length);
+	std::memcpy(first + value_width - length, digits, length);
+}
+
+/// The text files are sized up front, every block formats its columns and writes them at their offsets in both rows
+bool clockSimulator::write(const std::string directory, const bool binary) const
+{
+	const std::uint64_t n = this->config.epochs;
+	const std::uint64_t row_bytes = n * value_width + 1;
+	std::vector<int> history_fd(this->config.clocks, -1), truth_fd(this->config.clocks, -1);
+	bool ok = simulationMakeDirectory(directory);
+	for (unsigned clock=0; clock<this->config.clocks and ok; ++clock)
+	{
+		const std::string path = this->clockDirectory(directory, clock) + "/";
+		Eigen::MatrixXd initial_state = this->config.initial_state;
+		ok = simulationMakeDirectory(path) and
+			simulationWriteMatrix(path + "initial_state_estimate.txt", initial_state) and
+			simulationWriteMatrix(path + "initial_state_estimate_covariance.txt", this->config.initial_covariance) and
+			simulationWriteMatrix(path + "process_noise_covariance.txt", this->config.process_noise_covariance) and
+			simulationWriteMatrix(path + "measurement_noise_covariance.txt", this->config.measurement_noise_covariance);
+
+		/// Both rows end with a newline, the values in between are written by the blocks
+		for (int file=0; file<2 and ok; ++file)
+		{
+			const std::string name = path + (file == 0 ? "measurement_history.txt" : "truth.txt");
+			int fd = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			(file == 0 ? history_fd : truth_fd)[clock] = fd;
+			ok = fd >= 0 and ::ftruncate(fd, 2 * row_bytes) == 0 and simulationWriteAt(fd, "\n", 1, row_bytes - 1) and
+				simulationWriteAt(fd, "\n", 1, 2 * row_bytes - 1);
+			if (!ok)
+			{
+				std::cerr << "Error writing " << name << std::endl;
+			}
+		}
+	}
+
+	ok = ok and this->forEachBlock([&](const unsigned clock, const std::uint64_t block)
+	{
+		const std::uint64_t first = block * block_epochs;
+		const std::uint64_t count = std::min(block_epochs, n - first);
+		std::vector<double> truth(2 * count), measurements(2 * count);
+		this->simulateBlock(clock, block, 0, count, this->block_start[clock][block], truth.data(), measurements.data());
+
+		std::vector<char> text(count * value_width);
+		for (int file=0; file<2; ++file)
+		{
+			const std::vector<double>& values = file == 0 ? measurements : truth;
+			const int fd = (file == 0 ? history_fd : truth_fd)[clock];
+			for (int row=0; row<2; ++row)
+			{
+				for (std::uint64_t k=0; k<count; ++k)
+				{
+					formatValue(&text[k * value_width], values[2 * k + row]);
+				}
+				if (!simulationWriteAt(fd, text.data(), text.size(), row * row_bytes + first * value_width))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	});
+
+	for (unsigned clock=0; clock<this->config.clocks; ++clock)
+	{
+		for (int fd : {history_fd[clock], truth_fd[clock]})
+		{
+			if (fd >= 0 and ::close(fd) != 0)
+			{
+				ok = false;
+			}
+		}
+	}
+	if (!ok)
+	{
+		std::cerr << "Error writing the simulated dataset to " << directory << std::endl;
+		return false;
+	}
+
+	/// The sidecars describe the finished text files, their values are simulated again block by block (cheaper than parsing)
+	for (unsigned clock=0; clock<this->config.clocks and ok and binary; ++clock)
+	{
+		const std::string path = this->clockDirectory(directory, clock) + "/";
+		for (int file=0; file<2 and ok; ++file)
+		{
+			const std::string text_name = path + (file == 0 ? "measurement_history.txt" : "truth.txt");
+			cache_source source;
+			ok = inputCache::identify(text_name, source) and inputCache::store(text_name, source, 2, n, [&](const int fd, const std::uint64_t data_offset)
+			{
+				return this->forEachBlock([&](const unsigned c, const std::uint64_t block)
+				{
+					if (c != clock)
+					{
+						return true;
+					}
+					const std::uint64_t first = block * block_epochs;
+					const std::uint64_t count = std::min(block_epochs, n - first);
+					std::vector<double> truth(2 * count), measurements(2 * count);
+					this->simulateBlock(clock, block, 0, count, this->block_start[clock][block], truth.data(), measurements.data());
+					const std::vector<double>& values = file == 0 ? measurements : truth;
+					return simulationWriteAt(fd, reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double),
+						data_offset + first * 2 * sizeof(double));
+				});
+			});
+		}
+	}
+	if (!ok)
+	{
+		std::cerr << "Error writing the binary sidecars to " << directory << std::endl;
+	}
+	return ok;
+}
+
+/// The four model files of filter_input, each checked against the size of the model
+bool clockSimulator::readModel(const std::string directory, simulation_config& config)
+{
+	twoStateClockModel model(false, 1);
+	model.setInputDir(directory);
+	model.setInputCache(false);
+
+	const std::string file_names[4] = {"initial_state_estimate.txt", "initial_state_estimate_covariance.txt", "process_noise_covariance.txt",
+		"measurement_noise_covariance.txt"};
+	mat values[4];
+	for (int file=0; file<4; ++file)
+	{
+		model.getInputData(file_names[file], values[file]);
+		if (values[file].rows() != 2 or values[file].cols() != (file == 0 ? 1 : 2) or !values[file].allFinite())
+		{
+			std::cerr << "Error reading a 2x" << (file == 0 ? 1 : 2) << " matrix from " << directory << "/" << file_names[file] << std::endl;
+			return false;
+		}
+	}
+	config.initial_state = values[0];
+	config.initial_covariance = values[1];
+	config.process_noise_covariance = values[2];
+	config.measurement_noise_covariance = values[3];
+	return true;
+}
+
+bool clockSimulator::parseOption(const int argc, char** argv, int& i, simulation_config& config)
+{
+	const std::string arg = argv[i];
+	if (i+1 >= argc)
+	{
+		return false;
+	}
+	if (arg == "--epochs")
+	{
+		config.epochs = std::strtoull(argv[++i], NULL, 10);
+	}
+	else if (arg == "--seed")
+	{
+		config.seed = std::strtoull(argv[++i], NULL, 10);
+	}
+	else if (arg == "--dt")
+	{
+		config.dt = std::atof(argv[++i]);
+	}
+	else if (arg == "--dropouts")
+	{
+		config.dropout_rate = std::atof(argv[++i]);
+	}
+	else if (arg == "--outliers")
+	{
+		config.outlier_rate = std::atof(argv[++i]);
+	}
+	else if (arg == "--outlier-scale")
+	{
+		config.outlier_scale = std::atof(argv[++i]);
+	}
+	else if (arg == "--jumps")
+	{
+		config.jump_rate = std::atof(argv[++i]);
+	}
+	else if (arg == "--jump-size")
+	{
+		config.jump_sigma = std::atof(argv[++i]);
+	}
+	else if (arg == "--threads")
+	{
+		config.threads = std::atoi(argv[++i]);
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,154 @@
+#ifndef CLOCK_SIMULATOR_H
+#define CLOCK_SIMULATOR_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+/// Eigen includes
+#include <Eigen/Dense>
+
+/**
+ * @file clockSimulator.h
+ * @brief contains the declaration of the synthetic dataset generator, simulating the two-state clock model with its ground truth
+ */
+
+/**
+ * @brief simulation_config struct holds the parameters of a simulated dataset
+ * - the truth follows the model of twoStateClockModel::f, x(k+1) = [1 dt; 0 1] x(k) + w(k) with w ~ N(0, process_noise_covariance),
+ *   starting from x(0) ~ N(initial_state, initial_covariance)
+ * - the measurements follow twoStateClockModel::h, y(k) = x(k) + v(k) with v ~ N(0, measurement_noise_covariance)
+ * - dropout_rate: probability of an epoch without measurement, written as nan
+ * - outlier_rate, outlier_scale: probability of a measurement whose noise is outlier_scale times larger
+ * - jump_rate, jump_sigma: probability of a clock bias jump at an epoch, and the standard deviation of the jump in meters
+ */
+struct simulation_config
+{
+	double dt = 1.0;
+	std::uint64_t epochs = 1000;
+	unsigned clocks = 1;
+	std::uint64_t seed = 1;
+	double dropout_rate = 0.0;
+	double outlier_rate = 0.0;
+	double outlier_scale = 20.0;
+	double jump_rate = 0.0;
+	double jump_sigma = 0.0;
+	Eigen::Vector2d initial_state = Eigen::Vector2d::Zero();
+	Eigen::Matrix2d initial_covariance = Eigen::Matrix2d::Identity();
+	Eigen::Matrix2d process_noise_covariance = Eigen::Matrix2d::Identity();
+	Eigen::Matrix2d measurement_noise_covariance = Eigen::Matrix2d::Identity();
+	/// Threads used to simulate and write, 0 uses all hardware threads
+	unsigned threads = 0;
+};
+
+/**
+ * @brief The clockSimulator class generates datasets of any length in the filter_input layout. The epochs are split into fixed
+ * blocks with a random stream of their own, seeded from the seed, the clock and the block, so the same seed gives the same
+ * dataset whatever the number of threads. The model is linear, so the state at the start of every block is found from the effect
+ * of each block on a zero state (a parallel pass) chained over the blocks; every block is then simulated and written on its own,
+ * straight to its offset in the fixed-width text files, without holding the dataset in memory.
+ */
+class clockSimulator
+{
+private:
+	simulation_config config;
+
+	/// Truth state at the start of every block of every clock, [clock][block]
+	std::vector<std::vector<Eigen::Vector2d> > block_start;
+
+	/// Cholesky factors of the noise covariances
+	Eigen::Matrix2d process_factor;
+	Eigen::Matrix2d measurement_factor;
+	Eigen::Matrix2d initial_factor;
+
+	/**
+	 * @brief simulateBlock simulate the epochs [begin, end) of a block, from the given state at the start of the block
+	 * @param clock the clock simulated
+	 * @param block index of the block holding the epochs
+	 * @param begin first epoch, counted from the start of the block
+	 * @param end one past the last epoch, counted from the start of the block
+	 * @param start truth state before the first epoch of the block
+	 * @param truth holds the truth, one column per epoch, NULL to only return the final state
+	 * @param measurements holds the measurements, one column per epoch, NULL to only return the final state
+	 * @return truth state after the last epoch simulated
+	 */
+	Eigen::Vector2d simulateBlock(const unsigned clock, const std::uint64_t block, const std::uint64_t begin, const std::uint64_t end,
+		const Eigen::Vector2d start, double* truth, double* measurements) const;
+
+	/**
+	 * @brief forEachBlock run the job on every block of every clock, spread over the threads
+	 * @return boolean value, false if any job failed
+	 */
+	bool forEachBlock(const std::function<bool(const unsigned clock, const std::uint64_t block)>& job) const;
+
+public:
+	/// Epochs per block, part of the dataset definition: changing it changes the random streams
+	static const std::uint64_t block_epochs = 65536;
+
+	/// Characters per value in the text files, right-aligned like the files of filter_input
+	static const std::size_t value_width = 25;
+
+	/**
+	 * @brief clockSimulator class constructor, finds the state at the start of every block
+	 * @param config the parameters of the dataset
+	 */
+	explicit clockSimulator(const simulation_config& config);
+
+	/**
+	 * @brief simulate the epochs [first, first + count) of a clock in memory
+	 * @param clock the clock simulated
+	 * @param first first epoch
+	 * @param count number of epochs
+	 * @param truth holds the truth, 2 x count: clock bias and clock rate after each epoch
+	 * @param measurements holds the measurements, 2 x count, nan columns for dropouts
+	 * @return boolean value, false if the epochs are outside the dataset
+	 */
+	bool simulate(const unsigned clock, const std::uint64_t first, const std::uint64_t count, Eigen::MatrixXd& truth,
+		Eigen::MatrixXd& measurements) const;
+
+	/**
+	 * @brief write the dataset in the filter_input layout: initial_state_estimate.txt, initial_state_estimate_covariance.txt,
+	 * process_noise_covariance.txt, measurement_noise_covariance.txt, measurement_history.txt and truth.txt; in the directory
+	 * itself for one clock, in its clock_<n> subdirectories for more
+	 * @param directory the output directory, created if missing
+	 * @param binary also write the parsed-input cache sidecars of the histories, so ekf maps them in instead of parsing the text
+	 * @return boolean value
+	 */
+	bool write(const std::string directory, const bool binary) const;
+
+	/**
+	 * @brief clockDirectory directory holding the files of a clock
+	 */
+	std::string clockDirectory(const std::string directory, const unsigned clock) const;
+
+	/**
+	 * @brief readModel read the initial state, its covariance, Q and R of the dataset from the filter input files of a directory,
+	 * with twoStateClockModel::getInputData as ekf reads them
+	 * @param directory the directory, such as ../filter_input
+	 * @param config holds the model read, its other parameters are left as they are
+	 * @return boolean value, false if a file is missing or does not hold a matrix of the size of the model
+	 */
+	static bool readModel(const std::string directory, simulation_config& config);
+
+	/**
+	 * @brief parseOption read an option of the dataset from the command line of a tool: --epochs, --seed, --dt, --dropouts,
+	 * --outliers, --outlier-scale, --jumps, --jump-size or --threads, each followed by its value
+	 * @param argc number of arguments
+	 * @param argv the arguments
+	 * @param i index of the option, moved to its value when it is one of them
+	 * @param config holds the value read
+	 * @return boolean value, false if argv[i] is not one of these options or has no value
+	 */
+	static bool parseOption(const int argc, char** argv, int& i, simulation_config& config);
+
+	/**
+	 * @brief formatValue right-align a value in value_width characters, nan for dropouts
+	 * @param first beginning of the output range, must have room for value_width characters
+	 * @param value the value to write
+	 */
+	static void formatValue(char* first, const double value);
+};
+
+#endif // CLOCK_SIMULATOR_H
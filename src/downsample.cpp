@@ -0,0 +1,301 @@
+#include "downsample.h"
+
+/// Std includes
+#include <cmath>
+#include <algorithm>
+#include <numeric> // std::iota
+
+/// SSE2 is part of every x86-64 target, other targets use the scalar loop
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @file downsample.cpp
+ * @brief contains all the downsample member function definitions declared in .h file
+ */
+
+/// Min and max over the bucket, NaN values are skipped: the SSE2 min/max return their second operand when either is NaN
+bool downsample::bucketMinMax(const double* y, const std::ptrdiff_t stride, const std::size_t begin, const std::size_t end, double& min_value, double& max_value)
+{
+	const double inf = std::numeric_limits<double>::infinity();
+	std::size_t i = begin;
+	bool has_gap = false;
+	min_value = inf;
+	max_value = -inf;
+#if defined(__SSE2__)
+	if (stride == 1 and end - begin >= 8)
+	{
+		__m128d lo_a = _mm_set1_pd(inf), lo_b = _mm_set1_pd(inf);
+		__m128d hi_a = _mm_set1_pd(-inf), hi_b = _mm_set1_pd(-inf);
+		__m128d nan = _mm_setzero_pd();
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128d a = _mm_loadu_pd(y + i);
+			__m128d b = _mm_loadu_pd(y + i + 2);
+			lo_a = _mm_min_pd(a, lo_a);
+			lo_b = _mm_min_pd(b, lo_b);
+			hi_a = _mm_max_pd(a, hi_a);
+			hi_b = _mm_max_pd(b, hi_b);
+			nan = _mm_or_pd(nan, _mm_cmpunord_pd(a, b));
+		}
+		double lo[2], hi[2];
+		_mm_storeu_pd(lo, _mm_min_pd(lo_a, lo_b));
+		_mm_storeu_pd(hi, _mm_max_pd(hi_a, hi_b));
+		min_value = std::min(lo[0], lo[1]);
+		max_value = std::max(hi[0], hi[1]);
+		has_gap = _mm_movemask_pd(nan) != 0;
+	}
+#endif
+	for (; i < end; ++i)
+	{
+		/// Comparisons with NaN are false, so NaN never replaces a value
+		double value = y[i * stride];
+		if (value < min_value)
+		{
+			min_value = value;
+		}
+		if (value > max_value)
+		{
+			max_value = value;
+		}
+		if (std::isnan(value))
+		{
+			has_gap = true;
+		}
+	}
+	/// Infinite values are not plotted either, they are gaps like NaN
+	if (std::isinf(min_value) and min_value < 0.0)
+	{
+		has_gap = true;
+		min_value = inf;
+		for (std::size_t k=begin; k<end; ++k)
+		{
+			if (std::isfinite(y[k * stride]))
+			{
+				min_value = std::min(min_value, y[k * stride]);
+			}
+		}
+	}
+	if (std::isinf(max_value) and max_value > 0.0)
+	{
+		has_gap = true;
+		max_value = -inf;
+		for (std::size_t k=begin; k<end; ++k)
+		{
+			if (std::isfinite(y[k * stride]))
+			{
+				max_value = std::max(max_value, y[k * stride]);
+			}
+		}
+	}
+	return has_gap;
+}
+
+/// Linear search for the value found by bucketMinMax, or for the first non-finite value
+std::size_t downsample::firstIndex(const double* y, const std::ptrdiff_t stride, const std::size_t begin, const std::size_t end, const double value)
+{
+	for (std::size_t i=begin; i<end; ++i)
+	{
+		if (std::isnan(value) ? !std::isfinite(y[i * stride]) : y[i * stride] == value)
+		{
+			return i;
+		}
+	}
+	return end;
+}
+
+/// Steinarsson's LTTB: in every bucket keep the point making the largest triangle with the previously kept point and the mean of the next bucket
+void downsample::lttb(const double* x, const double* y, const std::size_t n, const std::size_t target, std::vector<std::size_t>& indices, const double threshold)
+{
+	lttb(x, y, 1, n, target, indices, threshold);
+}
+
+/// Without x values the sample index is the x value
+void downsample::lttb(const double* x, const double* y, const std::ptrdiff_t stride, const std::size_t n, const std::size_t target,
+	std::vector<std::size_t>& indices, const double threshold)
+{
+	auto xAt = [x](const std::size_t j)
+	{
+		return x != NULL ? x[j] : static_cast<double>(j);
+	};
+	auto yAt = [y, stride](const std::size_t j)
+	{
+		return y[j * stride];
+	};
+
+	indices.clear();
+	if (target >= n or target < 3)
+	{
+		for (std::size_t i=0; i<n; ++i)
+		{
+			indices.push_back(i);
+		}
+		return;
+	}
+
+	const double every = static_cast<double>(n - 2) / (target - 2);
+	indices.reserve(target + target / 8);
+	indices.push_back(0);
+	std::size_t a = 0;
+
+	for (std::size_t bucket=0; bucket<target-2; ++bucket)
+	{
+		std::size_t begin = static_cast<std::size_t>(bucket * every) + 1;
+		std::size_t end = std::min(static_cast<std::size_t>((bucket + 1) * every) + 1, n - 1);
+
+		/// Mean of the next bucket, the last bucket looks at the last sample
+		std::size_t next_begin = end;
+		std::size_t next_end = std::min(static_cast<std::size_t>((bucket + 2) * every) + 1, n);
+		double mean_x = 0.0, mean_y = 0.0;
+		std::size_t count = 0;
+		for (std::size_t j=next_begin; j<next_end; ++j)
+		{
+			if (std::isfinite(xAt(j)) and std::isfinite(yAt(j)))
+			{
+				mean_x += xAt(j);
+				mean_y += yAt(j);
+				count++;
+			}
+		}
+		if (count > 0)
+		{
+			mean_x /= count;
+			mean_y /= count;
+		}
+		else
+		{
+			mean_x = xAt(n - 1);
+			mean_y = yAt(n - 1);
+		}
+
+		std::size_t chosen = end;
+		std::size_t gap = end;
+		double largest = -1.0;
+		for (std::size_t j=begin; j<end; ++j)
+		{
+			if (!std::isfinite(xAt(j)) or !std::isfinite(yAt(j)))
+			{
+				gap = std::min(gap, j);
+				continue;
+			}
+			double area = std::fabs((xAt(a) - mean_x) * (yAt(j) - yAt(a)) - (xAt(a) - xAt(j)) * (mean_y - yAt(a)));
+			if (area > largest)
+			{
+				largest = area;
+				chosen = j;
+			}
+		}
+
+		/// A spike above the threshold wins over the triangle area
+		if (std::isfinite(threshold))
+		{
+			double min_value, max_value;
+			bucketMinMax(y, stride, begin, end, min_value, max_value);
+			if (max_value > threshold)
+			{
+				chosen = firstIndex(y, stride, begin, end, max_value);
+			}
+		}
+
+		/// Keep the first gap of the bucket, in index order with the chosen point
+		if (gap < chosen)
+		{
+			indices.push_back(gap);
+		}
+		if (chosen < end)
+		{
+			indices.push_back(chosen);
+			a = chosen;
+		}
+		if (gap > chosen and gap < end)
+		{
+			indices.push_back(gap);
+		}
+	}
+	indices.push_back(n - 1);
+}
+
+/// Every bucket keeps its smallest and largest value in index order, which is what a pixel column of the plot shows
+void downsample::minMax(const double* y, const std::size_t n, const std::size_t target, std::vector<std::size_t>& indices)
+{
+	minMax(y, 1, n, target, indices);
+}
+
+void downsample::minMax(const double* y, const std::ptrdiff_t stride, const std::size_t n, const std::size_t target, std::vector<std::size_t>& indices)
+{
+	indices.clear();
+	const std::size_t buckets = target / 2;
+	if (target >= n or buckets < 1)
+	{
+		for (std::size_t i=0; i<n; ++i)
+		{
+			indices.push_back(i);
+		}
+		return;
+	}
+
+	indices.reserve(target + 2);
+	indices.push_back(0);
+	for (std::size_t bucket=0; bucket<buckets; ++bucket)
+	{
+		std::size_t begin = bucket * n / buckets;
+		std::size_t end = (bucket + 1) * n / buckets;
+
+		double min_value, max_value;
+		bool has_gap = bucketMinMax(y, stride, begin, end, min_value, max_value);
+
+		std::size_t kept[3] = {end, end, has_gap ? firstIndex(y, stride, begin, end, NAN) : end};
+		if (std::isfinite(min_value))
+		{
+			kept[0] = firstIndex(y, stride, begin, end, min_value);
+			kept[1] = firstIndex(y, stride, begin, end, max_value);
+		}
+		std::sort(kept, kept + 3);
+		for (std::size_t k=0; k<3; ++k)
+		{
+			if (kept[k] < end and kept[k] > indices.back())
+			{
+				indices.push_back(kept[k]);
+			}
+		}
+	}
+	if (indices.back() != n - 1)
+	{
+		indices.push_back(n - 1);
+	}
+}
+
+void downsample::select(const decimation_method method, const std::vector<double>& x, const std::vector<double>& y, const std::size_t target,
+	std::vector<std::size_t>& indices, const double threshold)
+{
+	const std::size_t n = std::min(x.size(), y.size());
+	switch (method)
+	{
+		case decimation_method::lttb:
+			lttb(x.data(), y.data(), n, target, indices, threshold);
+			break;
+		case decimation_method::min_max:
+			minMax(y.data(), n, target, indices);
+			break;
+		default:
+			indices.resize(n);
+			std::iota(indices.begin(), indices.end(), 0);
+			break;
+	}
+}
+
+std::vector<double> downsample::gather(const std::vector<double>& values, const std::vector<std::size_t>& indices)
+{
+	return gather(values.data(), 1, indices);
+}
+
+std::vector<double> downsample::gather(const double* values, const std::ptrdiff_t stride, const std::vector<std::size_t>& indices)
+{
+	std::vector<double> kept(indices.size());
+	for (std::size_t i=0; i<indices.size(); ++i)
+	{
+		kept[i] = values[indices[i] * stride];
+	}
+	return kept;
+}
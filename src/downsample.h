@@ -0,0 +1,129 @@
+#ifndef DOWNSAMPLE_H
+#define DOWNSAMPLE_H
+
+/// Std includes
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+/**
+ * @file downsample.h
+ * @brief contains the declaration of the decimation applied to long series before they are plotted
+ */
+
+/**
+ * @brief decimation_method selects how a long series is reduced to the plotted points
+ * - none: every sample is plotted
+ * - lttb: Largest-Triangle-Three-Buckets, one point per bucket chosen to keep the visual shape of the line
+ * - min_max: the smallest and the largest sample of every bucket, the exact envelope of the line at pixel resolution
+ */
+enum class decimation_method
+{
+	none,
+	lttb,
+	min_max
+};
+
+/**
+ * @brief The downsample class reduces a series to about a target number of points in a single O(N) pass.
+ * Both methods return the indices of the kept samples, in increasing order, so the same selection can be applied to
+ * other series of the same epochs. The first and last samples are always kept, and a bucket holding a non-finite
+ * value keeps one of them so gaps (dropouts) stay visible in the plot.
+ */
+class downsample
+{
+private:
+	/**
+	 * @brief bucketMinMax smallest and largest finite value of y[begin, end), vectorized with SSE2 for contiguous values where available
+	 * @param y the values
+	 * @param stride distance between consecutive values, in values
+	 * @param begin first index of the bucket
+	 * @param end one past the last index of the bucket
+	 * @param min_value holds the smallest value, +infinity if the bucket has no finite value
+	 * @param max_value holds the largest value, -infinity if the bucket has no finite value
+	 * @return boolean value, true if the bucket holds a non-finite value
+	 */
+	static bool bucketMinMax(const double* y, const std::ptrdiff_t stride, const std::size_t begin, const std::size_t end, double& min_value, double& max_value);
+
+	/**
+	 * @brief firstIndex first index of y[begin, end) holding the value, a NaN value looks for the first non-finite value
+	 * @return the index, end if not found
+	 */
+	static std::size_t firstIndex(const double* y, const std::ptrdiff_t stride, const std::size_t begin, const std::size_t end, const double value);
+
+public:
+	/**
+	 * @brief lttb Largest-Triangle-Three-Buckets selection of about target points
+	 * @param x values along the x axis, increasing
+	 * @param y values along the y axis
+	 * @param n number of samples
+	 * @param target number of points to keep, all samples are kept when n is not larger
+	 * @param indices holds the indices of the kept samples
+	 * @param threshold a bucket with a value above it keeps its largest value instead of the LTTB choice, so spikes survive
+	 */
+	static void lttb(const double* x, const double* y, const std::size_t n, const std::size_t target, std::vector<std::size_t>& indices,
+		const double threshold = std::numeric_limits<double>::infinity());
+
+	/**
+	 * @brief lttb Largest-Triangle-Three-Buckets selection of strided values, such as a row of a column-major Eigen matrix
+	 * @param x values along the x axis, increasing; NULL for evenly spaced samples (the triangle areas only scale with the spacing)
+	 * @param y values along the y axis
+	 * @param stride distance between consecutive y values, in values
+	 * @param n number of samples
+	 * @param target number of points to keep, all samples are kept when n is not larger
+	 * @param indices holds the indices of the kept samples
+	 * @param threshold a bucket with a value above it keeps its largest value instead of the LTTB choice, so spikes survive
+	 */
+	static void lttb(const double* x, const double* y, const std::ptrdiff_t stride, const std::size_t n, const std::size_t target,
+		std::vector<std::size_t>& indices, const double threshold = std::numeric_limits<double>::infinity());
+
+	/**
+	 * @brief minMax smallest and largest sample of each of target/2 buckets of equal length
+	 * @param y the values
+	 * @param n number of samples
+	 * @param target number of points to keep, all samples are kept when n is not larger
+	 * @param indices holds the indices of the kept samples
+	 */
+	static void minMax(const double* y, const std::size_t n, const std::size_t target, std::vector<std::size_t>& indices);
+
+	/**
+	 * @brief minMax smallest and largest sample of each of target/2 buckets of equal length, for strided values
+	 * @param y the values
+	 * @param stride distance between consecutive values, in values
+	 * @param n number of samples
+	 * @param target number of points to keep, all samples are kept when n is not larger
+	 * @param indices holds the indices of the kept samples
+	 */
+	static void minMax(const double* y, const std::ptrdiff_t stride, const std::size_t n, const std::size_t target, std::vector<std::size_t>& indices);
+
+	/**
+	 * @brief select decimate a series with the given method
+	 * @param method the decimation method
+	 * @param x values along the x axis, increasing
+	 * @param y values along the y axis, same length as x
+	 * @param target number of points to keep
+	 * @param indices holds the indices of the kept samples
+	 * @param threshold values above it are kept by lttb (min_max keeps every bucket maximum anyway)
+	 */
+	static void select(const decimation_method method, const std::vector<double>& x, const std::vector<double>& y, const std::size_t target,
+		std::vector<std::size_t>& indices, const double threshold = std::numeric_limits<double>::infinity());
+
+	/**
+	 * @brief gather the values at the given indices
+	 * @param values the full series
+	 * @param indices indices returned by lttb, minMax or select
+	 * @return the kept values
+	 */
+	static std::vector<double> gather(const std::vector<double>& values, const std::vector<std::size_t>& indices);
+
+	/**
+	 * @brief gather the strided values at the given indices
+	 * @param values the full series
+	 * @param stride distance between consecutive values, in values
+	 * @param indices indices returned by lttb, minMax or select
+	 * @return the kept values
+	 */
+	static std::vector<double> gather(const double* values, const std::ptrdiff_t stride, const std::vector<std::size_t>& indices);
+};
+
+#endif // DOWNSAMPLE_H
@@ -0,0 +1,373 @@
+#include "filterStats.h"
+
+/// Std includes
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/**
+ * @file filterStats.cpp
+ * @brief contains all the p2Quantile and filterStats member function definitions declared in .h file
+ */
+
+/// Regularized lower incomplete gamma function P(a, x): the series converges fast below a + 1, the continued fraction of
+/// Q = 1 - P (modified Lentz) above it
+static double regularizedGammaP(const double a, const double x)
+{
+	if (!(x > 0.0))
+	{
+		return 0.0;
+	}
+	if (std::isinf(x))
+	{
+		return 1.0;
+	}
+	const double eps = 1.0e-15;
+	const double tiny = 1.0e-300;
+	const double front = std::exp(-x + a * std::log(x) - std::lgamma(a));
+	if (x < a + 1.0)
+	{
+		double ap = a;
+		double term = 1.0 / a;
+		double sum = term;
+		for (int i=0; i<1000; ++i)
+		{
+			ap += 1.0;
+			term *= x / ap;
+			sum += term;
+			if (std::fabs(term) < std::fabs(sum) * eps)
+			{
+				break;
+			}
+		}
+		return std::min(1.0, sum * front);
+	}
+
+	double b = x + 1.0 - a;
+	double c = 1.0 / tiny;
+	double d = 1.0 / b;
+	double h = d;
+	for (int i=1; i<1000; ++i)
+	{
+		double an = -i * (i - a);
+		b += 2.0;
+		d = an * d + b;
+		d = std::fabs(d) < tiny ? tiny : d;
+		c = b + an / c;
+		c = std::fabs(c) < tiny ? tiny : c;
+		d = 1.0 / d;
+		double delta = d * c;
+		h *= delta;
+		if (std::fabs(delta - 1.0) < eps)
+		{
+			break;
+		}
+	}
+	return std::max(0.0, 1.0 - front * h);
+}
+
+/// Chi-square probability density
+static double chiSquarePdf(const double x, const unsigned dof)
+{
+	if (!(x > 0.0))
+	{
+		return 0.0;
+	}
+	const double k = 0.5 * dof;
+	return std::exp((k - 1.0) * std::log(x) - 0.5 * x - k * std::log(2.0) - std::lgamma(k));
+}
+
+/// class constructor
+p2Quantile::p2Quantile(const double p)
+	: p(p), count(0)
+{
+	for (int i=0; i<5; ++i)
+	{
+		this->heights[i] = 0.0;
+		this->positions[i] = i + 1.0;
+	}
+	this->desired[0] = 1.0;
+	this->desired[1] = 1.0 + 2.0 * p;
+	this->desired[2] = 1.0 + 4.0 * p;
+	this->desired[3] = 3.0 + 2.0 * p;
+	this->desired[4] = 5.0;
+	this->increments[0] = 0.0;
+	this->increments[1] = 0.5 * p;
+	this->increments[2] = p;
+	this->increments[3] = 0.5 * (1.0 + p);
+	this->increments[4] = 1.0;
+}
+
+/// The first five values are kept sorted, every later one moves the markers by at most one position each
+void p2Quantile::add(const double value)
+{
+	if (this->count < 5)
+	{
+		this->heights[this->count++] = value;
+		std::sort(this->heights, this->heights + this->count);
+		return;
+	}
+	this->count++;
+
+	/// Cell of the value, the extreme markers follow the smallest and largest values
+	int k;
+	if (value < this->heights[0])
+	{
+		this->heights[0] = value;
+		k = 0;
+	}
+	else if (value >= this->heights[4])
+	{
+		this->heights[4] = value;
+		k = 3;
+	}
+	else
+	{
+		k = 0;
+		while (value >= this->heights[k + 1])
+		{
+			k++;
+		}
+	}
+	for (int i=k+1; i<5; ++i)
+	{
+		this->positions[i] += 1.0;
+	}
+	for (int i=0; i<5; ++i)
+	{
+		this->desired[i] += this->increments[i];
+	}
+
+	/// The middle markers off their desired position by one or more are moved, parabolic when it keeps them ordered, else linear
+	double* q = this->heights;
+	double* n = this->positions;
+	for (int i=1; i<4; ++i)
+	{
+		double d = this->desired[i] - n[i];
+		if ((d >= 1.0 and n[i + 1] - n[i] > 1.0) or (d <= -1.0 and n[i - 1] - n[i] < -1.0))
+		{
+			const double s = d > 0.0 ? 1.0 : -1.0;
+			double parabolic = q[i] + s / (n[i + 1] - n[i - 1]) *
+				((n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) + (n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+			if (q[i - 1] < parabolic and parabolic < q[i + 1])
+			{
+				q[i] = parabolic;
+			}
+			else
+			{
+				const int j = i + static_cast<int>(s);
+				q[i] += s * (q[j] - q[i]) / (n[j] - n[i]);
+			}
+			n[i] += s;
+		}
+	}
+}
+
+/// Linear interpolation of the sorted values while there are fewer than five, the middle marker after
+double p2Quantile::value() const
+{
+	if (this->count == 0)
+	{
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	if (this->count < 5)
+	{
+		double position = this->p * (this->count - 1);
+		std::size_t below = static_cast<std::size_t>(position);
+		std::size_t above = std::min<std::size_t>(below + 1, this->count - 1);
+		return this->heights[below] + (position - below) * (this->heights[above] - this->heights[below]);
+	}
+	return this->heights[2];
+}
+
+/// class constructor, the bounds are evaluated once
+filterStats::filterStats(const unsigned dof, const double alpha, const std::size_t window)
+	: lower(chiSquareInv(0.5 * alpha, dof)), upper(chiSquareInv(1.0 - 0.5 * alpha, dof)),
+	  window_size(std::max<std::size_t>(window, 1)), median(0.5), quantile_95(0.95)
+{
+	this->reset();
+}
+
+void filterStats::reset()
+{
+	this->finite_count = 0;
+	this->dropout_count = 0;
+	this->below_count = 0;
+	this->above_count = 0;
+	this->running_mean = 0.0;
+	this->running_m2 = 0.0;
+	this->ring.clear();
+	this->ring.reserve(this->window_size);
+	this->window_next = 0;
+	this->window_sum = 0.0;
+	this->window_outside = 0;
+	this->median = p2Quantile(0.5);
+	this->quantile_95 = p2Quantile(0.95);
+}
+
+bool filterStats::isOutside(const double value) const
+{
+	return value < this->lower or value > this->upper;
+}
+
+/// Welford update of the running moments, the oldest value of the window is swapped for the new one
+void filterStats::add(const double value)
+{
+	if (!std::isfinite(value))
+	{
+		this->dropout_count++;
+		return;
+	}
+	this->finite_count++;
+	const double delta = value - this->running_mean;
+	this->running_mean += delta / this->finite_count;
+	this->running_m2 += delta * (value - this->running_mean);
+	this->below_count += value < this->lower;
+	this->above_count += value > this->upper;
+
+	if (this->ring.size() < this->window_size)
+	{
+		this->ring.push_back(value);
+	}
+	else
+	{
+		const double oldest = this->ring[this->window_next];
+		this->window_sum -= oldest;
+		this->window_outside -= this->isOutside(oldest);
+		this->ring[this->window_next] = value;
+		this->window_next = (this->window_next + 1) % this->window_size;
+	}
+	this->window_sum += value;
+	this->window_outside += this->isOutside(value);
+
+	/// The rounding of the running sum is reset once per window, an O(1) cost per epoch on average
+	if (this->window_next == 0 and this->ring.size() == this->window_size)
+	{
+		this->window_sum = 0.0;
+		for (double v : this->ring)
+		{
+			this->window_sum += v;
+		}
+	}
+
+	this->median.add(value);
+	this->quantile_95.add(value);
+}
+
+std::uint64_t filterStats::count() const
+{
+	return this->finite_count;
+}
+
+double filterStats::mean() const
+{
+	return this->finite_count > 0 ? this->running_mean : std::numeric_limits<double>::quiet_NaN();
+}
+
+double filterStats::variance() const
+{
+	return this->finite_count > 1 ? this->running_m2 / (this->finite_count - 1) : std::numeric_limits<double>::quiet_NaN();
+}
+
+std::size_t filterStats::windowCount() const
+{
+	return this->ring.size();
+}
+
+double filterStats::windowMean() const
+{
+	return this->ring.empty() ? std::numeric_limits<double>::quiet_NaN() : this->window_sum / this->ring.size();
+}
+
+double filterStats::lowerBound() const
+{
+	return this->lower;
+}
+
+double filterStats::upperBound() const
+{
+	return this->upper;
+}
+
+double filterStats::fractionOutside() const
+{
+	return this->finite_count > 0 ? static_cast<double>(this->below_count + this->above_count) / this->finite_count : 0.0;
+}
+
+double filterStats::windowFractionOutside() const
+{
+	return this->ring.empty() ? 0.0 : static_cast<double>(this->window_outside) / this->ring.size();
+}
+
+nis_summary filterStats::summary() const
+{
+	nis_summary s;
+	s.count = this->finite_count;
+	s.dropouts = this->dropout_count;
+	s.mean = this->mean();
+	s.variance = this->variance();
+	s.window_mean = this->windowMean();
+	s.lower_bound = this->lower;
+	s.upper_bound = this->upper;
+	s.fraction_below = this->finite_count > 0 ? static_cast<double>(this->below_count) / this->finite_count : 0.0;
+	s.fraction_above = this->finite_count > 0 ? static_cast<double>(this->above_count) / this->finite_count : 0.0;
+	s.window_fraction_outside = this->windowFractionOutside();
+	s.median = this->median.value();
+	s.quantile_95 = this->quantile_95.value();
+	return s;
+}
+
+double filterStats::chiSquareCdf(const double x, const unsigned dof)
+{
+	if (dof == 0)
+	{
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	return regularizedGammaP(0.5 * dof, 0.5 * x);
+}
+
+/// Newton steps on the CDF, kept inside a bracket of the root and bisected whenever a step leaves it
+double filterStats::chiSquareInv(const double probability, const unsigned dof)
+{
+	if (dof == 0 or !(probability >= 0.0) or !(probability < 1.0))
+	{
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	if (probability == 0.0)
+	{
+		return 0.0;
+	}
+
+	double lo = 0.0;
+	double hi = std::max(1.0, static_cast<double>(dof));
+	while (chiSquareCdf(hi, dof) < probability)
+	{
+		lo = hi;
+		hi *= 2.0;
+	}
+	double x = 0.5 * (lo + hi);
+	for (int i=0; i<200; ++i)
+	{
+		const double error = chiSquareCdf(x, dof) - probability;
+		if (error < 0.0)
+		{
+			lo = x;
+		}
+		else
+		{
+			hi = x;
+		}
+		const double pdf = chiSquarePdf(x, dof);
+		double next = pdf > 0.0 ? x - error / pdf : 0.5 * (lo + hi);
+		if (!(next > lo and next < hi))
+		{
+			next = 0.5 * (lo + hi);
+		}
+		if (std::fabs(next - x) <= 1.0e-14 * x or hi - lo <= 1.0e-14 * hi)
+		{
+			return next;
+		}
+		x = next;
+	}
+	return x;
+}
@@ -0,0 +1,190 @@
+#ifndef FILTER_STATS_H
+#define FILTER_STATS_H
+
+/// Std includes
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file filterStats.h
+ * @brief contains the declaration of the streaming filter consistency statistics, fed one NIS (or NEES) value per epoch
+ */
+
+/**
+ * @brief nis_summary struct holds a snapshot of the consistency statistics
+ * - fractions are of the finite values seen, the window ones of the finite values in the window
+ */
+struct nis_summary
+{
+	std::uint64_t count;        /// finite values seen
+	std::uint64_t dropouts;     /// non-finite values skipped
+	double mean;
+	double variance;
+	double window_mean;
+	double lower_bound;         /// chi-square inverse CDF at alpha/2
+	double upper_bound;         /// chi-square inverse CDF at 1 - alpha/2
+	double fraction_below;
+	double fraction_above;
+	double window_fraction_outside;
+	double median;
+	double quantile_95;
+};
+
+/**
+ * @brief The p2Quantile class estimates one quantile of a stream with the P-square algorithm (Jain and Chlamtac): five markers
+ * are kept and moved with a piecewise-parabolic fit, so every value costs O(1) time and the memory does not grow with the stream.
+ */
+class p2Quantile
+{
+private:
+	double p;
+	std::uint64_t count;
+	double heights[5];
+	double positions[5];
+	double desired[5];
+	double increments[5];
+
+public:
+	/**
+	 * @brief p2Quantile class constructor
+	 * @param p the quantile estimated, in (0, 1)
+	 */
+	explicit p2Quantile(const double p);
+
+	/**
+	 * @brief add one value to the stream
+	 */
+	void add(const double value);
+
+	/**
+	 * @brief value the current estimate, exact while fewer than five values are seen; NaN before the first value
+	 */
+	double value() const;
+};
+
+/**
+ * @brief The filterStats class accumulates the filter consistency statistics epoch by epoch, at O(1) cost per epoch and with
+ * memory bounded by the window length, so the results can be read at any point of a run:
+ * - running mean and variance (Welford) and the mean over the last window epochs
+ * - fraction of the values below and above the two-sided chi-square bounds for the given degrees of freedom and alpha, in
+ *   total and over the window; the bounds are evaluated from the chi-square inverse CDF when constructed
+ * - median and 95th percentile (P-square estimators)
+ * For a consistent filter the NIS is chi-square distributed with as many degrees of freedom as the measurement vector has
+ * elements; the NEES, when the true state is known, with as many as the state. Non-finite values (dropouts) are skipped.
+ */
+class filterStats
+{
+private:
+	/// Chi-square bounds for the degrees of freedom and alpha given
+	double lower;
+	double upper;
+
+	std::uint64_t finite_count;
+	std::uint64_t dropout_count;
+	std::uint64_t below_count;
+	std::uint64_t above_count;
+	double running_mean;
+	double running_m2;
+
+	/// Last window finite values, oldest first at window_next once full; the sum is recomputed every time the ring wraps
+	std::vector<double> ring;
+	std::size_t window_next;
+	std::size_t window_size;
+	double window_sum;
+	std::size_t window_outside;
+
+	p2Quantile median;
+	p2Quantile quantile_95;
+
+	bool isOutside(const double value) const;
+
+public:
+	/**
+	 * @brief filterStats class constructor
+	 * @param dof degrees of freedom of the chi-square distribution, 2 for the NIS of the two-state clock model
+	 * @param alpha total probability outside the bounds, split evenly between both tails
+	 * @param window number of epochs of the windowed mean and fraction
+	 */
+	filterStats(const unsigned dof = 2, const double alpha = 0.05, const std::size_t window = 100);
+
+	/**
+	 * @brief add the value of one epoch
+	 * @param value the NIS or NEES of the epoch, non-finite values are counted as dropouts
+	 */
+	void add(const double value);
+
+	/**
+	 * @brief reset forget every value, the bounds are kept
+	 */
+	void reset();
+
+	/**
+	 * @brief count number of finite values seen
+	 */
+	std::uint64_t count() const;
+
+	/**
+	 * @brief mean of every finite value seen, NaN before the first one
+	 */
+	double mean() const;
+
+	/**
+	 * @brief variance sample variance of every finite value seen, NaN before the second one
+	 */
+	double variance() const;
+
+	/**
+	 * @brief windowCount number of finite values held for the window statistics, never more than the window length
+	 */
+	std::size_t windowCount() const;
+
+	/**
+	 * @brief windowMean mean of the last window finite values, NaN before the first one
+	 */
+	double windowMean() const;
+
+	/**
+	 * @brief lowerBound chi-square inverse CDF at alpha/2
+	 */
+	double lowerBound() const;
+
+	/**
+	 * @brief upperBound chi-square inverse CDF at 1 - alpha/2
+	 */
+	double upperBound() const;
+
+	/**
+	 * @brief fractionOutside fraction of the finite values below the lower or above the upper bound, about alpha when consistent
+	 */
+	double fractionOutside() const;
+
+	/**
+	 * @brief windowFractionOutside fraction of the last window finite values outside the bounds
+	 */
+	double windowFractionOutside() const;
+
+	/**
+	 * @brief summary snapshot of every statistic
+	 * @return nis_summary struct
+	 */
+	nis_summary summary() const;
+
+	/**
+	 * @brief chiSquareCdf chi-square cumulative distribution, the regularized lower incomplete gamma function P(dof/2, x/2)
+	 * @param x the value
+	 * @param dof degrees of freedom
+	 * @return the probability of a value not larger than x
+	 */
+	static double chiSquareCdf(const double x, const unsigned dof);
+
+	/**
+	 * @brief chiSquareInv chi-square inverse cumulative distribution, the value x with chiSquareCdf(x, dof) = probability
+	 * @param probability in [0, 1)
+	 * @param dof degrees of freedom
+	 * @return the value, NaN for an invalid probability or zero degrees of freedom
+	 */
+	static double chiSquareInv(const double probability, const unsigned dof);
+};
+
+#endif // FILTER_STATS_H
@@ -0,0 +1,273 @@
+#include "goldenHarness.h"
+
+/// Std includes
+#include <cmath>
+#include <cstring> // std::memcpy
+#include <limits>
+#include <sstream>
+#include <iomanip> // std::setprecision
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+/**
+ * @file goldenHarness.cpp
+ * @brief contains all the goldenHarness member function definitions declared in .h file
+ */
+
+const int goldenHarness::quantities;
+const std::uint64_t goldenHarness::chunk_epochs;
+
+/// The filter loop of main.cpp, one twoStateClockModel step per epoch
+filter_engine goldenHarness::referenceEngine(const float dt)
+{
+	return [dt](const filter_input& f_in, filter_history& history)
+	{
+		const int n = f_in.measurement_history.cols();
+		history.state.resize(2, n);
+		history.covariance.resize(4, n);
+		history.nis.resize(1, n);
+
+		twoStateClockModel model(true, dt);
+		mat xk_est = f_in.initial_state_estimate;
+		mat xcovk_est = f_in.initial_state_estimate_covariance;
+		mat w_k = mat::Zero(2,1);
+		mat v_kp1 = mat::Zero(2,1);
+		for (int kp1=0; kp1<n; ++kp1)
+		{
+			mat y_kp1 = f_in.measurement_history.col(kp1);
+			model.simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, y_kp1, v_kp1, f_in.measurement_noise_covariance);
+			xk_est = model.get_xkp1();
+			xcovk_est = model.get_xcov_kp1();
+			mat temp = (model.get_zkp1().transpose()) * ((model.get_skp1()).inverse() * model.get_zkp1());
+
+			history.state.col(kp1) = xk_est;
+			history.covariance.col(kp1) = Eigen::Map<const Eigen::Vector4d>(xcovk_est.data());
+			history.nis(0, kp1) = temp(0);
+		}
+	};
+}
+
+/// simpleEKF with f and h written out: x = A x, P = A P A' + Q, S = P + R, Joseph form update
+filter_engine goldenHarness::fixedSizeEngine(const float dt)
+{
+	return [dt](const filter_input& f_in, filter_history& history)
+	{
+		const int n = f_in.measurement_history.cols();
+		history.state.resize(2, n);
+		history.covariance.resize(4, n);
+		history.nis.resize(1, n);
+
+		Eigen::Matrix2d a = Eigen::Matrix2d::Identity();
+		a(0,1) = dt;
+		const Eigen::Matrix2d q = f_in.process_noise_covariance;
+		const Eigen::Matrix2d r = f_in.measurement_noise_covariance;
+		Eigen::Vector2d x = f_in.initial_state_estimate;
+		Eigen::Matrix2d p = f_in.initial_state_estimate_covariance;
+		for (int k=0; k<n; ++k)
+		{
+			const Eigen::Vector2d x_pred = a * x;
+			const Eigen::Matrix2d p_pred = a * p * a.transpose() + q;
+			const Eigen::Matrix2d s = p_pred + r;
+			const Eigen::Matrix2d s_inv = s.inverse();
+			const Eigen::Vector2d z = f_in.measurement_history.col(k) - x_pred;
+			if (!z.allFinite())
+			{
+				x = x_pred;
+				p = p_pred;
+			}
+			else
+			{
+				const Eigen::Matrix2d gain = p_pred * s_inv;
+				const Eigen::Matrix2d imwh = Eigen::Matrix2d::Identity() - gain;
+				x = x_pred + gain * z;
+				p = imwh * p_pred * imwh.transpose() + gain * r * gain.transpose();
+			}
+
+			history.state.col(k) = x;
+			history.covariance.col(k) = Eigen::Map<const Eigen::Vector4d>(p.data());
+			history.nis(0, k) = z.dot(s_inv * z);
+		}
+	};
+}
+
+/// Doubles ordered as unsigned integers: the negative ones are mirrored below the positive ones, -0 and +0 on the same key
+std::uint64_t goldenHarness::ulpDistance(const double a, const double b)
+{
+	if (std::isnan(a) or std::isnan(b))
+	{
+		return std::isnan(a) and std::isnan(b) ? 0 : std::numeric_limits<std::uint64_t>::max();
+	}
+	const std::uint64_t sign = 0x8000000000000000ull;
+	std::uint64_t bits_a, bits_b;
+	std::memcpy(&bits_a, &a, sizeof(a));
+	std::memcpy(&bits_b, &b, sizeof(b));
+	const std::uint64_t key_a = (bits_a & sign) ? sign - (bits_a & ~sign) : sign + bits_a;
+	const std::uint64_t key_b = (bits_b & sign) ? sign - (bits_b & ~sign) : sign + bits_b;
+	return key_a > key_b ? key_a - key_b : key_b - key_a;
+}
+
+golden_report goldenHarness::compare(const filter_history& reference, const filter_history& candidate, const golden_tolerance& tolerance,
+	const unsigned threads)
+{
+	const std::uint64_t n = std::min(reference.state.cols(), candidate.state.cols());
+	const std::uint64_t chunks = (n + chunk_epochs - 1) / chunk_epochs;
+	std::vector<golden_report> partial(chunks);
+
+	/// Worst errors keep the earliest value among equals, so merging the chunks gives the same report for any thread count
+	auto earlier = [](const golden_mismatch& a, const golden_mismatch& b)
+	{
+		return a.epoch < b.epoch or (a.epoch == b.epoch and a.quantity < b.quantity);
+	};
+
+	auto compareChunk = [&](const std::uint64_t chunk)
+	{
+		golden_report& report = partial[chunk];
+		const std::uint64_t first = chunk * chunk_epochs;
+		const std::uint64_t last = std::min(n, first + chunk_epochs);
+		for (std::uint64_t epoch=first; epoch<last; ++epoch)
+		{
+			const Eigen::Index k = static_cast<Eigen::Index>(epoch);
+			const double expected[quantities] = {reference.state(0,k), reference.state(1,k), reference.covariance(0,k), reference.covariance(1,k),
+				reference.covariance(2,k), reference.covariance(3,k), reference.nis(0,k)};
+			const double actual[quantities] = {candidate.state(0,k), candidate.state(1,k), candidate.covariance(0,k), candidate.covariance(1,k),
+				candidate.covariance(2,k), candidate.covariance(3,k), candidate.nis(0,k)};
+			for (int q=0; q<quantities; ++q)
+			{
+				golden_mismatch m;
+				m.epoch = epoch;
+				m.quantity = q;
+				m.reference = expected[q];
+				m.candidate = actual[q];
+				m.ulps = ulpDistance(expected[q], actual[q]);
+				const double magnitude = std::max(std::fabs(expected[q]), std::fabs(actual[q]));
+
+				/// A nan on one side only never matches, before any tolerance: the magnitude skips the nan, a reference of 0 would pass the abs_floor
+				const bool one_nan = std::isnan(expected[q]) != std::isnan(actual[q]);
+				if (m.ulps == 0)
+				{
+					m.relative = 0.0;
+				}
+				else if (one_nan)
+				{
+					m.relative = std::numeric_limits<double>::infinity();
+				}
+				else
+				{
+					m.relative = magnitude > 0.0 ? std::fabs(expected[q] - actual[q]) / magnitude : 0.0;
+				}
+
+				if (m.ulps > report.worst_ulps.ulps)
+				{
+					report.worst_ulps = m;
+				}
+				if (m.relative > report.worst_relative.relative)
+				{
+					report.worst_relative = m;
+				}
+				const bool equal = !one_nan and (m.ulps <= tolerance.max_ulps or m.relative <= tolerance.max_relative or magnitude <= tolerance.abs_floor);
+				if (!equal)
+				{
+					if (!report.diverged)
+					{
+						report.diverged = true;
+						report.first_divergence = m;
+					}
+					++report.mismatches;
+				}
+			}
+		}
+	};
+
+	std::atomic<std::uint64_t> next(0);
+	auto worker = [&]()
+	{
+		for (std::uint64_t chunk=next++; chunk<chunks; chunk=next++)
+		{
+			compareChunk(chunk);
+		}
+	};
+	unsigned num_threads = threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+	num_threads = static_cast<unsigned>(std::max<std::uint64_t>(1, std::min<std::uint64_t>(num_threads, chunks)));
+	std::vector<std::thread> workers;
+	for (unsigned t=1; t<num_threads; ++t)
+	{
+		workers.push_back(std::thread(worker));
+	}
+	worker();
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+
+	golden_report report;
+	report.epochs = n;
+	for (const golden_report& p : partial)
+	{
+		if (p.diverged and (!report.diverged or earlier(p.first_divergence, report.first_divergence)))
+		{
+			report.diverged = true;
+			report.first_divergence = p.first_divergence;
+		}
+		if (p.worst_ulps.ulps > report.worst_ulps.ulps)
+		{
+			report.worst_ulps = p.worst_ulps;
+		}
+		if (p.worst_relative.relative > report.worst_relative.relative)
+		{
+			report.worst_relative = p.worst_relative;
+		}
+		report.mismatches += p.mismatches;
+	}
+
+	/// Epochs only one engine computed are missing from the other
+	if (reference.state.cols() != candidate.state.cols() and !report.diverged)
+	{
+		report.diverged = true;
+		report.first_divergence = golden_mismatch();
+		report.first_divergence.epoch = n;
+		report.first_divergence.ulps = std::numeric_limits<std::uint64_t>::max();
+		report.first_divergence.relative = std::numeric_limits<double>::infinity();
+		report.first_divergence.reference = reference.state.cols() > static_cast<Eigen::Index>(n) ? reference.state(0, n) : std::nan("");
+		report.first_divergence.candidate = candidate.state.cols() > static_cast<Eigen::Index>(n) ? candidate.state(0, n) : std::nan("");
+	}
+	return report;
+}
+
+golden_report goldenHarness::run(const filter_input& f_in, const float dt, const filter_engine& candidate, const golden_tolerance& tolerance, const unsigned threads)
+{
+	filter_history golden, tested;
+	referenceEngine(dt)(f_in, golden);
+	candidate(f_in, tested);
+	return compare(golden, tested, tolerance, threads);
+}
+
+std::string goldenHarness::quantityName(const int quantity)
+{
+	if (quantity < 2)
+	{
+		return "state[" + std::to_string(quantity) + "]";
+	}
+	return quantity < 6 ? "covariance[" + std::to_string(quantity - 2) + "]" : "nis";
+}
+
+std::string goldenHarness::describe(const golden_report& report)
+{
+	auto mismatch = [](const golden_mismatch& m)
+	{
+		std::ostringstream text;
+		text << std::setprecision(17) << quantityName(m.quantity) << " at epoch " << m.epoch << ": reference " << m.reference
+			<< ", candidate " << m.candidate << std::setprecision(3) << " (" << m.ulps << " ULPs, relative " << m.relative << ")";
+		return text.str();
+	};
+
+	std::ostringstream text;
+	text << report.epochs << " epochs compared, " << (report.diverged ? std::to_string(report.mismatches) + " values outside the tolerance" : "all within the tolerance") << std::endl;
+	if (report.diverged)
+	{
+		text << "First divergence: " << mismatch(report.first_divergence) << std::endl;
+	}
+	text << "Worst ULPs: " << mismatch(report.worst_ulps) << std::endl;
+	text << "Worst relative error: " << mismatch(report.worst_relative) << std::endl;
+	return text.str();
+}
@@ -0,0 +1,152 @@
+#ifndef GOLDEN_HARNESS_H
+#define GOLDEN_HARNESS_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+/// Eigen includes
+#include <Eigen/Dense>
+
+/// Filter inputs and the reference twoStateClockModel::simpleEKF
+#include "pointOneNav.h"
+
+/**
+ * @file goldenHarness.h
+ * @brief contains the declaration of the golden-output harness: runs the reference simpleEKF loop and an alternative filter
+ * engine on the same inputs, and compares their state, covariance and NIS of every epoch within ULP or relative tolerances
+ */
+
+/**
+ * @brief filter_history struct holds what a filter engine computed after every epoch, one column per epoch
+ * - state: 2 x n, clock bias and clock rate
+ * - covariance: 4 x n, the 2x2 state covariance in column-major order (P00, P10, P01, P11)
+ * - nis: 1 x n, nan for a dropout epoch
+ */
+struct filter_history
+{
+	Eigen::MatrixXd state;
+	Eigen::MatrixXd covariance;
+	Eigen::MatrixXd nis;
+};
+
+/**
+ * @brief filter_engine runs a filter over every epoch of the measurement history of the inputs, filling a filter_history of as
+ * many columns; engines under test (fixed-size, batched, square-root, ...) are compared with goldenHarness::referenceEngine
+ */
+typedef std::function<void(const filter_input& f_in, filter_history& history)> filter_engine;
+
+/**
+ * @brief golden_tolerance struct holds when two values count as equal: within max_ulps units in the last place, or within
+ * max_relative of the larger magnitude, or both within abs_floor of zero. Two nan match each other, a nan and a number never do.
+ * The NIS is computed from the innovation, a difference of nearly equal numbers, so it carries relative errors of about 1e-12
+ * where the state and covariance stay within a few ULPs.
+ */
+struct golden_tolerance
+{
+	std::uint64_t max_ulps = 4;
+	double max_relative = 1e-10;
+	double abs_floor = 1e-300;
+};
+
+/**
+ * @brief golden_mismatch struct holds one compared value: where it is and how far apart the two engines are
+ * - quantity: 0-1 state, 2-5 covariance, 6 NIS, see goldenHarness::quantityName
+ */
+struct golden_mismatch
+{
+	std::uint64_t epoch = 0;
+	int quantity = 0;
+	double reference = 0.0;
+	double candidate = 0.0;
+	std::uint64_t ulps = 0;
+	double relative = 0.0;
+};
+
+/**
+ * @brief golden_report struct holds the result of a comparison
+ * - diverged: whether any value is outside the tolerance, first_divergence is then the earliest one (lowest epoch, then quantity)
+ * - worst_ulps and worst_relative: the largest distances over every value, in or out of tolerance
+ * - mismatches: number of values outside the tolerance
+ */
+struct golden_report
+{
+	std::uint64_t epochs = 0;
+	bool diverged = false;
+	golden_mismatch first_divergence;
+	golden_mismatch worst_ulps;
+	golden_mismatch worst_relative;
+	std::uint64_t mismatches = 0;
+};
+
+/**
+ * @brief The goldenHarness class compares filter engines with the reference implementation. The comparison is split into
+ * chunks of epochs, compared on all the threads at once; each chunk keeps its own earliest divergence and worst errors, merged
+ * at the end, so the report does not depend on the number of threads.
+ */
+class goldenHarness
+{
+public:
+	/// Quantities compared per epoch: 2 state, 4 covariance, NIS
+	static const int quantities = 7;
+
+	/// Epochs per chunk of the parallel comparison
+	static const std::uint64_t chunk_epochs = 65536;
+
+	/**
+	 * @brief referenceEngine the filter loop of main.cpp on twoStateClockModel::simpleEKF, the golden output
+	 * @param dt time step of the dynamics, a float as taken by twoStateClockModel
+	 */
+	static filter_engine referenceEngine(const float dt = 1.0);
+
+	/**
+	 * @brief fixedSizeEngine the same filter on fixed-size 2x2 Eigen matrices, no allocation per epoch; the operations are
+	 * reordered by Eigen, so it matches the reference within the default golden_tolerance rather than bit for bit
+	 * @param dt time step of the dynamics, the float of referenceEngine so that both run the same transition
+	 */
+	static filter_engine fixedSizeEngine(const float dt = 1.0);
+
+	/**
+	 * @brief ulpDistance number of doubles between a and b, 0 if equal (+0 and -0 included) or both nan, the maximum if only one
+	 * is nan or they are infinities of different sign
+	 */
+	static std::uint64_t ulpDistance(const double a, const double b);
+
+	/**
+	 * @brief compare two histories epoch by epoch
+	 * @param reference the golden output
+	 * @param candidate the output of the engine under test, of the same size
+	 * @param tolerance when two values count as equal
+	 * @param threads threads to compare with, 0 uses all hardware threads
+	 * @return the report; a candidate of another size diverges at the first epoch past the shorter one
+	 */
+	static golden_report compare(const filter_history& reference, const filter_history& candidate, const golden_tolerance& tolerance,
+		const unsigned threads = 0);
+
+	/**
+	 * @brief run run the reference engine and the candidate on the inputs and compare their histories
+	 * @param f_in the filter inputs
+	 * @param dt time step of the reference engine, the one the candidate was built with
+	 * @param candidate the engine under test
+	 * @param tolerance when two values count as equal
+	 * @param threads threads to compare with, 0 uses all hardware threads
+	 * @return the report
+	 */
+	static golden_report run(const filter_input& f_in, const float dt, const filter_engine& candidate, const golden_tolerance& tolerance,
+		const unsigned threads = 0);
+
+	/**
+	 * @brief quantityName the name of a quantity, e.g. "state[0]", "covariance[3]" or "nis"
+	 */
+	static std::string quantityName(const int quantity);
+
+	/**
+	 * @brief describe a few lines on the report: epochs compared, first divergence, worst errors
+	 */
+	static std::string describe(const golden_report& report);
+};
+
+#endif // GOLDEN_HARNESS_H
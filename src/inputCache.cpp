@@ -0,0 +1,241 @@
+#include "inputCache.h"
+
+/// Std includes
+#include <cstring> // std::memcmp
+#include <cstdlib> // realpath
+#include <climits> // PATH_MAX
+#include <vector>
+
+/// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @file inputCache.cpp
+ * @brief contains all the inputCache member function definitions declared in .h file
+ */
+
+/// Sidecar file identification, bumped whenever the layout changes
+static const char cache_magic[8] = {'P', '1', 'N', 'A', 'V', 'C', 'A', 'C'};
+static const std::uint32_t cache_version = 1;
+
+/// Sidecar lives next to the text file
+std::string inputCache::sidecarName(const std::string file_name)
+{
+	return file_name + ".p1cache";
+}
+
+/// Canonical path of the text file, so a sidecar copied along with a different file is not picked up
+static std::string canonicalPath(const std::string file_name)
+{
+	char resolved[PATH_MAX];
+	if (::realpath(file_name.c_str(), resolved) == NULL)
+	{
+		return file_name;
+	}
+	return std::string(resolved);
+}
+
+/// Modification time of a file in nanoseconds
+static std::int64_t mtimeNs(const struct stat& st)
+{
+	return static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+/// Size and modification time, compared with those of the sidecar header
+bool inputCache::identify(const std::string file_name, cache_source& source)
+{
+	struct stat st;
+	if (::stat(file_name.c_str(), &st) != 0)
+	{
+		return false;
+	}
+	source.size = static_cast<std::uint64_t>(st.st_size);
+	source.mtime_ns = mtimeNs(st);
+	return true;
+}
+
+/// Hash the whole file through a read-only mapping
+bool inputCache::contentHash(const std::string file_name, std::uint64_t& hash)
+{
+	hash = 14695981039346656037ULL;
+
+	int fd = ::open(file_name.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+	if (st.st_size == 0)
+	{
+		::close(fd);
+		return true;
+	}
+
+	void* data = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+	::madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (off_t i=0; i<st.st_size; ++i)
+	{
+		hash = (hash ^ bytes[i]) * 1099511628211ULL;
+	}
+	::munmap(data, st.st_size);
+	return true;
+}
+
+/// Map the sidecar, check it still belongs to the text file and copy the matrix out
+bool inputCache::load(const std::string file_name, Eigen::MatrixXd& input_mat, const bool verify_content)
+{
+	struct stat source_st;
+	if (::stat(file_name.c_str(), &source_st) != 0)
+	{
+		return false;
+	}
+
+	int fd = ::open(sidecarName(file_name).c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	if (::fstat(fd, &st) != 0 or static_cast<std::size_t>(st.st_size) < sizeof(cache_header))
+	{
+		::close(fd);
+		return false;
+	}
+	void* data = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	const char* bytes = static_cast<const char*>(data);
+	const cache_header* header = static_cast<const cache_header*>(data);
+	std::string path = canonicalPath(file_name);
+
+	/// The sidecar must match the current text file and hold all the values it announces; the size of the values is checked by
+	/// division, a corrupt rows or cols cannot overflow it
+	const std::uint64_t file_size = static_cast<std::uint64_t>(st.st_size);
+	bool valid = std::memcmp(header->magic, cache_magic, sizeof(cache_magic)) == 0 and header->version == cache_version and
+				 header->source_size == static_cast<std::uint64_t>(source_st.st_size) and header->source_mtime_ns == mtimeNs(source_st) and
+				 header->rows > 0 and header->cols > 0 and
+				 sizeof(cache_header) + header->path_length <= file_size and
+				 path.compare(0, std::string::npos, bytes + sizeof(cache_header), header->path_length) == 0 and
+				 header->data_offset <= file_size and
+				 static_cast<std::uint64_t>(header->rows) <= (file_size - header->data_offset) / sizeof(double) / static_cast<std::uint64_t>(header->cols);
+
+	std::uint64_t hash = 0;
+	if (valid and verify_content)
+	{
+		valid = contentHash(file_name, hash) and hash == header->source_hash;
+	}
+
+	if (valid)
+	{
+		input_mat = Eigen::Map<const Eigen::MatrixXd>(reinterpret_cast<const double*>(bytes + header->data_offset), header->rows, header->cols);
+	}
+	::munmap(data, st.st_size);
+	return valid;
+}
+
+/// Write the sidecar to a temporary file and rename it into place, so readers never see a partial sidecar
+bool inputCache::store(const std::string file_name, const cache_source& source, const Eigen::MatrixXd& input_mat)
+{
+	return store(file_name, source, input_mat.rows(), input_mat.cols(), [&input_mat](const int fd, const std::uint64_t data_offset)
+	{
+		const char* data = reinterpret_cast<const char*>(input_mat.data());
+		const std::size_t size = input_mat.size() * sizeof(double);
+		std::size_t written = 0;
+		while (written < size)
+		{
+			ssize_t n = ::pwrite(fd, data + written, size - written, data_offset + written);
+			if (n <= 0)
+			{
+				return false;
+			}
+			written += n;
+		}
+		return true;
+	});
+}
+
+/// The header describes the text file the values came from, the values follow on a cache line boundary
+bool inputCache::store(const std::string file_name, const cache_source& source, const std::int64_t rows, const std::int64_t cols,
+	const value_writer& write_values)
+{
+	cache_source before, after;
+	std::uint64_t hash = 0;
+	if (!identify(file_name, before) or !contentHash(file_name, hash) or !identify(file_name, after))
+	{
+		return false;
+	}
+
+	/// The text file changed since it was parsed or while it was hashed, leave the sidecar for the next run
+	if (before.size != source.size or before.mtime_ns != source.mtime_ns or after.size != source.size or after.mtime_ns != source.mtime_ns)
+	{
+		return false;
+	}
+
+	std::string path = canonicalPath(file_name);
+	cache_header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+	header.version = cache_version;
+	header.path_length = static_cast<std::uint32_t>(path.size());
+	header.source_size = source.size;
+	header.source_mtime_ns = source.mtime_ns;
+	header.source_hash = hash;
+	header.rows = rows;
+	header.cols = cols;
+
+	/// Values start on a cache line boundary
+	header.data_offset = (sizeof(cache_header) + path.size() + 63) / 64 * 64;
+
+	std::vector<char> prefix(header.data_offset, 0);
+	std::memcpy(&prefix[0], &header, sizeof(header));
+	std::memcpy(&prefix[sizeof(header)], path.data(), path.size());
+
+	std::string sidecar = sidecarName(file_name);
+	std::string temp_name = sidecar + ".tmp." + std::to_string(::getpid());
+	int fd = ::open(temp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	bool ok = true;
+	std::size_t written = 0;
+	while (written < prefix.size())
+	{
+		ssize_t n = ::write(fd, &prefix[written], prefix.size() - written);
+		if (n <= 0)
+		{
+			ok = false;
+			break;
+		}
+		written += n;
+	}
+	ok = ok and write_values(fd, header.data_offset);
+
+	if (::close(fd) != 0 or !ok or ::rename(temp_name.c_str(), sidecar.c_str()) != 0)
+	{
+		::unlink(temp_name.c_str());
+		return false;
+	}
+	return true;
+}
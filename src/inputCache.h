@@ -0,0 +1,109 @@
+#ifndef INPUT_CACHE_H
+#define INPUT_CACHE_H
+
+/// Std includes
+#include <string>
+#include <cstdint>
+#include <functional>
+
+/// Eigen includes
+#include <Eigen/Dense>
+
+/**
+ * @file inputCache.h
+ * @brief contains the declaration of the parsed-input cache, binary sidecars that let later runs skip parsing the text input files
+ */
+
+/**
+ * @brief cache_header struct at the start of every sidecar file, followed by the source path and the matrix values
+ * (column-major doubles at data_offset)
+ */
+struct cache_header
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t path_length;
+	std::uint64_t source_size;
+	std::int64_t source_mtime_ns;
+	std::uint64_t source_hash;
+	std::int64_t rows;
+	std::int64_t cols;
+	std::uint64_t data_offset;
+};
+
+/**
+ * @brief cache_source struct identifies the text file a matrix is parsed from, taken before it is parsed
+ */
+struct cache_source
+{
+	std::uint64_t size;
+	std::int64_t mtime_ns;
+};
+
+/**
+ * @brief The inputCache class stores a parsed input matrix next to its text file ("<file>.p1cache") and maps it back in on later runs.
+ * A sidecar is only used while the size, modification time and path of the text file match the ones it was built from;
+ * the FNV-1a hash of the text contents is stored as well and checked on load when asked for.
+ */
+class inputCache
+{
+public:
+	/// Writes the values of a sidecar through the open file descriptor, column-major from the given file offset
+	typedef std::function<bool(const int fd, const std::uint64_t data_offset)> value_writer;
+
+	/**
+	 * @brief sidecarName name of the sidecar file belonging to a text input file
+	 * @param file_name path of the text input file
+	 * @return path of the sidecar
+	 */
+	static std::string sidecarName(const std::string file_name);
+
+	/**
+	 * @brief load map the sidecar of a text input file and copy the matrix out of it, if the sidecar is still valid
+	 * @param file_name path of the text input file
+	 * @param input_mat matrix to hold the cached values
+	 * @param verify_content also hash the text file and compare it with the hash in the sidecar
+	 * @return boolean value, false if there is no valid sidecar
+	 */
+	static bool load(const std::string file_name, Eigen::MatrixXd& input_mat, const bool verify_content = false);
+
+	/**
+	 * @brief identify size and modification time of a text input file, to be taken before it is parsed and handed to store
+	 * @param file_name path of the text input file
+	 * @param source holds the size and modification time
+	 * @return boolean value, false if the file cannot be accessed
+	 */
+	static bool identify(const std::string file_name, cache_source& source);
+
+	/**
+	 * @brief store write the sidecar of a text input file, atomically replacing any stale one
+	 * @param file_name path of the text input file the matrix was parsed from
+	 * @param source the text file as it was before parsing it; nothing is stored if it has changed since
+	 * @param input_mat the parsed matrix
+	 * @return boolean value
+	 */
+	static bool store(const std::string file_name, const cache_source& source, const Eigen::MatrixXd& input_mat);
+
+	/**
+	 * @brief store write the sidecar of a text input file whose values are produced by the caller, for matrices too large to hold
+	 * in memory; the values may be written in any order (pwrite) and from several threads
+	 * @param file_name path of the text input file the values belong to, complete before the sidecar is written
+	 * @param source the text file the values were produced for; nothing is stored if it has changed since
+	 * @param rows number of rows of the matrix
+	 * @param cols number of columns of the matrix
+	 * @param write_values writes rows*cols column-major doubles at the given offset of the sidecar
+	 * @return boolean value
+	 */
+	static bool store(const std::string file_name, const cache_source& source, const std::int64_t rows, const std::int64_t cols,
+		const value_writer& write_values);
+
+	/**
+	 * @brief contentHash 64-bit FNV-1a hash of the contents of a file
+	 * @param file_name path of the file
+	 * @param hash holds the hash
+	 * @return boolean value
+	 */
+	static bool contentHash(const std::string file_name, std::uint64_t& hash);
+};
+
+#endif // INPUT_CACHE_H
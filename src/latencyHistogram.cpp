@@ -0,0 +1,191 @@
+#include "latencyHistogram.h"
+
+/// Std includes
+#include <chrono>
+#include <cmath>
+#include <cstdio>   // std::snprintf
+#include <algorithm>
+
+/// Time stamp counter
+#if defined(__x86_64__) or defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @file latencyHistogram.cpp
+ * @brief contains all the cycleClock and latencyHistogram member function definitions declared in .h file
+ */
+
+const int latencyHistogram::sub_bits;
+const std::size_t latencyHistogram::bucket_count;
+
+std::uint64_t cycleClock::now()
+{
+#if defined(__x86_64__) or defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/// The counter and the steady clock are read together at both ends of a 20 ms spin
+double cycleClock::nanosecondsPerTick()
+{
+#if defined(__x86_64__) or defined(__i386__)
+	static const double rate = []()
+	{
+		const auto t0 = std::chrono::steady_clock::now();
+		const std::uint64_t c0 = __rdtsc();
+		auto t1 = t0;
+		while (t1 - t0 < std::chrono::milliseconds(20))
+		{
+			t1 = std::chrono::steady_clock::now();
+		}
+		const std::uint64_t c1 = __rdtsc();
+		const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+		return c1 > c0 ? ns / (c1 - c0) : 1.0;
+	}();
+	return rate;
+#else
+	return 1.0;
+#endif
+}
+
+std::uint64_t cycleClock::toNanoseconds(const std::uint64_t ticks)
+{
+	return static_cast<std::uint64_t>(ticks * nanosecondsPerTick());
+}
+
+/// class constructor, the only allocation of the histogram
+latencyHistogram::latencyHistogram()
+	: counts(bucket_count, 0), total(0), largest(0), sum(0.0)
+{
+}
+
+/// Values below 2^sub_bits index their bucket; above, the top sub_bits bits of the value do
+std::size_t latencyHistogram::bucketOf(const std::uint64_t value)
+{
+	if (value < (1u << sub_bits))
+	{
+		return static_cast<std::size_t>(value);
+	}
+	const int shift = 63 - __builtin_clzll(value) - (sub_bits - 1);
+	return (static_cast<std::size_t>(shift) << (sub_bits - 1)) + static_cast<std::size_t>(value >> shift);
+}
+
+std::uint64_t latencyHistogram::bucketLow(const std::size_t bucket)
+{
+	if (bucket < (1u << sub_bits))
+	{
+		return bucket;
+	}
+	const int shift = static_cast<int>(bucket >> (sub_bits - 1)) - 1;
+	return static_cast<std::uint64_t>(bucket - (static_cast<std::size_t>(shift) << (sub_bits - 1))) << shift;
+}
+
+/// The top bucket ends at 2^64 - 1, the shift wraps around to it
+std::uint64_t latencyHistogram::bucketHigh(const std::size_t bucket)
+{
+	if (bucket < (1u << sub_bits))
+	{
+		return bucket;
+	}
+	const int shift = static_cast<int>(bucket >> (sub_bits - 1)) - 1;
+	return (static_cast<std::uint64_t>(bucket - (static_cast<std::size_t>(shift) << (sub_bits - 1)) + 1) << shift) - 1;
+}
+
+void latencyHistogram::record(const std::uint64_t nanoseconds)
+{
+	this->counts[bucketOf(nanoseconds)]++;
+	this->total++;
+	this->largest = std::max(this->largest, nanoseconds);
+	this->sum += static_cast<double>(nanoseconds);
+}
+
+/// A counter read that went backwards (migration between unsynchronized cores) counts as 0
+void latencyHistogram::recordTicks(const std::uint64_t start, const std::uint64_t end)
+{
+	this->record(end > start ? cycleClock::toNanoseconds(end - start) : 0);
+}
+
+void latencyHistogram::merge(const latencyHistogram& other)
+{
+	for (std::size_t b=0; b<bucket_count; ++b)
+	{
+		this->counts[b] += other.counts[b];
+	}
+	this->total += other.total;
+	this->largest = std::max(this->largest, other.largest);
+	this->sum += other.sum;
+}
+
+void latencyHistogram::reset()
+{
+	std::fill(this->counts.begin(), this->counts.end(), 0);
+	this->total = 0;
+	this->largest = 0;
+	this->sum = 0.0;
+}
+
+std::uint64_t latencyHistogram::count() const
+{
+	return this->total;
+}
+
+std::uint64_t latencyHistogram::max() const
+{
+	return this->largest;
+}
+
+/// Walk the buckets up to the rank of the quantile
+double latencyHistogram::quantile(const double q) const
+{
+	if (this->total == 0)
+	{
+		return 0.0;
+	}
+	if (q >= 1.0)
+	{
+		return static_cast<double>(this->largest);
+	}
+	const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::max(q, 0.0) * this->total)));
+	std::uint64_t seen = 0;
+	for (std::size_t b=0; b<bucket_count; ++b)
+	{
+		seen += this->counts[b];
+		if (seen >= rank)
+		{
+			const std::uint64_t low = bucketLow(b);
+			const double middle = low + 0.5 * static_cast<double>(bucketHigh(b) - low);
+			return std::min(middle, static_cast<double>(this->largest));
+		}
+	}
+	return static_cast<double>(this->largest);
+}
+
+latency_summary latencyHistogram::summary() const
+{
+	latency_summary s;
+	s.count = this->total;
+	s.mean = this->total > 0 ? this->sum / this->total : 0.0;
+	s.p50 = this->quantile(0.5);
+	s.p99 = this->quantile(0.99);
+	s.p999 = this->quantile(0.999);
+	s.max = static_cast<double>(this->largest);
+	return s;
+}
+
+std::string latencyHistogram::format(const double nanoseconds)
+{
+	static const char* units[] = {"ns", "us", "ms", "s"};
+	double value = nanoseconds;
+	int unit = 0;
+	while (value >= 1000.0 and unit < 3)
+	{
+		value /= 1000.0;
+		unit++;
+	}
+	char text[32];
+	std::snprintf(text, sizeof(text), "%.3g %s", value, units[unit]);
+	return text;
+}
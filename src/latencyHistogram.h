@@ -0,0 +1,134 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+/// Std includes
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file latencyHistogram.h
+ * @brief contains the declaration of the per-epoch latency histograms: a calibrated cycle counter and a log-linear histogram
+ * that records without allocating
+ */
+
+/**
+ * @brief The cycleClock class reads the time stamp counter (rdtsc) on x86, a few cycles per read, and converts its ticks to
+ * nanoseconds with a rate calibrated once against the steady clock. Other architectures read the monotonic clock, one tick per
+ * nanosecond. The counter is assumed invariant (constant rate, synchronized across cores), as on every x86 CPU of the last decade.
+ */
+class cycleClock
+{
+public:
+	/**
+	 * @brief now read the counter
+	 * @return ticks
+	 */
+	static std::uint64_t now();
+
+	/**
+	 * @brief nanosecondsPerTick the calibrated rate, measured over about 20 ms at the first call
+	 */
+	static double nanosecondsPerTick();
+
+	/**
+	 * @brief toNanoseconds convert a tick count
+	 */
+	static std::uint64_t toNanoseconds(const std::uint64_t ticks);
+};
+
+/**
+ * @brief latency_summary struct holds the quantiles of a latency histogram, in nanoseconds
+ */
+struct latency_summary
+{
+	std::uint64_t count;
+	double mean;
+	double p50;
+	double p99;
+	double p999;
+	double max;
+};
+
+/**
+ * @brief The latencyHistogram class counts latencies in HDR-style log-linear buckets: values below 128 ns have a bucket each, every
+ * power of two above is split into 64 buckets, so a quantile is within 1/128 of the true value (2 significant digits) from
+ * nanoseconds to centuries. All the buckets are allocated by the constructor, record() is an index computation and an increment.
+ * A histogram is written by one thread; merge those of several threads to report them together.
+ */
+class latencyHistogram
+{
+private:
+	/// Linear buckets below 2^sub_bits, then 2^(sub_bits-1) buckets per power of two
+	static const int sub_bits = 7;
+	static const std::size_t bucket_count = (64 - sub_bits + 2) << (sub_bits - 1);
+
+	std::vector<std::uint64_t> counts;
+	std::uint64_t total;
+	std::uint64_t largest;
+	double sum;
+
+	/// Bucket holding a value, and the values a bucket holds
+	static std::size_t bucketOf(const std::uint64_t value);
+	static std::uint64_t bucketLow(const std::size_t bucket);
+	static std::uint64_t bucketHigh(const std::size_t bucket);
+
+public:
+	/**
+	 * @brief latencyHistogram class constructor, allocates every bucket
+	 */
+	latencyHistogram();
+
+	/**
+	 * @brief record count one latency
+	 * @param nanoseconds the latency
+	 */
+	void record(const std::uint64_t nanoseconds);
+
+	/**
+	 * @brief recordTicks count one latency measured with cycleClock::now
+	 * @param start ticks at the start of the operation
+	 * @param end ticks at its end
+	 */
+	void recordTicks(const std::uint64_t start, const std::uint64_t end);
+
+	/**
+	 * @brief merge add the counts of another histogram
+	 */
+	void merge(const latencyHistogram& other);
+
+	/**
+	 * @brief reset forget every value recorded
+	 */
+	void reset();
+
+	/**
+	 * @brief count number of values recorded
+	 */
+	std::uint64_t count() const;
+
+	/**
+	 * @brief max the largest value recorded, exact
+	 */
+	std::uint64_t max() const;
+
+	/**
+	 * @brief quantile value below which the given fraction of the values lies, the middle of its bucket (the exact max for 1)
+	 * @param q the fraction, in [0, 1]
+	 * @return nanoseconds, 0 when empty
+	 */
+	double quantile(const double q) const;
+
+	/**
+	 * @brief summary the count, mean, p50, p99, p99.9 and max
+	 */
+	latency_summary summary() const;
+
+	/**
+	 * @brief format print a duration in ns, us, ms or s with 3 significant digits
+	 */
+	static std::string format(const double nanoseconds);
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -10,8 +10,15 @@
  * - File descriptions:   
  *	 - main.cpp - top level file that runs the algorithm
  *	 - pointOneNav.h - contains the high level data abstraction with declaration of function prototypes
- *	 - pointOneNav.hpp - contains the corresponding functions definitions
+ *	 - pointOneNav.cpp - contains the corresponding functions definitions, compiled into the pointonenav library
+ *	 - pointOneNavPlot.cpp - the plotting members, compiled into the plotting library
  *	 - matplotlibcpp.h - C++ plotting library built on matplotlib; Source: https://github.com/lava/matplotlib-cpp
+ *	 - plotWorkers.h - renders the plots in worker processes while the filter returns
+ *	 - filterStats.h - streaming NIS consistency statistics, updated every epoch
+ *	 - latencyHistogram.h - rdtsc-timed latency histograms of the filter step, ingest and output, with "--latency"
+ *	 - stageProfiler.h - per-stage wall time, CPU time, peak RSS and item counts, reported as JSON with "--profile <file>"
+ *	 - traceEvents.h - spans of every thread and plot worker, dumped as Chrome/Perfetto trace-event JSON with "--trace <file>"
+ *	 - perfCounters.h - cycles, instructions, cache and branch misses of the parse and filter loops, per byte and per epoch with "--perf"
  *
  *
  * - Algorithm parameters:
@@ -37,12 +44,214 @@
  *
  * - Outputs:
  *   - filter_output.txt - the algorithm output containing the estimate of offset and drift rate of a clock
- *   - plots - bias estimate plot, rate estimate plot and the NIS filter residual plots 
+ *   - filter_output.p1pyr - bias, rate and NIS histories with their min/max/mean pyramid, read by tools/pyramidQuery.cpp
+ *   - plots - bias estimate plot, rate estimate plot and the NIS filter residual plots, unless built without plotting (-DPLOTTING=OFF)
  *
  ******************************************************************************************************************* */
 
+/// Std includes
+#include <iostream>
+#include <iomanip> // std::setprecision
+#include <cstdlib> // std::getenv, std::strtol
+#include <cerrno> // errno, ERANGE
+#include <limits>
+#include <stdexcept> // std::runtime_error
+
 /// Main header include
-#include "pointOneNav.hpp"
+#include "pointOneNav.h"
+
+/// Plot decimation and NIS consistency statistics
+#include "downsample.h"
+#include "filterStats.h"
+
+/// Live measurement ingest and background output writer
+#include "measurementSource.h"
+#include "asyncOutputSink.h"
+
+/// Background plot rendering
+#include "plotWorkers.h"
+
+/// Per-epoch latency histograms
+#include "latencyHistogram.h"
+
+/// Per-stage profile, trace spans and hardware counters
+#include "stageProfiler.h"
+#include "traceEvents.h"
+#include "perfCounters.h"
+
+/**
+ * @brief printUsage print the command line of ekf, after a wrong argument
+ * @param program the name ekf was run as
+ */
+void printUsage(const char* program)
+{
+	std::cerr << "Usage: " << program << " [dt] [--live <source>] [--input-dir <dir>] [--no-cache] [--headless] [--plot-points <n>]"
+		<< " [--wait-plots] [--no-plot] [--stats-every <n>] [--latency] [--profile <file>] [--trace <file>] [--perf]" << std::endl
+		<< "  dt: time step of the filter, a positive integer (default 1)" << std::endl;
+}
+
+/**
+ * @brief parseInteger read a command line value that must be a decimal integer as a whole, such as dt or "--plot-points <n>"
+ * @param text the value
+ * @param min_value smallest value accepted
+ * @param max_value largest value accepted
+ * @param value the integer read
+ * @return boolean value, false if the text holds anything else than an integer or it is outside [min_value, max_value]
+ */
+bool parseInteger(const char* text, const long min_value, const long max_value, long& value)
+{
+	char* end = NULL;
+	errno = 0;
+	value = std::strtol(text, &end, 10);
+	return end != text and *end == '\0' and errno != ERANGE and value >= min_value and value <= max_value;
+}
+
+/**
+ * @brief printStats print the NIS consistency statistics accumulated so far
+ * @param stats the statistics
+ * @param epochs number of epochs run
+ */
+void printStats(const filterStats& stats, const std::uint64_t epochs)
+{
+	nis_summary s = stats.summary();
+	std::cout << std::setprecision(4) << std::defaultfloat << "NIS after " << epochs << " epochs: mean " << s.mean << " (last window " << s.window_mean
+		<< "), " << 100.0 * (s.fraction_below + s.fraction_above) << "% outside [" << s.lower_bound << ", " << s.upper_bound << "] (last window "
+		<< 100.0 * s.window_fraction_outside << "%), median " << s.median << ", 95th percentile " << s.quantile_95 << std::endl;
+}
+
+/**
+ * @brief printLatency print the latency quantiles of an operation
+ * @param operation what was timed
+ * @param histogram its latencies
+ */
+void printLatency(const std::string operation, const latencyHistogram& histogram)
+{
+	latency_summary s = histogram.summary();
+	std::cout << operation << " latency over " << s.count << " epochs: p50 " << latencyHistogram::format(s.p50) << ", p99 " << latencyHistogram::format(s.p99)
+		<< ", p99.9 " << latencyHistogram::format(s.p999) << ", max " << latencyHistogram::format(s.max) << ", mean " << latencyHistogram::format(s.mean) << std::endl;
+}
+
+/// ******************
+//! LIVE FILTER MODE |
+/// ******************
+
+/**
+ * @brief runLive run the filter one epoch at a time on measurements arriving from a live source
+ * @param clockModel the clock model used for the filter steps
+ * @param f_in the filter inputs, the measurement history is not used
+ * @param source the live source, "stdin", "fifo:<path>", "unix:<path>" or "udp:<port>"
+ * @param stats_every print the NIS statistics every that many epochs, 0 only at the end
+ * @param latency time every filter step, ingest and output push into latency histograms, printed with the statistics
+ * @return int
+ */
+int runLive(twoStateClockModel& clockModel, const filter_input& f_in, const std::string source, const long stats_every, const bool latency)
+{
+	measurementSource measurements;
+	if (!measurements.open(source))
+	{
+		return -1;
+	}
+
+	/// Results go to a background writer thread, the filter never waits on the disk
+	asyncOutputSink sink("live_output.txt", sink_format::text, backpressure_policy::grow);
+	if (!sink.isOpen())
+	{
+		return -1;
+	}
+
+	mat clock_noise_cov = f_in.process_noise_covariance;
+	mat measurement_cov = f_in.measurement_noise_covariance;
+	mat xk_est = f_in.initial_state_estimate;
+	mat xcovk_est = f_in.initial_state_estimate_covariance;
+
+	mat w_k = mat::Zero(2,1);
+	mat v_kp1 = mat::Zero(2,1);
+
+	/// End-to-end latency from the arrival of a measurement to its result being queued for output
+	double latency_sum = 0.0, latency_max = 0.0;
+	std::uint64_t epochs = 0;
+
+	/// Two-sided bounds at alpha = 0.1, the upper one is the 95% NIS threshold of the plots
+	filterStats nis_stats(2, 0.1, 100);
+
+	/// Ingest: from the read returning the line to the filter getting it, parsing and queueing behind earlier lines included
+	latencyHistogram step_latency, ingest_latency, output_latency, end_to_end_latency;
+
+	STAGE_BEGIN(stage, "filter", source);
+	Eigen::Vector2d y_next;
+	while (measurements.next(y_next))
+	{
+		if (latency)
+		{
+			ingest_latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - measurements.arrivalTime()).count());
+		}
+		mat y_kp1 = y_next;
+		const std::uint64_t step_start = latency ? cycleClock::now() : 0;
+		clockModel.simpleEKF(xk_est, xcovk_est, w_k, clock_noise_cov, y_kp1, v_kp1, measurement_cov);
+		if (latency)
+		{
+			step_latency.recordTicks(step_start, cycleClock::now());
+		}
+
+		xk_est = clockModel.get_xkp1();
+		xcovk_est = clockModel.get_xcov_kp1();
+		mat temp = (clockModel.get_zkp1().transpose()) * ((clockModel.get_skp1()).inverse() * clockModel.get_zkp1());
+
+		epoch_result result;
+		result.epoch = ++epochs;
+		result.state[0] = xk_est(0);
+		result.state[1] = xk_est(1);
+		for (int i=0; i<4; ++i)
+		{
+			result.covariance[i] = xcovk_est(i);
+		}
+		result.nis = temp(0);
+		const std::uint64_t push_start = latency ? cycleClock::now() : 0;
+		sink.push(result);
+		if (latency)
+		{
+			output_latency.recordTicks(push_start, cycleClock::now());
+		}
+		nis_stats.add(result.nis);
+
+		std::chrono::duration<double, std::micro> end_to_end = std::chrono::steady_clock::now() - measurements.arrivalTime();
+		latency_sum += end_to_end.count();
+		latency_max = std::max(latency_max, end_to_end.count());
+		if (latency)
+		{
+			end_to_end_latency.record(static_cast<std::uint64_t>(1000.0 * end_to_end.count()));
+		}
+
+		if (stats_every > 0 and result.epoch % stats_every == 0)
+		{
+			printStats(nis_stats, epochs);
+			if (latency)
+			{
+				printLatency("Ingest", ingest_latency);
+				printLatency("Filter step", step_latency);
+				printLatency("Output push", output_latency);
+				printLatency("End-to-end", end_to_end_latency);
+			}
+		}
+	}
+
+	bool written = sink.shutdown();
+	STAGE_END(stage, epochs);
+	std::cout << "Live mode: " << epochs << " epochs, " << measurements.malformed() << " malformed lines skipped" << std::endl;
+	if (epochs > 0)
+	{
+		std::cout << std::setprecision(6) << std::defaultfloat << "End-to-end latency: mean " << latency_sum / epochs << " us, max " << latency_max << " us" << std::endl;
+		printStats(nis_stats, epochs);
+		if (latency)
+		{
+			printLatency("Ingest", ingest_latency);
+			printLatency("Filter step", step_latency);
+			printLatency("Output push", output_latency);
+			printLatency("End-to-end", end_to_end_latency);
+		}
+	}
+	return written and STAGE_REPORT(epochs) and TRACE_DUMP() ? 0 : -1;
+}
 
 /// ***************
 //! MAIN FUNCTION |
@@ -57,24 +266,209 @@ int main(int argc, char** argv)
 	/// Initialize struct that holds the process filter inputs matrices
 	filter_input f_in;
 
-	/// Assigning dt value based on command line args; Implicitly uses dt = 1;
+	/// Assigning dt value based on command line args, the only positional argument; Implicitly uses dt = 1;
+	/// an unknown flag, a flag missing its value or an invalid dt prints the usage and returns -1
+	/// "--live <source>" runs the filter on measurements arriving from stdin, a named pipe or a socket
+	/// "--no-cache" parses the input text files even when a valid binary sidecar exists
+	/// "--headless" only saves the plots (PNG and SVG) without opening a window, the default when there is no display
+	/// "--plot-points <n>" decimates longer series to about n points before plotting (LTTB), 0 plots every sample
+	/// "--wait-plots" waits for the plot workers before returning, the default when the plot windows are shown
+	/// "--no-plot" only writes the numeric outputs, no plot worker is started and neither is the Python interpreter
+	/// "--latency" times every filter step (and in live mode every ingest and output push) into histograms, whose p50, p99, p99.9
+	///	and max are printed at the end and every "--stats-every" epochs
+	/// "--profile <file>" records the wall time, CPU time, peak RSS growth and item count of every stage into a JSON report
+	/// "--perf" counts the cycles, instructions, cache misses and branch misses of the input parses and of the filter loop with
+	///	perf_event_open, and prints the IPC and the counts per byte parsed and per epoch
+	/// "--trace <file>" records spans of the reads, parses, filter batches, writes and plots into a trace for chrome://tracing or Perfetto
+	/// "--input-dir <dir>" reads the input files from dir instead of ../filter_input, such as a dataset written by generateDataset
+	/// "--stats-every <n>" prints the NIS consistency statistics every n epochs while the filter runs, besides once at the end
 	bool dt_input = false;
 	auto dt_val = 1;
-	if (argc == 2)
+	std::string live_source;
+	bool input_cache = true;
+	bool headless = std::getenv("DISPLAY") == NULL and std::getenv("WAYLAND_DISPLAY") == NULL;
+	long plot_points = 4000;
+	bool wait_plots = false;
+	bool plots = true;
+	long stats_every = 0;
+	std::string input_dir;
+	std::string profile_report;
+	std::string trace_file;
+	bool latency = false;
+	bool perf = false;
+	for (int i=1; i<argc; ++i)
 	{
-		dt_input = true;
-		dt_val = std::atoi(argv[1]);
+		std::string arg = argv[i];
+		const bool takes_value = arg == "--live" or arg == "--plot-points" or arg == "--stats-every" or arg == "--input-dir" or
+			arg == "--profile" or arg == "--trace";
+		if (takes_value and i+1 >= argc)
+		{
+			std::cerr << arg << " needs a value" << std::endl;
+			printUsage(argv[0]);
+			return -1;
+		}
+
+		if (arg == "--live")
+		{
+			live_source = argv[++i];
+		}
+		else if (arg == "--no-cache")
+		{
+			input_cache = false;
+		}
+		else if (arg == "--headless")
+		{
+			headless = true;
+		}
+		else if (arg == "--plot-points")
+		{
+			if (!parseInteger(argv[++i], 0, std::numeric_limits<long>::max(), plot_points))
+			{
+				std::cerr << "Invalid --plot-points " << argv[i] << ", a non-negative integer is expected" << std::endl;
+				printUsage(argv[0]);
+				return -1;
+			}
+		}
+		else if (arg == "--wait-plots")
+		{
+			wait_plots = true;
+		}
+		else if (arg == "--no-plot")
+		{
+			plots = false;
+		}
+		else if (arg == "--stats-every")
+		{
+			if (!parseInteger(argv[++i], 0, std::numeric_limits<long>::max(), stats_every))
+			{
+				std::cerr << "Invalid --stats-every " << argv[i] << ", a non-negative integer is expected" << std::endl;
+				printUsage(argv[0]);
+				return -1;
+			}
+		}
+		else if (arg == "--input-dir")
+		{
+			input_dir = argv[++i];
+		}
+		else if (arg == "--profile")
+		{
+			profile_report = argv[++i];
+		}
+		else if (arg == "--trace")
+		{
+			trace_file = argv[++i];
+		}
+		else if (arg == "--latency")
+		{
+			latency = true;
+		}
+		else if (arg == "--perf")
+		{
+			perf = true;
+		}
+		else if (arg.compare(0, 1, "-") == 0 or dt_input)
+		{
+			std::cerr << "Unknown argument " << arg << std::endl;
+			printUsage(argv[0]);
+			return -1;
+		}
+		else
+		{
+			/// The only positional argument is dt, the whole of it a positive integer
+			long value = 0;
+			if (!parseInteger(argv[i], 1, std::numeric_limits<int>::max(), value))
+			{
+				std::cerr << "Invalid dt " << arg << ", a positive integer is expected" << std::endl;
+				printUsage(argv[0]);
+				return -1;
+			}
+			dt_input = true;
+			dt_val = static_cast<int>(value);
+		}
+	}
+
+	/// Recording starts before anything is read, and before the plot workers are forked so their stages reach the report too
+#ifdef POINTONENAV_INSTRUMENT
+	if (!profile_report.empty() and STAGE_ENABLE(profile_report))
+	{
+		wait_plots = true;
+	}
+#else
+	if (!profile_report.empty())
+	{
+		std::cerr << "Built without the instrumentation (-DINSTRUMENTATION=OFF), --profile is ignored" << std::endl;
+	}
+#endif
+#ifdef POINTONENAV_TRACE
+	if (!trace_file.empty() and TRACE_ENABLE(trace_file))
+	{
+		wait_plots = true;
+		TRACE_THREAD_NAME("main");
+	}
+#else
+	if (!trace_file.empty())
+	{
+		std::cerr << "Built without tracing (-DTRACING=OFF); rebuild with -DTRACING=ON, --trace is ignored" << std::endl;
+	}
+#endif
+
+	/// The cycle counter is calibrated once, before any epoch is timed
+	if (latency)
+	{
+		cycleClock::nanosecondsPerTick();
 	}
 
 	/// Unique pointer to initialize the twoStateClockModel class pointer
 	std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(dt_input, dt_val));
+	clockModel->setInputCache(input_cache);
+	if (!input_dir.empty())
+	{
+		clockModel->setInputDir(input_dir);
+	}
+	clockModel->setHeadless(headless);
+	clockModel->setPlotDecimation(plot_points > 0 ? decimation_method::lttb : decimation_method::none, std::max(plot_points, 0L));
+
+	/// Opened on the main thread before the parser threads start, so they inherit the counters; parses from a cache sidecar are not counted
+	perfCounters parse_counters, filter_counters;
+	if (perf)
+	{
+		if (!parse_counters.open() or !filter_counters.open())
+		{
+			std::cerr << "Performance counters unavailable: " << parse_counters.why() << ", --perf is ignored" << std::endl;
+			perf = false;
+		}
+		else
+		{
+			clockModel->setParseCounters(&parse_counters);
+		}
+	}
 
   	/// read in the process filter inputs from given text files
 	clockModel->getInputData("initial_state_estimate.txt", f_in.initial_state_estimate);
 	clockModel->getInputData("initial_state_estimate_covariance.txt", f_in.initial_state_estimate_covariance);
 	clockModel->getInputData("measurement_noise_covariance.txt", f_in.measurement_noise_covariance);
 	clockModel->getInputData("process_noise_covariance.txt", f_in.process_noise_covariance);
+
+	/// In live mode the measurements arrive one epoch at a time instead of from the history file
+	if (!live_source.empty())
+	{
+		f_in.measurement_history = mat::Zero(2,1);
+		if (!clockModel->checkInputs(f_in))
+		{
+			std::cerr << "Error getting the filter input files, check the input file names and path!" << std::endl;
+			return -1;
+		}
+		if (perf)
+		{
+			std::cout << parse_counters.report("Parse", "byte") << std::endl;
+		}
+		return runLive(*clockModel, f_in, live_source, stats_every, latency);
+	}
 	clockModel->getInputData("measurement_history.txt", f_in.measurement_history);
+	if (perf)
+	{
+		std::cout << parse_counters.report("Parse", "byte") << std::endl;
+	}
 
 	/// Check to make sure all the filter input files are loaded in
 	if (clockModel->checkInputs(f_in))
@@ -105,42 +499,124 @@ int main(int argc, char** argv)
 		}	
 		xcov_hist[0] = f_in.initial_state_estimate_covariance;
 
+		/// NIS consistency, updated every epoch: two-sided bounds at alpha = 0.1, the upper one is the 95% threshold of the NIS plot
+		filterStats nis_stats(2, 0.1, 100);
+		latencyHistogram step_latency;
+
 		/// Main algorithm that performs estimation using EKF
+		STAGE_BEGIN(filter_stage, "filter", "measurement_history.txt");
+		TRACE_BATCHES(filter_trace, "simpleEKF batch", "filter", n);
+		filter_counters.start();
 		for (auto kp1=0; kp1<n; kp1++)
 		{
+			TRACE_ITERATION(filter_trace, kp1);
+
 			/// Measurement vector 
 			mat y_kp1 = f_in.measurement_history.col(kp1);
 
 			/// Extended Kalman Filter algorithm to update states and covariance 
+			const std::uint64_t step_start = latency ? cycleClock::now() : 0;
 			clockModel->simpleEKF(xk_est, xcovk_est, w_k, clock_noise_cov, y_kp1, v_kp1, measurement_cov);
+			if (latency)
+			{
+				step_latency.recordTicks(step_start, cycleClock::now());
+			}
 
 			/// Assign the filter algorithm output 
 			xhat_hist.col(kp1+1) = clockModel->get_xkp1();
 			xcov_hist.at(kp1+1) = clockModel->get_xcov_kp1();
 			mat temp = (clockModel->get_zkp1().transpose()) * ((clockModel->get_skp1()).inverse() * clockModel->get_zkp1());
 			nis_hist(0, kp1+1) = temp(0); 
+			nis_stats.add(temp(0));
+			if (stats_every > 0 and (kp1+1) % stats_every == 0)
+			{
+				printStats(nis_stats, kp1+1);
+				if (latency)
+				{
+					printLatency("Filter step", step_latency);
+				}
+			}
 
 			/// Passed on to the next loop iteration		
 			xk_est = clockModel->get_xkp1();
 			xcovk_est = clockModel->get_xcov_kp1();	
 		}
+		filter_counters.stop(n);
+		TRACE_ITERATION(filter_trace, n);
+		STAGE_END(filter_stage, n);
 
-		/// Write the output values to file; read them and add into vector containers for plotting
-		std::vector<std::vector<double> > xhat_hist_values, nis_hist_values;
-		clockModel->getVectorValues(xhat_hist, "filter_output.txt", xhat_hist_values);
-		clockModel->getVectorValues(nis_hist, "nis_hist.txt", nis_hist_values);
+		printStats(nis_stats, n);
+		if (latency)
+		{
+			printLatency("Filter step", step_latency);
+		}
+		if (perf)
+		{
+			std::cout << filter_counters.report("Filter loop", "epoch") << std::endl;
+		}
 
-		/// Generate y values, running from 0 to size of output vectors
-		std::vector<double> y(n+1);
-		std::iota(std::begin(y), std::end(y), 0);
+		/// Write the output values to file; they are on disk before the plot workers start, so the outputs are complete once main returns
+		clockModel->setSyncOutputs(true);
+		clockModel->writeToFile("filter_output.txt", xhat_hist);
+		clockModel->writeToFile("nis_hist.txt", nis_hist);
 
-		/// Chi-squared inverse cumulative distribution with 2 degrees of freedom with alpha = 0.05; gamma_high = chi2inv(1-alpha)
-		float gamma_high = 5.9915;	
+		/// Bias, rate and NIS at full resolution with their min/max/mean pyramid, for zooming into long runs (tools/pyramidQuery.cpp);
+		/// the epochs are dt_val apart, the time step the model was built with
+		clockModel->writePyramid("filter_output.p1pyr", {&xhat_hist, &nis_hist}, 0.0, dt_val);
 
-		/// Generate, show and save the plots of the filter outputs using matplotlib-cpp library 
-		clockModel->matPlot(xhat_hist_values[0], y, "Bias_estimate", "Receiver time, s", "Clock bias estimate, m", 0.0);
-		clockModel->matPlot(xhat_hist_values[1], y, "Rate_estimate", "Receiver time, s", "Clock rate estimate, m/s", 0.0);
-		clockModel->matPlot(nis_hist_values[0], y, "NIS_filter_residual_plot", " ", " ", gamma_high);
+#ifndef POINTONENAV_NO_PLOT
+		/// Python is only started by the plot workers, so with "--no-plot" the filter returns as soon as the outputs are written
+		if (plots)
+		{
+			/// Chi-squared inverse cumulative distribution with 2 degrees of freedom with alpha = 0.05; gamma_high = chi2inv(1-alpha)
+			float gamma_high = nis_stats.upperBound();
+
+			/// State variances, the diagonal of xcov_hist read in place: the 2x2 matrices are stored one after the other, 4 values apart.
+			/// The bias and rate plots show the +-2 sigma envelope, about the same 95% as the NIS threshold
+			const double k_sigma = 2.0;
+			const double* xcov = xcov_hist.front().data();
+			Eigen::Map<const Eigen::RowVectorXd, 0, Eigen::InnerStride<4> > bias_variance(xcov, n+1), rate_variance(xcov + 3, n+1);
+
+			/// Generate, show and save the plots of the filter outputs using matplotlib-cpp library; the history rows are plotted in place
+			/// against the receiver time, running from 0 to n*dt_val. Every figure is rendered by a worker process of its own, all at the same
+			/// time; a figure that is not saved fails its worker
+			plotWorkers workers;
+			workers.spawn([&]()
+			{
+				if (!clockModel->matPlot(xhat_hist.row(0), bias_variance, k_sigma, 0.0, dt_val, "Bias_estimate", "Receiver time, s", "Clock bias estimate, m"))
+				{
+					throw std::runtime_error("Bias_estimate not saved");
+				}
+			});
+			workers.spawn([&]()
+			{
+				if (!clockModel->matPlot(xhat_hist.row(1), rate_variance, k_sigma, 0.0, dt_val, "Rate_estimate", "Receiver time, s", "Clock rate estimate, m/s"))
+				{
+					throw std::runtime_error("Rate_estimate not saved");
+				}
+			});
+			workers.spawn([&]()
+			{
+				if (!clockModel->matPlot(nis_hist.row(0), 0.0, dt_val, "NIS_filter_residual_plot", " ", " ", gamma_high))
+				{
+					throw std::runtime_error("NIS_filter_residual_plot not saved");
+				}
+			});
+
+			/// Shown windows stay open until the user closes them, so the workers are waited for; saved plots finish in the background
+			if ((wait_plots or !headless) and !workers.wait())
+			{
+				std::cerr << "Error rendering the plots!" << std::endl;
+				return -1;
+			}
+		}
+#endif
+
+		/// The plot workers are waited for when profiling or tracing, their stages and spans are in the report and the trace
+		if (!STAGE_REPORT(n) or !TRACE_DUMP())
+		{
+			return -1;
+		}
 	}
 	else
 	{
@@ -12,6 +12,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <cstdint> // <cstdint> requires c++11 support
+#include <cstdlib> // std::strtod
 #include <functional>
 
 #ifndef WITHOUT_NUMPY
@@ -351,6 +352,25 @@ PyObject* get_2darray(const std::vector<::std::vector<Numeric>>& v)
     return reinterpret_cast<PyObject *>(varray);
 }
 
+// Wrap n strided values in the caller's memory without copying them; stride is in elements.
+// Like get_array(std::vector), the memory has to stay alive until the figure is saved, shown or closed.
+template<typename Numeric>
+PyObject* get_array(const Numeric* data, size_t n, std::ptrdiff_t stride)
+{
+    NPY_TYPES type = select_npy_type<Numeric>::type;
+    if (type == NPY_NOTYPE) throw std::runtime_error("get_array: unsupported element type");
+
+    npy_intp dims = static_cast<npy_intp>(n);
+    npy_intp strides = static_cast<npy_intp>(stride * static_cast<std::ptrdiff_t>(sizeof(Numeric)));
+    return PyArray_New(&PyArray_Type, 1, &dims, type, &strides, const_cast<Numeric*>(data), 0, NPY_ARRAY_ALIGNED, NULL);
+}
+
+// numpy.arange(start, start + n*step, step), built by numpy instead of a std::vector
+inline PyObject* get_arange(double start, double step, size_t n)
+{
+    return PyArray_Arange(start, start + step * (static_cast<double>(n) - 0.5), step, NPY_DOUBLE);
+}
+
 #else // fallback if we don't have numpy: copy every element of the given vector
 
 template<typename Numeric>
@@ -363,6 +383,25 @@ PyObject* get_array(const std::vector<Numeric>& v)
     return list;
 }
 
+template<typename Numeric>
+PyObject* get_array(const Numeric* data, size_t n, std::ptrdiff_t stride)
+{
+    PyObject* list = PyList_New(n);
+    for(size_t i = 0; i < n; ++i) {
+        PyList_SetItem(list, i, PyFloat_FromDouble(data[i * stride]));
+    }
+    return list;
+}
+
+inline PyObject* get_arange(double start, double step, size_t n)
+{
+    PyObject* list = PyList_New(n);
+    for(size_t i = 0; i < n; ++i) {
+        PyList_SetItem(list, i, PyFloat_FromDouble(start + step * i));
+    }
+    return list;
+}
+
 #endif // WITHOUT_NUMPY
 
 // sometimes, for labels and such, we need string arrays
@@ -692,10 +731,14 @@ bool fill_between(const std::vector<Numeric>& x, const std::vector<Numeric>& y1,
     PyTuple_SetItem(args, 1, y1array);
     PyTuple_SetItem(args, 2, y2array);
 
-    // construct keyword args
+    // construct keyword args; numbers such as alpha or linewidth are passed as floats, matplotlib rejects them as strings
     PyObject* kwargs = PyDict_New();
     for(std::map<std::string, std::string>::const_iterator it = keywords.begin(); it != keywords.end(); ++it) {
-        PyDict_SetItemString(kwargs, it->first.c_str(), PyUnicode_FromString(it->second.c_str()));
+        char* end = nullptr;
+        double number = std::strtod(it->second.c_str(), &end);
+        PyObject* value = (!it->second.empty() && *end == '\0') ? PyFloat_FromDouble(number) : PyUnicode_FromString(it->second.c_str());
+        PyDict_SetItemString(kwargs, it->first.c_str(), value);
+        Py_DECREF(value);
     }
 
     PyObject* res = PyObject_Call(detail::_interpreter::get().s_python_function_fill_between, args, kwargs);
@@ -1038,6 +1081,62 @@ bool plot(const std::vector<NumericX>& x, const std::vector<NumericY>& y, const
     return res;
 }
 
+/// Evenly spaced x values start, start + step, ... described without storing them, see plot(const arange&, ...)
+struct arange
+{
+    double start;
+    double step;
+    arange(double start_ = 0.0, double step_ = 1.0) : start(start_), step(step_) {}
+};
+
+namespace detail {
+
+inline bool plot_arrays(PyObject* xarray, PyObject* yarray, const std::string& s)
+{
+    PyObject* pystring = PyString_FromString(s.c_str());
+
+    PyObject* plot_args = PyTuple_New(3);
+    PyTuple_SetItem(plot_args, 0, xarray);
+    PyTuple_SetItem(plot_args, 1, yarray);
+    PyTuple_SetItem(plot_args, 2, pystring);
+
+    PyObject* res = PyObject_CallObject(detail::_interpreter::get().s_python_function_plot, plot_args);
+
+    Py_DECREF(plot_args);
+    if(res) Py_DECREF(res);
+
+    return res;
+}
+
+} // namespace detail
+
+/// Plot n strided values in the caller's memory without copying them (strides in elements),
+/// e.g. the rows of a column-major matrix. The memory has to stay alive until the figure is saved, shown or closed.
+template<typename NumericX, typename NumericY>
+bool plot(const NumericX* x, std::ptrdiff_t x_stride, const NumericY* y, std::ptrdiff_t y_stride, size_t n, const std::string& s = "")
+{
+    detail::_interpreter::get();
+
+    return detail::plot_arrays(detail::get_array(x, n, x_stride), detail::get_array(y, n, y_stride), s);
+}
+
+/// Plot n strided values against evenly spaced x values, neither of them copied into a std::vector
+template<typename Numeric>
+bool plot(const arange& x, const Numeric* y, std::ptrdiff_t y_stride, size_t n, const std::string& s = "")
+{
+    detail::_interpreter::get();
+
+    return detail::plot_arrays(detail::get_arange(x.start, x.step, n), detail::get_array(y, n, y_stride), s);
+}
+
+#ifdef EIGEN_WORLD_VERSION
+/// Plot a row of an Eigen matrix in place, e.g. plot(arange(), xhat_hist.row(0))
+inline bool plot(const arange& x, const Eigen::Ref<const Eigen::RowVectorXd, 0, Eigen::InnerStride<> >& y, const std::string& s = "")
+{
+    return plot(x, y.data(), y.innerStride(), static_cast<size_t>(y.size()), s);
+}
+#endif
+
 template<typename NumericX, typename NumericY, typename NumericU, typename NumericW>
 bool quiver(const std::vector<NumericX>& x, const std::vector<NumericY>& y, const std::vector<NumericU>& u, const std::vector<NumericW>& w, const std::map<std::string, std::string>& keywords = {})
 {
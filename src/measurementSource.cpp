@@ -0,0 +1,265 @@
+#include "measurementSource.h"
+
+/// Std includes
+#include <iostream>
+#include <cstdlib> // std::strtod
+#include <cstring> // std::memmove
+#include <cerrno>
+
+/// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/**
+ * @file measurementSource.cpp
+ * @brief contains all the measurementSource member function definitions declared in .h file
+ */
+
+/// class constructor
+measurementSource::measurementSource()
+	: fd(-1), listen_fd(-1), datagram(false), end_of_stream(false), skip_line(false), buffer(1 << 16), begin(0), end(0), malformed_count(0)
+{
+}
+
+/// class destructor
+measurementSource::~measurementSource()
+{
+	close();
+}
+
+/// Open the requested source, blocking until a writer or client is there for pipes and stream sockets
+bool measurementSource::open(const std::string source)
+{
+	close();
+	this->begin = 0;
+	this->end = 0;
+	this->end_of_stream = false;
+	this->skip_line = false;
+	this->datagram = false;
+
+	if (source == "stdin" or source == "-")
+	{
+		this->fd = ::dup(STDIN_FILENO);
+	}
+	else if (source.compare(0, 5, "fifo:") == 0)
+	{
+		std::string path = source.substr(5);
+		struct stat st;
+		if (::stat(path.c_str(), &st) != 0)
+		{
+			if (::mkfifo(path.c_str(), 0600) != 0)
+			{
+				std::cerr << "Error creating the named pipe " << path << std::endl;
+				return false;
+			}
+			this->created_path = path;
+		}
+		this->fd = ::open(path.c_str(), O_RDONLY);
+	}
+	else if (source.compare(0, 5, "unix:") == 0)
+	{
+		std::string path = source.substr(5);
+		struct sockaddr_un addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		if (path.size() >= sizeof(addr.sun_path))
+		{
+			std::cerr << "Socket path too long, " << path << std::endl;
+			return false;
+		}
+		std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+		this->listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		::unlink(path.c_str());
+		if (this->listen_fd < 0 or ::bind(this->listen_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 or
+			::listen(this->listen_fd, 1) != 0)
+		{
+			std::cerr << "Error listening on the socket " << path << std::endl;
+			close();
+			return false;
+		}
+		this->created_path = path;
+		this->fd = ::accept(this->listen_fd, NULL, NULL);
+	}
+	else if (source.compare(0, 4, "udp:") == 0)
+	{
+		struct sockaddr_in addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(static_cast<uint16_t>(std::atoi(source.substr(4).c_str())));
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		this->fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+		if (this->fd >= 0 and ::bind(this->fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0)
+		{
+			::close(this->fd);
+			this->fd = -1;
+		}
+		this->datagram = true;
+	}
+	else
+	{
+		std::cerr << "Unknown measurement source " << source << ", use stdin, fifo:<path>, unix:<path> or udp:<port>" << std::endl;
+		return false;
+	}
+
+	if (this->fd < 0)
+	{
+		std::cerr << "Error opening the measurement source " << source << std::endl;
+		close();
+		return false;
+	}
+	return true;
+}
+
+/// Read whatever is available into the free end of the buffer
+bool measurementSource::fill()
+{
+	if (this->end_of_stream or this->fd < 0)
+	{
+		return false;
+	}
+
+	/// Move the unparsed tail to the front; a line that fills the whole buffer is dropped, along with the rest of it still to come
+	if (this->begin > 0)
+	{
+		std::memmove(&this->buffer[0], &this->buffer[this->begin], this->end - this->begin);
+		this->end -= this->begin;
+		this->begin = 0;
+	}
+	if (this->end + 1 >= this->buffer.size())
+	{
+		if (!this->skip_line)
+		{
+			this->malformed_count++;
+		}
+		this->skip_line = true;
+		this->end = 0;
+	}
+
+	while (true)
+	{
+		/// Leave room to terminate a datagram that does not end with a newline
+		ssize_t n = ::read(this->fd, &this->buffer[this->end], this->buffer.size() - this->end - 1);
+		if (n < 0 and errno == EINTR)
+		{
+			continue;
+		}
+		if (n <= 0)
+		{
+			/// A last line without a newline is still a line, terminated in the byte kept free for it
+			this->end_of_stream = true;
+			if (this->end > 0 and !this->skip_line)
+			{
+				this->buffer[this->end++] = '\n';
+				return true;
+			}
+			return false;
+		}
+
+		this->arrival = std::chrono::steady_clock::now();
+		this->end += n;
+		if (this->datagram and this->buffer[this->end - 1] != '\n')
+		{
+			this->buffer[this->end++] = '\n';
+		}
+		return true;
+	}
+}
+
+/// Parse the next complete line holding two values
+bool measurementSource::next(Eigen::Vector2d& y_kp1)
+{
+	while (true)
+	{
+		char* line = &this->buffer[this->begin];
+		char* newline = static_cast<char*>(std::memchr(line, '\n', this->end - this->begin));
+		if (newline == NULL)
+		{
+			if (!fill())
+			{
+				return false;
+			}
+			continue;
+		}
+
+		*newline = '\0';
+		this->begin = newline - &this->buffer[0] + 1;
+		if (this->skip_line)
+		{
+			this->skip_line = false;
+			continue;
+		}
+
+		/// Values may be separated by spaces, tabs or a comma
+		char* p = line;
+		char* parsed = NULL;
+		int count = 0;
+		while (count < 2)
+		{
+			while (*p == ' ' or *p == '\t' or *p == ',')
+			{
+				p++;
+			}
+			y_kp1(count) = std::strtod(p, &parsed);
+			if (parsed == p)
+			{
+				break;
+			}
+			p = parsed;
+			count++;
+		}
+
+		if (count == 2)
+		{
+			return true;
+		}
+
+		/// Blank lines are skipped silently
+		while (*line == ' ' or *line == '\t' or *line == '\r')
+		{
+			line++;
+		}
+		if (*line != '\0')
+		{
+			this->malformed_count++;
+		}
+	}
+}
+
+/// Close the source and remove the pipe or socket file created by open
+void measurementSource::close()
+{
+	if (this->fd >= 0)
+	{
+		::close(this->fd);
+		this->fd = -1;
+	}
+	if (this->listen_fd >= 0)
+	{
+		::close(this->listen_fd);
+		this->listen_fd = -1;
+	}
+	if (!this->created_path.empty())
+	{
+		::unlink(this->created_path.c_str());
+		this->created_path.clear();
+	}
+}
+
+/// Return the time the last epoch was received
+std::chrono::steady_clock::time_point measurementSource::arrivalTime() const
+{
+	return this->arrival;
+}
+
+/// Return the number of skipped lines
+std::uint64_t measurementSource::malformed() const
+{
+	return this->malformed_count;
+}
@@ -0,0 +1,105 @@
+#ifndef MEASUREMENT_SOURCE_H
+#define MEASUREMENT_SOURCE_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+/// Eigen includes
+#include <Eigen/Dense>
+
+/**
+ * @file measurementSource.h
+ * @brief contains the declaration of the live measurement source, used to run the filter one epoch at a time as measurements arrive
+ */
+
+/**
+ * @brief The measurementSource class reads measurements one epoch at a time from stdin, a named pipe or a local socket,
+ * one line "clock_bias clock_rate" per epoch (space or comma separated), parsing each line as soon as it is complete
+ *
+ * Sources:
+ * - "stdin" or "-": the standard input
+ * - "fifo:<path>": a named pipe, created if it does not exist
+ * - "unix:<path>": a Unix-domain stream socket listening at the path, the first client to connect is read
+ * - "udp:<port>": a UDP socket bound to 127.0.0.1, one or more lines per datagram, an empty datagram ends the stream
+ */
+class measurementSource
+{
+private:
+	/// Descriptor read from, and the listening socket for "unix:"
+	int fd;
+	int listen_fd;
+
+	/// Datagram sockets deliver whole messages, an empty one ends the stream
+	bool datagram;
+	bool end_of_stream;
+
+	/// The rest of a line longer than the buffer is discarded up to its newline
+	bool skip_line;
+
+	/// Paths created by open and removed again by close
+	std::string created_path;
+
+	/// Receive buffer, bytes [begin, end) are not parsed yet
+	std::vector<char> buffer;
+	std::size_t begin;
+	std::size_t end;
+
+	/// Time the bytes of the current line were received
+	std::chrono::steady_clock::time_point arrival;
+
+	/// Lines skipped because they did not hold two values
+	std::uint64_t malformed_count;
+
+	/**
+	 * @brief fill read more bytes into the buffer, blocking until some are available
+	 * @return boolean value, false at the end of the stream
+	 */
+	bool fill();
+
+public:
+	/**
+	 * @brief measurementSource class constructor
+	 */
+	measurementSource();
+
+	/**
+	 * @brief ~measurementSource class destructor, closes the source
+	 */
+	~measurementSource();
+
+	/**
+	 * @brief open start reading from the given source
+	 * @param source "stdin", "fifo:<path>", "unix:<path>" or "udp:<port>"
+	 * @return boolean value
+	 */
+	bool open(const std::string source);
+
+	/**
+	 * @brief next wait for the next epoch and parse it
+	 * @param y_kp1 measurement vector [clock bias, clock rate] of the epoch
+	 * @return boolean value, false at the end of the stream
+	 */
+	bool next(Eigen::Vector2d& y_kp1);
+
+	/**
+	 * @brief close stop reading and remove any socket or pipe created by open
+	 */
+	void close();
+
+	/**
+	 * @brief arrivalTime getter function for the time the last epoch returned by next was received
+	 * @return time point on the steady clock
+	 */
+	std::chrono::steady_clock::time_point arrivalTime() const;
+
+	/**
+	 * @brief malformed getter function for the number of lines skipped because they did not hold two values
+	 * @return number of skipped lines
+	 */
+	std::uint64_t malformed() const;
+};
+
+#endif // MEASUREMENT_SOURCE_H
@@ -0,0 +1,170 @@
+#ifndef NATIVE_PLOT_H
+#define NATIVE_PLOT_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @file nativePlot.h
+ * @brief contains the declaration of the self-contained plot renderer, used instead of matplotlib when Python is not wanted
+ */
+
+/**
+ * @brief The nativePlot class renders a single figure of line series with a title and axis labels, and writes it as PNG or SVG
+ * without any external library. It covers what matPlot draws: the filter output series, a threshold line, confidence envelopes,
+ * the title and axis labels.
+ */
+class nativePlot
+{
+private:
+	/// One line series, color as 0xRRGGBB
+	struct series
+	{
+		std::vector<double> x;
+		std::vector<double> y;
+		std::uint32_t color;
+	};
+
+	std::vector<series> lines;
+
+	/// One filled band between two curves, drawn below the lines like matplotlib's fill_between
+	struct band
+	{
+		std::vector<double> x;
+		std::vector<double> lower;
+		std::vector<double> upper;
+		std::uint32_t color;
+		double alpha;
+	};
+
+	std::vector<band> bands;
+	std::string title_text;
+	std::string xlabel_text;
+	std::string ylabel_text;
+
+	/// Figure size in pixels
+	int width;
+	int height;
+
+	/// Position in the default color cycle, only series without a color of their own take the next color; bands have their own cycle
+	unsigned next_color;
+	unsigned next_fill_color;
+
+	/// Layout of the figure, computed before rendering
+	struct layout
+	{
+		double x_min, x_max, y_min, y_max;
+		double x_step, y_step;
+		std::vector<double> x_ticks, y_ticks;
+		std::vector<std::string> x_labels, y_labels;
+		int left, right, top, bottom;
+	};
+
+	/**
+	 * @brief computeLayout data limits, ticks and plot area margins of the figure
+	 * @return layout of the figure
+	 */
+	layout computeLayout() const;
+
+	/**
+	 * @brief niceTicks tick positions at multiples of 1, 2 or 5 times a power of ten inside the given range
+	 * @param lo lower end of the range
+	 * @param hi upper end of the range
+	 * @param step holds the tick spacing
+	 * @return tick positions
+	 */
+	static std::vector<double> niceTicks(const double lo, const double hi, double& step);
+
+	/**
+	 * @brief tickLabel format a tick value with as many decimals as the tick spacing needs
+	 * @param value the tick value
+	 * @param step the tick spacing
+	 * @return label text
+	 */
+	static std::string tickLabel(const double value, const double step);
+
+	/**
+	 * @brief parseColor color of a matplotlib format string such as "r-", the default line color otherwise
+	 * @param format the format string
+	 * @return color as 0xRRGGBB
+	 */
+	static std::uint32_t parseColor(const std::string& format);
+
+public:
+	/**
+	 * @brief nativePlot class constructor
+	 * @param width_px figure width in pixels
+	 * @param height_px figure height in pixels
+	 */
+	nativePlot(const int width_px = 640, const int height_px = 480);
+
+	/**
+	 * @brief plot add a line series to the figure
+	 * @param x values along the x axis
+	 * @param y values along the y axis, same length as x
+	 * @param format matplotlib style format string, only the color letter is used ("b", "g", "r", "c", "m", "y", "k")
+	 * @return boolean value, false if x and y differ in length
+	 */
+	bool plot(const std::vector<double>& x, const std::vector<double>& y, const std::string& format = "");
+
+	/**
+	 * @brief fillBetween add a filled band between two curves, such as a confidence envelope
+	 * @param x values along the x axis, increasing
+	 * @param lower values of the lower curve, same length as x
+	 * @param upper values of the upper curve, same length as x
+	 * @param format matplotlib style format string, only the color letter is used
+	 * @param alpha opacity of the fill
+	 * @return boolean value, false if the vectors differ in length
+	 */
+	bool fillBetween(const std::vector<double>& x, const std::vector<double>& lower, const std::vector<double>& upper,
+		const std::string& format = "", const double alpha = 0.3);
+
+	/**
+	 * @brief title set the title of the figure
+	 * @param text the title
+	 */
+	void title(const std::string& text);
+
+	/**
+	 * @brief xlabel set the x axis label
+	 * @param text the label
+	 */
+	void xlabel(const std::string& text);
+
+	/**
+	 * @brief ylabel set the y axis label
+	 * @param text the label
+	 */
+	void ylabel(const std::string& text);
+
+	/**
+	 * @brief save write the figure to file, the format is chosen by the file extension (.png or .svg)
+	 * @param file_name path of the output file
+	 * @return boolean value
+	 */
+	bool save(const std::string& file_name) const;
+
+	/**
+	 * @brief savePNG write the figure as a PNG image
+	 * @param file_name path of the output file
+	 * @return boolean value
+	 */
+	bool savePNG(const std::string& file_name) const;
+
+	/**
+	 * @brief saveSVG write the figure as an SVG drawing
+	 * @param file_name path of the output file
+	 * @return boolean value
+	 */
+	bool saveSVG(const std::string& file_name) const;
+
+	/**
+	 * @brief clear remove all series and texts, to start a new figure
+	 */
+	void clear();
+};
+
+#include "nativePlot.hpp"
+#endif // NATIVE_PLOT_H
@@ -0,0 +1,913 @@
+#ifndef NATIVE_PLOT_HPP
+#define NATIVE_PLOT_HPP
+
+#include "nativePlot.h"
+
+/// Std includes
+#include <cmath>
+#include <cstdio>  // std::snprintf
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+/**
+ * @file nativePlot.hpp
+ * @brief contains all the nativePlot member function definitions declared in .h file
+ */
+
+/// 5x7 bitmap font for the printable ASCII characters, one byte per column, least significant bit at the top
+static const unsigned char plot_font[95][5] = {
+	{0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14}, // ' ' ! " #
+	{0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00}, // $ % & '
+	{0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x08,0x2A,0x1C,0x2A,0x08}, {0x08,0x08,0x3E,0x08,0x08}, // ( ) * +
+	{0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02}, // , - . /
+	{0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31}, // 0 1 2 3
+	{0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03}, // 4 5 6 7
+	{0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00}, // 8 9 : ;
+	{0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06}, // < = > ?
+	{0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22}, // @ A B C
+	{0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A}, // D E F G
+	{0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, // H I J K
+	{0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E}, // L M N O
+	{0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31}, // P Q R S
+	{0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F}, // T U V W
+	{0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00}, // X Y Z [
+	{0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40}, // \ ] ^ _
+	{0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20}, // ` a b c
+	{0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E}, // d e f g
+	{0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00}, // h i j k
+	{0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38}, // l m n o
+	{0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20}, // p q r s
+	{0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C}, // t u v w
+	{0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00}, // x y z {
+	{0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08}                               // | } ~
+};
+
+/// Width of a character cell of the font, glyph plus spacing
+static const int plot_font_advance = 6;
+
+/// Default line colors, the matplotlib "tab10" cycle
+static const std::uint32_t plot_color_cycle[10] = {
+	0x1f77b4, 0xff7f0e, 0x2ca02c, 0xd62728, 0x9467bd, 0x8c564b, 0xe377c2, 0x7f7f7f, 0xbcbd22, 0x17becf
+};
+
+/// Width of the data lines in pixels
+static const double plot_line_width = 2.0;
+
+/// Pixel width of a text at the given font scale
+static int plotTextWidth(const std::string& text, const int scale)
+{
+	return text.empty() ? 0 : static_cast<int>(text.size()) * plot_font_advance * scale - scale;
+}
+
+/// RGB raster the figure is drawn into for the PNG output
+struct plot_canvas
+{
+	int width;
+	int height;
+	std::vector<std::uint8_t> rgb;
+
+	plot_canvas(const int w, const int h)
+		: width(w), height(h), rgb(3 * static_cast<std::size_t>(w) * h, 255)
+	{
+	}
+
+	/// Blend a color over the pixel with the given coverage
+	void blend(const int x, const int y, const std::uint32_t color, const double alpha)
+	{
+		if (x < 0 or y < 0 or x >= this->width or y >= this->height or alpha <= 0.0)
+		{
+			return;
+		}
+		std::uint8_t* pixel = &this->rgb[3 * (static_cast<std::size_t>(y) * this->width + x)];
+		for (int c=0; c<3; ++c)
+		{
+			double target = (color >> (16 - 8*c)) & 0xff;
+			pixel[c] = static_cast<std::uint8_t>(pixel[c] + (target - pixel[c]) * std::min(alpha, 1.0) + 0.5);
+		}
+	}
+
+	/// Fill the rectangle [x0,x1) x [y0,y1)
+	void fillRect(const int x0, const int y0, const int x1, const int y1, const std::uint32_t color)
+	{
+		for (int y=y0; y<y1; ++y)
+		{
+			for (int x=x0; x<x1; ++x)
+			{
+				blend(x, y, color, 1.0);
+			}
+		}
+	}
+
+	/// Draw text with its top left corner at (x,y); vertical text reads bottom to top with (x,y) at its bottom left corner
+	void text(const int x, const int y, const std::string& text, const int scale, const std::uint32_t color, const bool vertical = false)
+	{
+		for (std::size_t i=0; i<text.size(); ++i)
+		{
+			int code = static_cast<unsigned char>(text[i]);
+			const unsigned char* glyph = plot_font[(code >= 32 and code < 127) ? code - 32 : '?' - 32];
+			int advance = static_cast<int>(i) * plot_font_advance * scale;
+			for (int col=0; col<5; ++col)
+			{
+				for (int row=0; row<7; ++row)
+				{
+					if (!(glyph[col] & (1 << row)))
+					{
+						continue;
+					}
+					for (int dy=0; dy<scale; ++dy)
+					{
+						for (int dx=0; dx<scale; ++dx)
+						{
+							if (vertical)
+							{
+								blend(x + row*scale + dy, y - advance - col*scale - dx, color, 1.0);
+							}
+							else
+							{
+								blend(x + advance + col*scale + dx, y + row*scale + dy, color, 1.0);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+};
+
+/// Anti-aliased coverage of a polyline, kept separately so joints between segments are not blended twice
+struct plot_line_mask
+{
+	int x0, y0, x1, y1; /// clipping rectangle [x0,x1) x [y0,y1)
+	int stride;
+	std::vector<float> coverage;
+
+	plot_line_mask(const int left, const int top, const int right, const int bottom)
+		: x0(left), y0(top), x1(right), y1(bottom), stride(right - left),
+		  coverage(static_cast<std::size_t>(right - left) * (bottom - top), 0.0f)
+	{
+	}
+
+	/// Coverage of a segment of the given width, from the pixel distance to the segment
+	void segment(const double ax, const double ay, const double bx, const double by, const double line_width)
+	{
+		const double half = 0.5 * line_width;
+		const double dx = bx - ax;
+		const double dy = by - ay;
+		const double length_sq = dx*dx + dy*dy;
+
+		/// Bounding box of the segment, clipped in floating point so points far outside the figure do not overflow
+		int min_x = static_cast<int>(std::max<double>(this->x0, std::floor(std::min(ax, bx) - half - 1.0)));
+		int max_x = static_cast<int>(std::min<double>(this->x1 - 1, std::ceil(std::max(ax, bx) + half + 1.0)));
+		int min_y = static_cast<int>(std::max<double>(this->y0, std::floor(std::min(ay, by) - half - 1.0)));
+		int max_y = static_cast<int>(std::min<double>(this->y1 - 1, std::ceil(std::max(ay, by) + half + 1.0)));
+
+		for (int y=min_y; y<=max_y; ++y)
+		{
+			float* row = &this->coverage[static_cast<std::size_t>(y - this->y0) * this->stride];
+			for (int x=min_x; x<=max_x; ++x)
+			{
+				/// Pixel centers are at +0.5
+				double px = x + 0.5 - ax;
+				double py = y + 0.5 - ay;
+				double t = length_sq > 0.0 ? std::max(0.0, std::min(1.0, (px*dx + py*dy) / length_sq)) : 0.0;
+				double ex = px - t*dx;
+				double ey = py - t*dy;
+				double cover = half + 0.5 - std::sqrt(ex*ex + ey*ey);
+				if (cover > row[x - this->x0])
+				{
+					row[x - this->x0] = static_cast<float>(std::min(cover, 1.0));
+				}
+			}
+		}
+	}
+
+	/// Coverage of the band between the upper and lower curves over the pixel columns of [ax, bx), interpolated linearly
+	void trapezoid(const double ax, const double a_top, const double a_bottom, const double bx, const double b_top, const double b_bottom)
+	{
+		if (!(bx > ax))
+		{
+			return;
+		}
+		int min_x = static_cast<int>(std::max<double>(this->x0, std::floor(ax)));
+		int max_x = static_cast<int>(std::min<double>(this->x1 - 1, std::ceil(bx)));
+		for (int x=min_x; x<=max_x; ++x)
+		{
+			/// Columns belong to the segment their center falls in, so neighbouring segments do not cover a column twice
+			double center = x + 0.5;
+			if (center < ax or center >= bx)
+			{
+				continue;
+			}
+			double t = (center - ax) / (bx - ax);
+			double top = a_top + t * (b_top - a_top);
+			double bottom = a_bottom + t * (b_bottom - a_bottom);
+			if (top > bottom)
+			{
+				std::swap(top, bottom);
+			}
+			int min_y = static_cast<int>(std::max<double>(this->y0, std::floor(top)));
+			int max_y = static_cast<int>(std::min<double>(this->y1 - 1, std::ceil(bottom)));
+			for (int y=min_y; y<=max_y; ++y)
+			{
+				double cover = std::min<double>(y + 1, bottom) - std::max<double>(y, top);
+				float& pixel = this->coverage[static_cast<std::size_t>(y - this->y0) * this->stride + (x - this->x0)];
+				if (cover > pixel)
+				{
+					pixel = static_cast<float>(std::min(cover, 1.0));
+				}
+			}
+		}
+	}
+
+	/// Blend the line color into the canvas and clear the mask
+	void compose(plot_canvas& canvas, const std::uint32_t color, const double alpha = 1.0)
+	{
+		for (int y=this->y0; y<this->y1; ++y)
+		{
+			float* row = &this->coverage[static_cast<std::size_t>(y - this->y0) * this->stride];
+			for (int x=this->x0; x<this->x1; ++x)
+			{
+				if (row[x - this->x0] > 0.0f)
+				{
+					canvas.blend(x, y, color, alpha * row[x - this->x0]);
+					row[x - this->x0] = 0.0f;
+				}
+			}
+		}
+	}
+};
+
+/// CRC-32 of the PNG chunks
+static std::uint32_t pngCrc(const unsigned char* data, const std::size_t size, std::uint32_t crc = 0)
+{
+	static const std::vector<std::uint32_t> table = []()
+	{
+		std::vector<std::uint32_t> entries(256);
+		for (std::uint32_t n=0; n<256; ++n)
+		{
+			std::uint32_t c = n;
+			for (int k=0; k<8; ++k)
+			{
+				c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+			}
+			entries[n] = c;
+		}
+		return entries;
+	}();
+
+	crc = ~crc;
+	for (std::size_t i=0; i<size; ++i)
+	{
+		crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+/// Append a big-endian 32 bit value
+static void pngPut32(std::string& out, const std::uint32_t value)
+{
+	out.push_back(static_cast<char>(value >> 24));
+	out.push_back(static_cast<char>(value >> 16));
+	out.push_back(static_cast<char>(value >> 8));
+	out.push_back(static_cast<char>(value));
+}
+
+/// Append a PNG chunk: length, type, data and CRC over type and data
+static void pngChunk(std::string& out, const char* type, const std::string& data)
+{
+	pngPut32(out, static_cast<std::uint32_t>(data.size()));
+	std::size_t start = out.size();
+	out.append(type, 4);
+	out.append(data);
+	pngPut32(out, pngCrc(reinterpret_cast<const unsigned char*>(out.data() + start), out.size() - start));
+}
+
+/// Least significant bit first writer of a deflate stream
+struct deflate_bits
+{
+	std::string& out;
+	std::uint32_t acc;
+	int count;
+
+	explicit deflate_bits(std::string& target)
+		: out(target), acc(0), count(0)
+	{
+	}
+
+	/// Extra bits and block headers go in least significant bit first
+	void put(const std::uint32_t value, const int bits)
+	{
+		this->acc |= value << this->count;
+		this->count += bits;
+		while (this->count >= 8)
+		{
+			this->out.push_back(static_cast<char>(this->acc & 0xff));
+			this->acc >>= 8;
+			this->count -= 8;
+		}
+	}
+
+	/// Huffman codes go in most significant bit first
+	void putCode(const std::uint32_t code, const int bits)
+	{
+		std::uint32_t reversed = 0;
+		for (int i=0; i<bits; ++i)
+		{
+			reversed |= ((code >> i) & 1) << (bits - 1 - i);
+		}
+		put(reversed, bits);
+	}
+
+	/// Literal or length symbol of the fixed Huffman code
+	void putSymbol(const int symbol)
+	{
+		if (symbol < 144)
+		{
+			putCode(0x30 + symbol, 8);
+		}
+		else if (symbol < 256)
+		{
+			putCode(0x190 + symbol - 144, 9);
+		}
+		else if (symbol < 280)
+		{
+			putCode(symbol - 256, 7);
+		}
+		else
+		{
+			putCode(0xc0 + symbol - 280, 8);
+		}
+	}
+
+	/// Repeat the previous byte: a match of the given length (3 to 258) at distance 1
+	void putRepeat(const int length)
+	{
+		static const int base[29] = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+		static const int extra[29] = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+		int code = 28;
+		while (base[code] > length)
+		{
+			code--;
+		}
+		putSymbol(257 + code);
+		put(length - base[code], extra[code]);
+		putCode(0, 5); /// distance code 0, distance 1
+	}
+
+	void finish()
+	{
+		if (this->count > 0)
+		{
+			this->out.push_back(static_cast<char>(this->acc & 0xff));
+		}
+		this->acc = 0;
+		this->count = 0;
+	}
+};
+
+/// zlib stream of the data in a single fixed Huffman block, runs of equal bytes coded as distance 1 matches.
+/// With the "Up" filter on every scanline the flat background and repeated rows of a plot become long runs of zeros.
+static std::string pngDeflate(const std::vector<std::uint8_t>& data)
+{
+	std::string out;
+	out.push_back(static_cast<char>(0x78));
+	out.push_back(static_cast<char>(0x01));
+
+	deflate_bits bits(out);
+	bits.put(1, 1); /// last block
+	bits.put(1, 2); /// fixed Huffman codes
+
+	std::size_t i = 0;
+	while (i < data.size())
+	{
+		std::uint8_t value = data[i];
+		std::size_t run = 1;
+		while (i + run < data.size() and data[i + run] == value)
+		{
+			run++;
+		}
+		bits.putSymbol(value);
+		std::size_t repeat = run - 1;
+		while (repeat >= 3)
+		{
+			std::size_t length = std::min<std::size_t>(repeat, 258);
+			if (repeat - length > 0 and repeat - length < 3)
+			{
+				length = repeat - 3;
+			}
+			bits.putRepeat(static_cast<int>(length));
+			repeat -= length;
+		}
+		for (; repeat > 0; --repeat)
+		{
+			bits.putSymbol(value);
+		}
+		i += run;
+	}
+	bits.putSymbol(256); /// end of block
+	bits.finish();
+
+	/// Adler-32 of the uncompressed data
+	std::uint32_t a = 1, b = 0;
+	std::size_t k = 0;
+	while (k < data.size())
+	{
+		std::size_t block = std::min<std::size_t>(data.size() - k, 5552);
+		for (std::size_t end=k+block; k<end; ++k)
+		{
+			a += data[k];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+	pngPut32(out, (b << 16) | a);
+	return out;
+}
+
+/// Escape the characters with a meaning in XML
+static std::string svgEscape(const std::string& text)
+{
+	std::string escaped;
+	for (char c : text)
+	{
+		switch (c)
+		{
+			case '&': escaped += "&amp;"; break;
+			case '<': escaped += "&lt;"; break;
+			case '>': escaped += "&gt;"; break;
+			case '"': escaped += "&quot;"; break;
+			default: escaped.push_back(c);
+		}
+	}
+	return escaped;
+}
+
+/// SVG color notation of 0xRRGGBB
+static std::string svgColor(const std::uint32_t color)
+{
+	char text[8];
+	std::snprintf(text, sizeof(text), "#%06x", color & 0xffffff);
+	return text;
+}
+
+/// class constructor
+nativePlot::nativePlot(const int width_px, const int height_px)
+	: width(width_px), height(height_px), next_color(0), next_fill_color(0)
+{
+}
+
+/// Add a series, the color comes from the format string or the default color cycle
+bool nativePlot::plot(const std::vector<double>& x, const std::vector<double>& y, const std::string& format)
+{
+	if (x.size() != y.size())
+	{
+		std::cerr << "Error plotting, vectors must be of the same length!" << std::endl;
+		return false;
+	}
+
+	series line;
+	line.x = x;
+	line.y = y;
+	line.color = parseColor(format);
+	if (line.color > 0xffffff)
+	{
+		line.color = plot_color_cycle[this->next_color % 10];
+		this->next_color++;
+	}
+	this->lines.push_back(line);
+	return true;
+}
+
+/// Add a band, the color comes from the format string or the fill color cycle
+bool nativePlot::fillBetween(const std::vector<double>& x, const std::vector<double>& lower, const std::vector<double>& upper,
+	const std::string& format, const double alpha)
+{
+	if (x.size() != lower.size() or x.size() != upper.size())
+	{
+		std::cerr << "Error plotting, vectors must be of the same length!" << std::endl;
+		return false;
+	}
+
+	band fill;
+	fill.x = x;
+	fill.lower = lower;
+	fill.upper = upper;
+	fill.alpha = std::max(0.0, std::min(alpha, 1.0));
+	fill.color = parseColor(format);
+	if (fill.color > 0xffffff)
+	{
+		fill.color = plot_color_cycle[this->next_fill_color % 10];
+		this->next_fill_color++;
+	}
+	this->bands.push_back(fill);
+	return true;
+}
+
+void nativePlot::title(const std::string& text)
+{
+	this->title_text = text;
+}
+
+void nativePlot::xlabel(const std::string& text)
+{
+	this->xlabel_text = text;
+}
+
+void nativePlot::ylabel(const std::string& text)
+{
+	this->ylabel_text = text;
+}
+
+void nativePlot::clear()
+{
+	this->lines.clear();
+	this->bands.clear();
+	this->title_text.clear();
+	this->xlabel_text.clear();
+	this->ylabel_text.clear();
+	this->next_color = 0;
+	this->next_fill_color = 0;
+}
+
+/// Color letters of the matplotlib format strings, anything else means the default color cycle
+std::uint32_t nativePlot::parseColor(const std::string& format)
+{
+	for (char c : format)
+	{
+		switch (c)
+		{
+			case 'b': return 0x0000ff;
+			case 'g': return 0x008000;
+			case 'r': return 0xff0000;
+			case 'c': return 0x00bfbf;
+			case 'm': return 0xbf00bf;
+			case 'y': return 0xbfbf00;
+			case 'k': return 0x000000;
+			case 'w': return 0xffffff;
+			default: break;
+		}
+	}
+	return 0xffffffffu;
+}
+
+/// Tick spacing of 1, 2 or 5 times a power of ten giving at most about eight ticks
+std::vector<double> nativePlot::niceTicks(const double lo, const double hi, double& step)
+{
+	double raw = (hi - lo) / 6.0;
+	double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+	double normalized = raw / magnitude;
+	step = (normalized < 1.5 ? 1.0 : normalized < 3.0 ? 2.0 : normalized < 7.0 ? 5.0 : 10.0) * magnitude;
+
+	std::vector<double> ticks;
+	for (double k=std::ceil(lo / step); k*step <= hi + 1.0e-9 * step; k += 1.0)
+	{
+		ticks.push_back(std::fabs(k) < 0.5 ? 0.0 : k * step);
+	}
+	return ticks;
+}
+
+/// Fixed notation with the decimals of the tick spacing, scientific notation for very large or small values
+std::string nativePlot::tickLabel(const double value, const double step)
+{
+	char text[32];
+	if (std::fabs(value) >= 1.0e6 or step < 1.0e-4)
+	{
+		std::snprintf(text, sizeof(text), "%g", value);
+	}
+	else
+	{
+		int decimals = std::max(0, static_cast<int>(-std::floor(std::log10(step) + 1.0e-9)));
+		std::snprintf(text, sizeof(text), "%.*f", decimals, value);
+	}
+	return text;
+}
+
+/// Data limits with a 5% margin like matplotlib, ticks inside them and the plot area left over by the texts
+nativePlot::layout nativePlot::computeLayout() const
+{
+	const double inf = std::numeric_limits<double>::infinity();
+	double x_lo = inf, x_hi = -inf, y_lo = inf, y_hi = -inf;
+	for (auto& line : this->lines)
+	{
+		for (std::size_t i=0; i<line.x.size(); ++i)
+		{
+			if (std::isfinite(line.x[i]) and std::isfinite(line.y[i]))
+			{
+				x_lo = std::min(x_lo, line.x[i]);
+				x_hi = std::max(x_hi, line.x[i]);
+				y_lo = std::min(y_lo, line.y[i]);
+				y_hi = std::max(y_hi, line.y[i]);
+			}
+		}
+	}
+	for (auto& fill : this->bands)
+	{
+		for (std::size_t i=0; i<fill.x.size(); ++i)
+		{
+			if (std::isfinite(fill.x[i]) and std::isfinite(fill.lower[i]) and std::isfinite(fill.upper[i]))
+			{
+				x_lo = std::min(x_lo, fill.x[i]);
+				x_hi = std::max(x_hi, fill.x[i]);
+				y_lo = std::min(y_lo, std::min(fill.lower[i], fill.upper[i]));
+				y_hi = std::max(y_hi, std::max(fill.lower[i], fill.upper[i]));
+			}
+		}
+	}
+
+	auto widen = [](double& lo, double& hi)
+	{
+		if (lo > hi)
+		{
+			lo = 0.0;
+			hi = 1.0;
+		}
+		double margin = (hi > lo) ? 0.05 * (hi - lo) : (lo != 0.0 ? 0.05 * std::fabs(lo) : 1.0);
+		lo -= margin;
+		hi += margin;
+	};
+	widen(x_lo, x_hi);
+	widen(y_lo, y_hi);
+
+	layout l;
+	l.x_min = x_lo;
+	l.x_max = x_hi;
+	l.y_min = y_lo;
+	l.y_max = y_hi;
+	l.x_ticks = niceTicks(x_lo, x_hi, l.x_step);
+	l.y_ticks = niceTicks(y_lo, y_hi, l.y_step);
+
+	int label_width = 0;
+	for (double tick : l.x_ticks)
+	{
+		l.x_labels.push_back(tickLabel(tick, l.x_step));
+	}
+	for (double tick : l.y_ticks)
+	{
+		l.y_labels.push_back(tickLabel(tick, l.y_step));
+		label_width = std::max(label_width, plotTextWidth(l.y_labels.back(), 1));
+	}
+
+	/// The axes fractions of a default matplotlib figure, the left margin grows for wide tick labels
+	l.left = std::max(static_cast<int>(0.125 * this->width), 8 + 22 + label_width + 9);
+	l.right = static_cast<int>(0.9 * this->width);
+	l.top = static_cast<int>(0.12 * this->height);
+	l.bottom = static_cast<int>(0.89 * this->height);
+	return l;
+}
+
+/// Choose the format by the file extension
+bool nativePlot::save(const std::string& file_name) const
+{
+	std::size_t dot = file_name.rfind('.');
+	std::string extension = (dot == std::string::npos) ? "" : file_name.substr(dot);
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	if (extension == ".png")
+	{
+		return savePNG(file_name);
+	}
+	if (extension == ".svg")
+	{
+		return saveSVG(file_name);
+	}
+	std::cerr << "Error saving plot, unknown file format: " << file_name << std::endl;
+	return false;
+}
+
+/// Rasterize the figure and write it as an 8 bit RGB PNG
+bool nativePlot::savePNG(const std::string& file_name) const
+{
+	const layout l = computeLayout();
+	const std::uint32_t black = 0x000000;
+	plot_canvas canvas(this->width, this->height);
+
+	auto pixelX = [&l](const double x)
+	{
+		return l.left + (x - l.x_min) / (l.x_max - l.x_min) * (l.right - l.left);
+	};
+	auto pixelY = [&l](const double y)
+	{
+		return l.bottom - (y - l.y_min) / (l.y_max - l.y_min) * (l.bottom - l.top);
+	};
+
+	/// Bands below the data lines, a non-finite value leaves a gap
+	plot_line_mask mask(l.left, l.top, l.right, l.bottom);
+	for (auto& fill : this->bands)
+	{
+		for (std::size_t i=1; i<fill.x.size(); ++i)
+		{
+			if (std::isfinite(fill.x[i-1]) and std::isfinite(fill.lower[i-1]) and std::isfinite(fill.upper[i-1]) and
+				std::isfinite(fill.x[i]) and std::isfinite(fill.lower[i]) and std::isfinite(fill.upper[i]))
+			{
+				mask.trapezoid(pixelX(fill.x[i-1]), pixelY(fill.upper[i-1]), pixelY(fill.lower[i-1]),
+					pixelX(fill.x[i]), pixelY(fill.upper[i]), pixelY(fill.lower[i]));
+			}
+		}
+		mask.compose(canvas, fill.color, fill.alpha);
+	}
+
+	/// Data lines, in the order they were added
+	for (auto& line : this->lines)
+	{
+		for (std::size_t i=1; i<line.x.size(); ++i)
+		{
+			if (std::isfinite(line.x[i-1]) and std::isfinite(line.y[i-1]) and std::isfinite(line.x[i]) and std::isfinite(line.y[i]))
+			{
+				mask.segment(pixelX(line.x[i-1]), pixelY(line.y[i-1]), pixelX(line.x[i]), pixelY(line.y[i]), plot_line_width);
+			}
+		}
+		mask.compose(canvas, line.color);
+	}
+
+	/// Frame around the plot area
+	canvas.fillRect(l.left - 1, l.top - 1, l.right + 1, l.top, black);
+	canvas.fillRect(l.left - 1, l.bottom, l.right + 1, l.bottom + 1, black);
+	canvas.fillRect(l.left - 1, l.top - 1, l.left, l.bottom + 1, black);
+	canvas.fillRect(l.right, l.top - 1, l.right + 1, l.bottom + 1, black);
+
+	/// Ticks and their labels
+	for (std::size_t i=0; i<l.x_ticks.size(); ++i)
+	{
+		int x = static_cast<int>(std::floor(pixelX(l.x_ticks[i])));
+		canvas.fillRect(x, l.bottom + 1, x + 1, l.bottom + 6, black);
+		canvas.text(x - plotTextWidth(l.x_labels[i], 1) / 2, l.bottom + 9, l.x_labels[i], 1, black);
+	}
+	for (std::size_t i=0; i<l.y_ticks.size(); ++i)
+	{
+		int y = static_cast<int>(std::floor(pixelY(l.y_ticks[i])));
+		canvas.fillRect(l.left - 6, y, l.left - 1, y + 1, black);
+		canvas.text(l.left - 9 - plotTextWidth(l.y_labels[i], 1), y - 3, l.y_labels[i], 1, black);
+	}
+
+	/// Title and axis labels
+	int center_x = (l.left + l.right) / 2;
+	int center_y = (l.top + l.bottom) / 2;
+	canvas.text(center_x - plotTextWidth(this->title_text, 2) / 2, l.top - 24, this->title_text, 2, black);
+	canvas.text(center_x - plotTextWidth(this->xlabel_text, 2) / 2, l.bottom + 24, this->xlabel_text, 2, black);
+	canvas.text(8, center_y + plotTextWidth(this->ylabel_text, 2) / 2, this->ylabel_text, 2, black, true);
+
+	/// Scanlines with the "Up" filter: every byte minus the byte above it
+	const std::size_t row_bytes = 3 * static_cast<std::size_t>(this->width);
+	std::vector<std::uint8_t> filtered((row_bytes + 1) * this->height);
+	for (int y=0; y<this->height; ++y)
+	{
+		const std::uint8_t* row = &canvas.rgb[y * row_bytes];
+		std::uint8_t* out = &filtered[y * (row_bytes + 1)];
+		out[0] = 2;
+		for (std::size_t i=0; i<row_bytes; ++i)
+		{
+			out[i + 1] = static_cast<std::uint8_t>(row[i] - (y > 0 ? row[i - row_bytes] : 0));
+		}
+	}
+
+	std::string header;
+	pngPut32(header, this->width);
+	pngPut32(header, this->height);
+	header.push_back(8); /// bit depth
+	header.push_back(2); /// RGB
+	header.push_back(0); /// deflate
+	header.push_back(0); /// adaptive filtering
+	header.push_back(0); /// no interlace
+
+	std::string png("\x89PNG\r\n\x1a\n", 8);
+	pngChunk(png, "IHDR", header);
+	pngChunk(png, "IDAT", pngDeflate(filtered));
+	pngChunk(png, "IEND", std::string());
+
+	std::ofstream file_out(file_name, std::ofstream::binary | std::ofstream::trunc);
+	file_out.write(png.data(), png.size());
+	if (!file_out.good())
+	{
+		std::cerr << "Error saving plot to " << file_name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Write the figure as SVG, the data lines as polylines clipped to the plot area
+bool nativePlot::saveSVG(const std::string& file_name) const
+{
+	const layout l = computeLayout();
+	auto pixelX = [&l](const double x)
+	{
+		return l.left + (x - l.x_min) / (l.x_max - l.x_min) * (l.right - l.left);
+	};
+	auto pixelY = [&l](const double y)
+	{
+		return l.bottom - (y - l.y_min) / (l.y_max - l.y_min) * (l.bottom - l.top);
+	};
+
+	std::string svg;
+	char text[256];
+	std::snprintf(text, sizeof(text),
+		"<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n"
+		"<rect width=\"100%%\" height=\"100%%\" fill=\"#ffffff\"/>\n"
+		"<defs><clipPath id=\"plot_area\"><rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\"/></clipPath></defs>\n",
+		this->width, this->height, this->width, this->height, l.left, l.top, l.right - l.left, l.bottom - l.top);
+	svg += text;
+
+	/// Bands as polygons along the upper curve and back along the lower one, a gap of non-finite values starts a new polygon
+	for (auto& fill : this->bands)
+	{
+		std::size_t i = 0;
+		while (i < fill.x.size())
+		{
+			std::size_t end = i;
+			while (end < fill.x.size() and std::isfinite(fill.x[end]) and std::isfinite(fill.lower[end]) and std::isfinite(fill.upper[end]))
+			{
+				end++;
+			}
+			if (end - i >= 2)
+			{
+				std::snprintf(text, sizeof(text), "\" fill-opacity=\"%.3g\" stroke=\"none\" points=\"", fill.alpha);
+				svg += "<polygon clip-path=\"url(#plot_area)\" fill=\"" + svgColor(fill.color) + text;
+				for (std::size_t j=i; j<end; ++j)
+				{
+					std::snprintf(text, sizeof(text), "%.2f,%.2f ", pixelX(fill.x[j]), pixelY(fill.upper[j]));
+					svg += text;
+				}
+				for (std::size_t j=end; j-->i;)
+				{
+					std::snprintf(text, sizeof(text), "%.2f,%.2f ", pixelX(fill.x[j]), pixelY(fill.lower[j]));
+					svg += text;
+				}
+				svg += "\"/>\n";
+			}
+			i = end + 1;
+		}
+	}
+
+	/// Data lines, a gap of non-finite values starts a new polyline
+	for (auto& line : this->lines)
+	{
+		bool open = false;
+		for (std::size_t i=0; i<line.x.size(); ++i)
+		{
+			if (!std::isfinite(line.x[i]) or !std::isfinite(line.y[i]))
+			{
+				if (open)
+				{
+					svg += "\"/>\n";
+					open = false;
+				}
+				continue;
+			}
+			if (!open)
+			{
+				svg += "<polyline clip-path=\"url(#plot_area)\" fill=\"none\" stroke=\"" + svgColor(line.color) +
+					"\" stroke-width=\"2\" stroke-linejoin=\"round\" points=\"";
+				open = true;
+			}
+			std::snprintf(text, sizeof(text), "%.2f,%.2f ", pixelX(line.x[i]), pixelY(line.y[i]));
+			svg += text;
+		}
+		if (open)
+		{
+			svg += "\"/>\n";
+		}
+	}
+
+	/// Frame, ticks and their labels
+	std::snprintf(text, sizeof(text), "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"none\" stroke=\"#000000\"/>\n",
+		l.left, l.top, l.right - l.left, l.bottom - l.top);
+	svg += text;
+	svg += "<g font-family=\"sans-serif\" font-size=\"10\" fill=\"#000000\" stroke=\"#000000\">\n";
+	for (std::size_t i=0; i<l.x_ticks.size(); ++i)
+	{
+		double x = pixelX(l.x_ticks[i]);
+		std::snprintf(text, sizeof(text), "<line x1=\"%.2f\" y1=\"%d\" x2=\"%.2f\" y2=\"%d\"/><text x=\"%.2f\" y=\"%d\" stroke=\"none\" text-anchor=\"middle\">",
+			x, l.bottom, x, l.bottom + 5, x, l.bottom + 17);
+		svg += text + svgEscape(l.x_labels[i]) + "</text>\n";
+	}
+	for (std::size_t i=0; i<l.y_ticks.size(); ++i)
+	{
+		double y = pixelY(l.y_ticks[i]);
+		std::snprintf(text, sizeof(text), "<line x1=\"%d\" y1=\"%.2f\" x2=\"%d\" y2=\"%.2f\"/><text x=\"%d\" y=\"%.2f\" stroke=\"none\" text-anchor=\"end\">",
+			l.left - 5, y, l.left, y, l.left - 8, y + 3.5);
+		svg += text + svgEscape(l.y_labels[i]) + "</text>\n";
+	}
+	svg += "</g>\n";
+
+	/// Title and axis labels
+	int center_x = (l.left + l.right) / 2;
+	int center_y = (l.top + l.bottom) / 2;
+	std::snprintf(text, sizeof(text), "<g font-family=\"sans-serif\" font-size=\"14\" fill=\"#000000\" text-anchor=\"middle\">\n<text x=\"%d\" y=\"%d\">", center_x, l.top - 10);
+	svg += text + svgEscape(this->title_text) + "</text>\n";
+	std::snprintf(text, sizeof(text), "<text x=\"%d\" y=\"%d\">", center_x, l.bottom + 38);
+	svg += text + svgEscape(this->xlabel_text) + "</text>\n";
+	std::snprintf(text, sizeof(text), "<text x=\"%d\" y=\"%d\" transform=\"rotate(-90 %d %d)\">", 20, center_y, 20, center_y);
+	svg += text + svgEscape(this->ylabel_text) + "</text>\n</g>\n</svg>\n";
+
+	std::ofstream file_out(file_name, std::ofstream::trunc);
+	file_out << svg;
+	if (!file_out.good())
+	{
+		std::cerr << "Error saving plot to " << file_name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+#endif // NATIVE_PLOT_HPP
@@ -0,0 +1,385 @@
+#include "outputPyramid.h"
+
+/// Std includes
+#include <cmath>
+#include <cstring> // std::memcmp
+#include <limits>
+#include <iostream>
+#include <algorithm>
+
+/// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @file outputPyramid.cpp
+ * @brief contains all the outputPyramid member function definitions declared in .h file
+ */
+
+static const char pyramid_magic[8] = {'P', '1', 'P', 'Y', 'R', 'A', 'M', 'D'};
+static const std::uint32_t pyramid_version = 1;
+
+/// Levels start on a cache line boundary
+static std::uint64_t pyramidAlign(const std::uint64_t offset)
+{
+	return (offset + 63) / 64 * 64;
+}
+
+/// Write the whole range at the given offset, short writes are continued
+static bool pyramidWriteAt(const int fd, const char* data, const std::size_t size, const std::uint64_t offset)
+{
+	std::size_t written = 0;
+	while (written < size)
+	{
+		ssize_t n = ::pwrite(fd, data + written, size - written, offset + written);
+		if (n <= 0)
+		{
+			return false;
+		}
+		written += n;
+	}
+	return true;
+}
+
+/// Fold one summary (min, max, mean of count finite values) into another
+static void pyramidMerge(double* into, std::uint64_t& into_count, const double* from, const std::uint64_t from_count)
+{
+	if (from_count == 0)
+	{
+		return;
+	}
+	if (into_count == 0)
+	{
+		into[0] = from[0];
+		into[1] = from[1];
+		into[2] = from[2];
+	}
+	else
+	{
+		into[0] = std::min(into[0], from[0]);
+		into[1] = std::max(into[1], from[1]);
+		into[2] = (into[2] * into_count + from[2] * from_count) / (into_count + from_count);
+	}
+	into_count += from_count;
+}
+
+/**
+ * @brief pyramid_carry struct is a summary level built while the samples are read: the bucket being filled from the level
+ * below, and the finished records held until a chunk of them is written at their place in the level
+ */
+struct pyramid_carry
+{
+	std::vector<double> bucket;         /// (min, max, mean) per channel
+	std::vector<std::uint64_t> counts;  /// finite values per channel
+	unsigned children;                  /// samples or records of the level below in the bucket, two make a record
+	std::vector<double> records;
+	std::uint64_t held;                 /// finished records in records
+	std::uint64_t written;              /// records of the level already in the file
+};
+
+/// Write the records a level holds after the ones already written
+static bool pyramidFlush(const int fd, const pyramid_level& level, pyramid_carry& carry, const std::size_t record_size)
+{
+	bool ok = pyramidWriteAt(fd, reinterpret_cast<const char*>(carry.records.data()), carry.held * record_size,
+		level.offset + carry.written * record_size);
+	carry.written += carry.held;
+	carry.held = 0;
+	return ok;
+}
+
+/// Close the bucket of a level: hold it as a record and fold it into the bucket of the next level, which is closed in turn
+/// when it has both halves; the records are written once a chunk of them is held
+static bool pyramidClose(const int fd, const std::vector<pyramid_level>& table, std::vector<pyramid_carry>& carry,
+	const std::size_t level, const std::size_t channels)
+{
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	pyramid_carry& current = carry[level];
+	std::copy(current.bucket.begin(), current.bucket.end(), current.records.begin() + current.held * 3 * channels);
+	current.held++;
+
+	bool ok = true;
+	if (level + 1 < table.size())
+	{
+		pyramid_carry& next = carry[level + 1];
+		for (std::size_t c=0; c<channels; ++c)
+		{
+			pyramidMerge(&next.bucket[3 * c], next.counts[c], &current.bucket[3 * c], current.counts[c]);
+		}
+		if (++next.children == 2)
+		{
+			ok = pyramidClose(fd, table, carry, level + 1, channels);
+		}
+	}
+	if (current.held * 3 * channels == current.records.size())
+	{
+		ok = pyramidFlush(fd, table[level], current, 3 * channels * sizeof(double)) and ok;
+	}
+
+	std::fill(current.bucket.begin(), current.bucket.end(), nan);
+	std::fill(current.counts.begin(), current.counts.end(), 0);
+	current.children = 0;
+	return ok;
+}
+
+/// class constructor
+outputPyramid::outputPyramid()
+	: fd(-1)
+{
+	std::memset(&this->header, 0, sizeof(this->header));
+}
+
+/// class destructor
+outputPyramid::~outputPyramid()
+{
+	this->close();
+}
+
+std::size_t outputPyramid::recordSize(const std::uint32_t level) const
+{
+	return (level == 0 ? 1 : 3) * this->header.channels * sizeof(double);
+}
+
+/// Level 0 is copied from the histories in chunks and the summary levels are built in the same pass, each from the one below;
+/// every level holds one bucket and a chunk of records, written at their offset, so the memory does not grow with the run
+bool outputPyramid::write(const std::string file_name, const std::vector<const Eigen::MatrixXd*> histories, const double t0, const double dt,
+	const bool sync)
+{
+	/// Every row of every history is a channel, column-major: the values of a row are rows() apart
+	std::vector<const double*> channel_data;
+	std::vector<std::ptrdiff_t> channel_stride;
+	const std::uint64_t n = histories.empty() ? 0 : histories.front()->cols();
+	for (const Eigen::MatrixXd* history : histories)
+	{
+		if (static_cast<std::uint64_t>(history->cols()) != n)
+		{
+			std::cerr << "Error writing the output pyramid, the histories differ in length!" << std::endl;
+			return false;
+		}
+		for (Eigen::Index r=0; r<history->rows(); ++r)
+		{
+			channel_data.push_back(history->data() + r);
+			channel_stride.push_back(history->rows());
+		}
+	}
+	const std::size_t channels = channel_data.size();
+	if (n == 0 or channels == 0 or !(dt > 0.0))
+	{
+		std::cerr << "Error writing the output pyramid, nothing to write!" << std::endl;
+		return false;
+	}
+
+	pyramid_header head;
+	std::memset(&head, 0, sizeof(head));
+	std::memcpy(head.magic, pyramid_magic, sizeof(pyramid_magic));
+	head.version = pyramid_version;
+	head.channels = static_cast<std::uint32_t>(channels);
+	head.epochs = n;
+	head.t0 = t0;
+	head.dt = dt;
+
+	/// Halve until a single record is left
+	std::vector<pyramid_level> table;
+	table.push_back({1, n, 0});
+	while (table.back().count > 1)
+	{
+		std::uint64_t factor = table.back().factor * 2;
+		table.push_back({factor, (n + factor - 1) / factor, 0});
+	}
+	head.levels = static_cast<std::uint32_t>(table.size());
+
+	std::uint64_t offset = pyramidAlign(sizeof(head) + table.size() * sizeof(pyramid_level));
+	for (std::size_t level=0; level<table.size(); ++level)
+	{
+		table[level].offset = offset;
+		offset = pyramidAlign(offset + table[level].count * (level == 0 ? 1 : 3) * channels * sizeof(double));
+	}
+
+	std::string temp_name = file_name + ".tmp." + std::to_string(::getpid());
+	int out = ::open(temp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (out < 0)
+	{
+		std::cerr << "Error writing the output pyramid to " << file_name << std::endl;
+		return false;
+	}
+
+	bool ok = pyramidWriteAt(out, reinterpret_cast<const char*>(&head), sizeof(head), 0) and
+		pyramidWriteAt(out, reinterpret_cast<const char*>(table.data()), table.size() * sizeof(pyramid_level), sizeof(head));
+
+	/// Summary levels, a finite sample is a summary of one value
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	const std::uint64_t summary_chunk = 1024;
+	std::vector<pyramid_carry> carry(table.size());
+	for (std::size_t level=1; level<table.size(); ++level)
+	{
+		carry[level].bucket.assign(3 * channels, nan);
+		carry[level].counts.assign(channels, 0);
+		carry[level].children = 0;
+		carry[level].records.resize(std::min(summary_chunk, table[level].count) * 3 * channels);
+		carry[level].held = 0;
+		carry[level].written = 0;
+	}
+
+	/// Level 0, epoch by epoch, each epoch folded into level 1
+	const std::uint64_t chunk = 8192;
+	std::vector<double> records(chunk * channels);
+	for (std::uint64_t begin=0; begin<n and ok; begin+=chunk)
+	{
+		std::uint64_t end = std::min(n, begin + chunk);
+		for (std::uint64_t k=begin; k<end; ++k)
+		{
+			for (std::size_t c=0; c<channels; ++c)
+			{
+				double value = channel_data[c][k * channel_stride[c]];
+				records[(k - begin) * channels + c] = value;
+				if (table.size() > 1 and std::isfinite(value))
+				{
+					double sample[3] = {value, value, value};
+					pyramidMerge(&carry[1].bucket[3 * c], carry[1].counts[c], sample, 1);
+				}
+			}
+			if (table.size() > 1 and ++carry[1].children == 2)
+			{
+				ok = pyramidClose(out, table, carry, 1, channels) and ok;
+			}
+		}
+		ok = pyramidWriteAt(out, reinterpret_cast<const char*>(records.data()), (end - begin) * channels * sizeof(double),
+			table[0].offset + begin * channels * sizeof(double)) and ok;
+	}
+
+	/// The last bucket of every level may be missing its second half
+	for (std::size_t level=1; level<table.size() and ok; ++level)
+	{
+		if (carry[level].children > 0)
+		{
+			ok = pyramidClose(out, table, carry, level, channels);
+		}
+		ok = ok and pyramidFlush(out, table[level], carry[level], 3 * channels * sizeof(double));
+	}
+
+	if (ok and sync)
+	{
+		ok = ::fsync(out) == 0;
+	}
+	if (::close(out) != 0 or !ok or ::rename(temp_name.c_str(), file_name.c_str()) != 0)
+	{
+		::unlink(temp_name.c_str());
+		std::cerr << "Error writing the output pyramid to " << file_name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// The header and the level index are read once, the records on every query
+bool outputPyramid::open(const std::string file_name)
+{
+	this->close();
+	this->fd = ::open(file_name.c_str(), O_RDONLY);
+	if (this->fd < 0)
+	{
+		std::cerr << "Error opening the output pyramid " << file_name << std::endl;
+		return false;
+	}
+
+	bool ok = ::pread(this->fd, &this->header, sizeof(this->header), 0) == static_cast<ssize_t>(sizeof(this->header)) and
+		std::memcmp(this->header.magic, pyramid_magic, sizeof(pyramid_magic)) == 0 and this->header.version == pyramid_version and
+		this->header.levels > 0 and this->header.levels <= 64;
+	if (ok)
+	{
+		this->index.resize(this->header.levels);
+		ssize_t size = this->index.size() * sizeof(pyramid_level);
+		ok = ::pread(this->fd, this->index.data(), size, sizeof(this->header)) == size;
+	}
+	if (!ok)
+	{
+		std::cerr << "Error reading the output pyramid " << file_name << ", not a pyramid file or a different version" << std::endl;
+		this->close();
+		return false;
+	}
+	return true;
+}
+
+void outputPyramid::close()
+{
+	if (this->fd >= 0)
+	{
+		::close(this->fd);
+	}
+	this->fd = -1;
+	this->index.clear();
+	std::memset(&this->header, 0, sizeof(this->header));
+}
+
+const pyramid_header& outputPyramid::info() const
+{
+	return this->header;
+}
+
+const std::vector<pyramid_level>& outputPyramid::levels() const
+{
+	return this->index;
+}
+
+/// Records of each level covering the window, from the finest level up
+std::uint32_t outputPyramid::levelFor(const double t_begin, const double t_end, const std::size_t max_points) const
+{
+	if (this->index.empty())
+	{
+		return 0;
+	}
+	const double span = (std::max(t_end, t_begin) - std::min(t_end, t_begin)) / this->header.dt;
+	for (std::uint32_t level=0; level<this->index.size(); ++level)
+	{
+		double records = std::min<double>(std::floor(span / this->index[level].factor) + 2.0, this->index[level].count);
+		if (records <= max_points)
+		{
+			return level;
+		}
+	}
+	return static_cast<std::uint32_t>(this->index.size() - 1);
+}
+
+/// The window bounds give the first and last record, read in one go straight into the matrix: records are its columns
+bool outputPyramid::read(const double t_begin, const double t_end, const std::uint32_t level, pyramid_window& window) const
+{
+	if (this->fd < 0 or level >= this->index.size() or !(t_end >= t_begin))
+	{
+		return false;
+	}
+	const pyramid_level& entry = this->index[level];
+	const double span = this->header.dt * entry.factor;
+	double first = std::floor((t_begin - this->header.t0) / span);
+	double last = std::floor((t_end - this->header.t0) / span);
+	if (last < 0.0 or first > static_cast<double>(entry.count - 1))
+	{
+		return false;
+	}
+	first = std::max(first, 0.0);
+	last = std::min(last, static_cast<double>(entry.count - 1));
+
+	window.level = level;
+	window.factor = entry.factor;
+	window.first = static_cast<std::uint64_t>(first);
+	const std::uint64_t count = static_cast<std::uint64_t>(last) - window.first + 1;
+	window.values.resize((level == 0 ? 1 : 3) * this->header.channels, count);
+	window.time.resize(count);
+	for (std::uint64_t i=0; i<count; ++i)
+	{
+		window.time[i] = this->header.t0 + this->header.dt * static_cast<double>((window.first + i) * entry.factor);
+	}
+
+	char* data = reinterpret_cast<char*>(window.values.data());
+	std::size_t size = count * this->recordSize(level);
+	off_t offset = entry.offset + window.first * this->recordSize(level);
+	std::size_t done = 0;
+	while (done < size)
+	{
+		ssize_t n = ::pread(this->fd, data + done, size - done, offset + done);
+		if (n <= 0)
+		{
+			std::cerr << "Error reading the output pyramid, the file is truncated" << std::endl;
+			return false;
+		}
+		done += n;
+	}
+	return true;
+}
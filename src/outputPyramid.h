@@ -0,0 +1,145 @@
+#ifndef OUTPUT_PYRAMID_H
+#define OUTPUT_PYRAMID_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// Eigen includes
+#include <Eigen/Dense>
+
+/**
+ * @file outputPyramid.h
+ * @brief contains the declaration of the multi-resolution output file, for zooming into long filter runs without reprocessing them
+ */
+
+/**
+ * @brief pyramid_header struct at the start of the pyramid file, followed by the level index (one pyramid_level per level)
+ */
+struct pyramid_header
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t channels;  /// number of output series, e.g. clock bias, clock rate and NIS
+	std::uint64_t epochs;    /// number of samples of every series
+	double t0;               /// time of the first sample
+	double dt;               /// time between samples
+	std::uint32_t levels;
+	std::uint32_t reserved;
+};
+
+/**
+ * @brief pyramid_level struct is one entry of the level index
+ * - level 0 holds the full resolution values, one record of channels doubles per epoch
+ * - level L > 0 holds buckets of 2^L epochs, one record of (min, max, mean) doubles per channel per bucket; non-finite
+ *   values are left out, a bucket without finite values holds NaN
+ * Records are stored epoch after epoch so any time window of a level is one contiguous read.
+ */
+struct pyramid_level
+{
+	std::uint64_t factor;    /// epochs per record, 2^L
+	std::uint64_t count;     /// number of records
+	std::uint64_t offset;    /// file offset of the first record
+};
+
+/**
+ * @brief pyramid_window struct holds the records of a level read back for a time window
+ * - values: level 0 has one row per channel; higher levels have three rows per channel, its min, max and mean
+ */
+struct pyramid_window
+{
+	std::uint32_t level;
+	std::uint64_t factor;
+	std::uint64_t first;     /// index of the first record in the level
+	std::vector<double> time;
+	Eigen::MatrixXd values;
+};
+
+/**
+ * @brief The outputPyramid class writes the filter output histories at full resolution together with min/max/mean summaries
+ * at every power-of-two decimation, and reads back any time window at any level. The samples are evenly spaced, so the level
+ * index and the window bounds give the file offset of the window directly: a query is a single seek and read, whatever the
+ * length of the run. A zoom level is picked for the number of points the caller wants to draw.
+ */
+class outputPyramid
+{
+private:
+	/// Pyramid file opened for reading, -1 if none
+	int fd;
+	pyramid_header header;
+	std::vector<pyramid_level> index;
+
+	/**
+	 * @brief recordSize size in bytes of one record of the given level
+	 */
+	std::size_t recordSize(const std::uint32_t level) const;
+
+public:
+	/**
+	 * @brief outputPyramid class constructor
+	 */
+	outputPyramid();
+
+	/**
+	 * @brief ~outputPyramid class destructor, closes the file if still open
+	 */
+	~outputPyramid();
+
+	/**
+	 * @brief write build the pyramid of the given histories and write it to file, atomically replacing any previous one
+	 * @param file_name path of the pyramid file
+	 * @param histories output histories, every row is a channel and every column an epoch, e.g. {&xhat_hist, &nis_hist}
+	 * @param t0 time of the first epoch
+	 * @param dt time between epochs
+	 * @param sync also wait for the file to reach the storage device (fsync)
+	 * @return boolean value
+	 */
+	static bool write(const std::string file_name, const std::vector<const Eigen::MatrixXd*> histories, const double t0, const double dt,
+		const bool sync = false);
+
+	/**
+	 * @brief open read the header and the level index of a pyramid file
+	 * @param file_name path of the pyramid file
+	 * @return boolean value
+	 */
+	bool open(const std::string file_name);
+
+	/**
+	 * @brief close the pyramid file
+	 */
+	void close();
+
+	/**
+	 * @brief info getter function for the header of the opened file
+	 * @return the header
+	 */
+	const pyramid_header& info() const;
+
+	/**
+	 * @brief levels getter function for the level index of the opened file
+	 * @return one entry per level, level 0 first
+	 */
+	const std::vector<pyramid_level>& levels() const;
+
+	/**
+	 * @brief levelFor the finest level showing the time window with at most the given number of records
+	 * @param t_begin start of the window
+	 * @param t_end end of the window
+	 * @param max_points largest number of records wanted
+	 * @return the level, the coarsest one if none is small enough
+	 */
+	std::uint32_t levelFor(const double t_begin, const double t_end, const std::size_t max_points) const;
+
+	/**
+	 * @brief read the records of a level covering the time window [t_begin, t_end]
+	 * @param t_begin start of the window, clamped to the run
+	 * @param t_end end of the window, clamped to the run
+	 * @param level the level to read
+	 * @param window holds the records and the start time of each
+	 * @return boolean value, false if the window or the level is outside the pyramid or the read failed
+	 */
+	bool read(const double t_begin, const double t_end, const std::uint32_t level, pyramid_window& window) const;
+};
+
+#endif // OUTPUT_PYRAMID_H
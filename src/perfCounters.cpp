@@ -0,0 +1,239 @@
+#include "perfCounters.h"
+
+/// Std includes
+#include <cerrno>
+#include <cstdio>   // std::snprintf
+#include <cstring>  // std::memset, std::strerror
+
+/// POSIX includes
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/// The task clock per unit is printed in ns, us, ms or s
+#include "latencyHistogram.h"
+
+/**
+ * @file perfCounters.cpp
+ * @brief contains all the perfCounters member function definitions declared in .h file
+ */
+
+const int perfCounters::counter_count;
+
+/// class constructor, every counter closed
+perfCounters::perfCounters()
+	: counted_units(0), running(false), unavailable("not opened")
+{
+	for (int c=0; c<counter_count; ++c)
+	{
+		this->fds[c] = -1;
+		this->totals[c] = 0;
+		this->started[c] = 0;
+	}
+}
+
+perfCounters::~perfCounters()
+{
+	for (int c=0; c<counter_count; ++c)
+	{
+		if (this->fds[c] >= 0)
+		{
+			::close(this->fds[c]);
+		}
+	}
+}
+
+/// User space only, which perf_event_paranoid 2 (the usual default) allows; the time enabled and running come with every read
+int perfCounters::openCounter(const std::uint32_t type, const std::uint64_t config)
+{
+#ifdef __linux__
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.inherit = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+#else
+	(void)type;
+	(void)config;
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+/// A counter shared with others on the PMU runs only part of the time: value * enabled / running estimates the whole
+std::uint64_t perfCounters::readCounter(const int counter) const
+{
+	std::uint64_t values[3] = {0, 0, 0};
+	if (this->fds[counter] < 0 or ::read(this->fds[counter], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)))
+	{
+		return 0;
+	}
+	if (values[2] == 0 or values[2] >= values[1])
+	{
+		return values[0];
+	}
+	return static_cast<std::uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+}
+
+bool perfCounters::open()
+{
+#ifdef __linux__
+	const std::uint32_t types[counter_count] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+		PERF_TYPE_SOFTWARE, PERF_TYPE_SOFTWARE};
+	const std::uint64_t configs[counter_count] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+		PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_TASK_CLOCK, PERF_COUNT_SW_PAGE_FAULTS};
+#else
+	const std::uint32_t types[counter_count] = {0, 0, 0, 0, 0, 0};
+	const std::uint64_t configs[counter_count] = {0, 0, 0, 0, 0, 0};
+#endif
+	int hardware_error = 0;
+	for (int c=0; c<counter_count; ++c)
+	{
+		if (this->fds[c] < 0)
+		{
+			this->fds[c] = openCounter(types[c], configs[c]);
+		}
+		if (this->fds[c] < 0 and c < 4 and hardware_error == 0)
+		{
+			hardware_error = errno;
+		}
+	}
+
+	if (this->hardwareAvailable())
+	{
+		this->unavailable.clear();
+	}
+	else if (hardware_error == EACCES or hardware_error == EPERM)
+	{
+		this->unavailable = std::string(std::strerror(hardware_error)) + ", check kernel.perf_event_paranoid";
+	}
+	else if (hardware_error == ENOENT or hardware_error == EOPNOTSUPP)
+	{
+		this->unavailable = std::string(std::strerror(hardware_error)) + ", no hardware PMU (a VM or container?)";
+	}
+	else
+	{
+		this->unavailable = hardware_error != 0 ? std::strerror(hardware_error) : "cycles or instructions not counted";
+	}
+	return this->available();
+}
+
+bool perfCounters::available() const
+{
+	for (int c=0; c<counter_count; ++c)
+	{
+		if (this->fds[c] >= 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool perfCounters::hardwareAvailable() const
+{
+	return this->fds[0] >= 0 and this->fds[1] >= 0;
+}
+
+std::string perfCounters::why() const
+{
+	return this->unavailable;
+}
+
+void perfCounters::start()
+{
+	if (!this->available())
+	{
+		return;
+	}
+	for (int c=0; c<counter_count; ++c)
+	{
+		this->started[c] = this->readCounter(c);
+	}
+	this->running = true;
+}
+
+/// Threads started during the region add their counts when they exit, so they are joined before the region stops
+void perfCounters::stop(const std::uint64_t units)
+{
+	if (!this->running)
+	{
+		return;
+	}
+	for (int c=0; c<counter_count; ++c)
+	{
+		const std::uint64_t now = this->readCounter(c);
+		this->totals[c] += now > this->started[c] ? now - this->started[c] : 0;
+	}
+	this->counted_units += units;
+	this->running = false;
+}
+
+perf_counts perfCounters::counts() const
+{
+	perf_counts counts;
+	counts.cycles = this->totals[0];
+	counts.instructions = this->totals[1];
+	counts.cache_misses = this->totals[2];
+	counts.branch_misses = this->totals[3];
+	counts.task_clock_ns = this->totals[4];
+	counts.page_faults = this->totals[5];
+	return counts;
+}
+
+std::uint64_t perfCounters::units() const
+{
+	return this->counted_units;
+}
+
+/// Counts per unit with 3 significant digits; the counters that could not be opened are left out
+std::string perfCounters::report(const std::string region, const std::string unit) const
+{
+	if (!this->available())
+	{
+		return region + " counters unavailable: " + this->unavailable;
+	}
+
+	const perf_counts c = this->counts();
+	const double units = this->counted_units > 0 ? static_cast<double>(this->counted_units) : 1.0;
+	std::string line = region + " counters over " + std::to_string(this->counted_units) + " " + unit + "s";
+	char text[256];
+	if (this->hardwareAvailable())
+	{
+		std::snprintf(text, sizeof(text), ": IPC %.3g, %.3g cycles, %.3g instructions", c.cycles > 0 ? static_cast<double>(c.instructions) / c.cycles : 0.0,
+			c.cycles / units, c.instructions / units);
+		line += text;
+		if (this->fds[2] >= 0)
+		{
+			std::snprintf(text, sizeof(text), ", %.3g cache misses", c.cache_misses / units);
+			line += text;
+		}
+		if (this->fds[3] >= 0)
+		{
+			std::snprintf(text, sizeof(text), ", %.3g branch misses", c.branch_misses / units);
+			line += text;
+		}
+		line += ",";
+	}
+	else
+	{
+		line += " (hardware counters unavailable: " + this->unavailable + "):";
+	}
+	if (this->fds[4] >= 0)
+	{
+		line += " " + latencyHistogram::format(c.task_clock_ns / units) + " task clock";
+	}
+	if (this->fds[5] >= 0)
+	{
+		std::snprintf(text, sizeof(text), "%s %.3g page faults", this->fds[4] >= 0 ? "," : "", c.page_faults / units);
+		line += text;
+	}
+	return line + " per " + unit;
+}
@@ -0,0 +1,120 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/// Std includes
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file perfCounters.h
+ * @brief contains the declaration of the hardware performance counters read around the hot loops of ekf with perf_event_open,
+ * no external perf tooling needed
+ */
+
+/**
+ * @brief perf_counts struct holds what a set of counters counted, scaled for the time they were multiplexed out
+ * - cycles, instructions, cache_misses (last level), branch_misses: hardware counters, 0 when not available
+ * - task_clock_ns, page_faults: software counters, kept by the kernel even where the hardware ones are not (VMs, containers)
+ */
+struct perf_counts
+{
+	std::uint64_t cycles;
+	std::uint64_t instructions;
+	std::uint64_t cache_misses;
+	std::uint64_t branch_misses;
+	std::uint64_t task_clock_ns;
+	std::uint64_t page_faults;
+};
+
+/**
+ * @brief The perfCounters class counts the user-space cycles, instructions, cache misses and branch misses of the calling thread,
+ * and of the threads it starts afterwards (the parser threads), over the regions between start() and stop(). The counters are
+ * opened once and read at both ends of a region, two reads per counter. Where the hardware counters cannot be opened
+ * (perf_event_paranoid, no PMU in a VM, not Linux) only the software ones are reported, and if those fail too the counters stay
+ * unavailable and start() and stop() do nothing, so a run never fails for lack of counters.
+ */
+class perfCounters
+{
+private:
+	/// cycles, instructions, cache misses, branch misses, task clock, page faults
+	static const int counter_count = 6;
+	int fds[counter_count];
+	std::uint64_t totals[counter_count];
+	std::uint64_t started[counter_count];
+	std::uint64_t counted_units;
+	bool running;
+	std::string unavailable;
+
+	/// Opens one user-space counter of the calling thread, inherited by its new threads; -1 if it cannot be opened
+	static int openCounter(const std::uint32_t type, const std::uint64_t config);
+
+	/// Reads a counter, scaled up when it was only scheduled part of the time
+	std::uint64_t readCounter(const int counter) const;
+
+public:
+	/**
+	 * @brief perfCounters class constructor, nothing is opened until open
+	 */
+	perfCounters();
+
+	/**
+	 * @brief perfCounters class destructor, closes the counters
+	 */
+	~perfCounters();
+
+	perfCounters(const perfCounters&) = delete;
+	perfCounters& operator=(const perfCounters&) = delete;
+
+	/**
+	 * @brief open the counters, in the thread that will run the regions
+	 * @return boolean value, false if not even the software counters could be opened
+	 */
+	bool open();
+
+	/**
+	 * @brief available whether any counter is open
+	 */
+	bool available() const;
+
+	/**
+	 * @brief hardwareAvailable whether the hardware counters are open, cycles and instructions at least
+	 */
+	bool hardwareAvailable() const;
+
+	/**
+	 * @brief why the hardware counters are unavailable, empty when they are
+	 */
+	std::string why() const;
+
+	/**
+	 * @brief start a region
+	 */
+	void start();
+
+	/**
+	 * @brief stop the region, adding what it counted to the totals
+	 * @param units what the region went through, epochs filtered or bytes parsed
+	 */
+	void stop(const std::uint64_t units);
+
+	/**
+	 * @brief counts the totals of every region so far
+	 */
+	perf_counts counts() const;
+
+	/**
+	 * @brief units the total of the units of every region so far
+	 */
+	std::uint64_t units() const;
+
+	/**
+	 * @brief report one line with the counts per unit: IPC, cycles, instructions, cache and branch misses, task clock, page faults
+	 * @param region what was counted, e.g. "Filter loop"
+	 * @param unit the name of a unit, e.g. "epoch" or "byte"
+	 * @return the line, or why nothing was counted
+	 */
+	std::string report(const std::string region, const std::string unit) const;
+};
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,112 @@
+/**
+ * @file plotRenderer.cpp
+ * @brief contains the plotRenderer definitions, the only translation unit of the plotting library
+ */
+
+/// Plots are drawn by the built-in renderer when built without Python, by matplotlib otherwise
+#ifdef POINTONENAV_NATIVE_PLOT
+#include "nativePlot.h"
+#else
+#include "matplotlibcpp.h"
+#endif
+
+#include "plotRenderer.h"
+
+/// Std includes
+#include <iostream>
+#include <stdexcept>
+
+#ifdef POINTONENAV_NATIVE_PLOT
+/// The built-in renderer plots vectors, so strided and evenly spaced values are copied out
+bool plotRenderer::draw(const plot_figure& figure, const std::string path, const bool headless)
+{
+	(void)headless;
+	nativePlot canvas;
+	for (const plot_band& band : figure.bands)
+	{
+		canvas.fillBetween(std::vector<double>(band.x, band.x + band.n), std::vector<double>(band.lower, band.lower + band.n),
+			std::vector<double>(band.upper, band.upper + band.n), "", band.alpha);
+	}
+	for (const plot_line& line : figure.lines)
+	{
+		std::vector<double> x(line.n), y(line.n);
+		for (std::size_t i=0; i<line.n; ++i)
+		{
+			x[i] = line.x != NULL ? line.x[i] : line.x0 + line.dx * i;
+			y[i] = line.y[i * line.y_stride];
+		}
+		canvas.plot(x, y, line.format);
+	}
+	canvas.title(figure.title);
+	canvas.xlabel(figure.x_label);
+	canvas.ylabel(figure.y_label);
+
+	/// The built-in renderer never opens a window, it always saves PNG and SVG
+	bool saved = canvas.save(path + ".png");
+	return canvas.save(path + ".svg") and saved;
+}
+
+bool plotRenderer::started()
+{
+	return false;
+}
+#else
+/// numpy arrays over the caller's memory, nothing is copied
+bool plotRenderer::draw(const plot_figure& figure, const std::string path, const bool headless)
+{
+	/// The backend has to be chosen before the first call starts the interpreter and loads matplotlib
+	if (headless)
+	{
+		matplotlibcpp::backend("Agg");
+	}
+
+	try
+	{
+		/// fill_between draws below the lines whatever the call order, without an edge line
+		for (const plot_band& band : figure.bands)
+		{
+			std::map<std::string, std::string> keywords = {{"alpha", std::to_string(band.alpha)}, {"linewidth", "0"}};
+			matplotlibcpp::fill_between(std::vector<double>(band.x, band.x + band.n), std::vector<double>(band.lower, band.lower + band.n),
+				std::vector<double>(band.upper, band.upper + band.n), keywords);
+		}
+		for (const plot_line& line : figure.lines)
+		{
+			if (line.x != NULL)
+			{
+				matplotlibcpp::plot(line.x, 1, line.y, line.y_stride, line.n, line.format);
+			}
+			else
+			{
+				matplotlibcpp::plot(matplotlibcpp::arange(line.x0, line.dx), line.y, line.y_stride, line.n, line.format);
+			}
+		}
+		matplotlibcpp::title(figure.title);
+		matplotlibcpp::xlabel(figure.x_label);
+		matplotlibcpp::ylabel(figure.y_label);
+		matplotlibcpp::save(path + ".png");
+
+		/// Show plot, headless runs only save it, as SVG as well
+		if (headless)
+		{
+			matplotlibcpp::save(path + ".svg");
+		}
+		else
+		{
+			matplotlibcpp::show();
+		}
+		matplotlibcpp::close();
+	}
+	catch (const std::runtime_error& e)
+	{
+		std::cerr << "Error plotting " << path << ": " << e.what() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Py_IsInitialized does not start the interpreter, unlike any matplotlibcpp call
+bool plotRenderer::started()
+{
+	return Py_IsInitialized() != 0;
+}
+#endif
@@ -0,0 +1,84 @@
+#ifndef PLOT_RENDERER_H
+#define PLOT_RENDERER_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @file plotRenderer.h
+ * @brief contains the declaration of the plotting component, compiled into the plotting library
+ * @note this header is all the filter code sees of the plotting; matplotlib (and so Python) or the built-in renderer are
+ *       only included by plotRenderer.cpp, so the filter and its tests build and link without them
+ */
+
+/**
+ * @brief plot_line struct holds one line of a figure, its values are read in place from the caller's memory
+ * - x: values along the x axis, NULL for evenly spaced values x0 + dx * i
+ * - y: values along the y axis, y_stride values apart, such as a row of a column-major Eigen matrix
+ * - format: matplotlib format string, e.g. "r-"; empty for the next color of the cycle
+ */
+struct plot_line
+{
+	const double* x;
+	double x0;
+	double dx;
+	const double* y;
+	std::ptrdiff_t y_stride;
+	std::size_t n;
+	std::string format;
+};
+
+/**
+ * @brief plot_band struct holds a filled band between two curves, such as a confidence envelope, drawn below the lines
+ * - x: values along the x axis, increasing
+ * - lower, upper: the curves bounding the band, n values each
+ * - alpha: opacity of the fill, the color is the next of the fill color cycle
+ */
+struct plot_band
+{
+	const double* x;
+	const double* lower;
+	const double* upper;
+	std::size_t n;
+	double alpha;
+};
+
+/**
+ * @brief plot_figure struct holds a whole figure, the lines are drawn in order over the bands
+ */
+struct plot_figure
+{
+	std::string title;
+	std::string x_label;
+	std::string y_label;
+	std::vector<plot_line> lines;
+	std::vector<plot_band> bands;
+};
+
+/**
+ * @brief The plotRenderer class draws and saves a figure with matplotlib, or with the built-in renderer when built with
+ * POINTONENAV_NATIVE_PLOT. The Python interpreter is started by the first figure drawn, never before: runs that do not plot
+ * (ekf --no-plot, or a filter that only writes its outputs) do not pay for loading Python and matplotlib.
+ */
+class plotRenderer
+{
+public:
+	/**
+	 * @brief draw render the figure and save it as "<path>.png", and "<path>.svg" when headless
+	 * @param figure the figure to draw
+	 * @param path the output path without extension
+	 * @param headless boolean value, when set the Agg backend is used and no window is shown; the built-in renderer is always headless
+	 * @return boolean value, false if the figure could not be saved
+	 */
+	static bool draw(const plot_figure& figure, const std::string path, const bool headless);
+
+	/**
+	 * @brief started check whether the plotting backend is running, i.e. the Python interpreter has been initialized
+	 * @return boolean value, always false for the built-in renderer, which has nothing to start
+	 */
+	static bool started();
+};
+
+#endif // PLOT_RENDERER_H
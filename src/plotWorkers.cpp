@@ -0,0 +1,96 @@
+#include "plotWorkers.h"
+
+/// Std includes
+#include <cstdio>   // std::fflush
+#include <cerrno>
+#include <iostream>
+#include <exception>
+
+/// POSIX includes
+#include <unistd.h>
+#include <sys/wait.h>
+
+/// The workers are named in the trace
+#include "traceEvents.h"
+
+/**
+ * @file plotWorkers.cpp
+ * @brief contains all the plotWorkers member function definitions declared in .h file
+ */
+
+/// Fork a child for the job; buffered output is flushed first so the child does not write it a second time
+bool plotWorkers::spawn(const std::function<void()> job)
+{
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(NULL);
+
+	pid_t pid = ::fork();
+	if (pid == 0)
+	{
+		int status = 0;
+		TRACE_THREAD_NAME("plot worker");
+		try
+		{
+			job();
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Error rendering plot: " << e.what() << std::endl;
+			status = 1;
+		}
+		catch (...)
+		{
+			status = 1;
+		}
+		std::cout.flush();
+		std::cerr.flush();
+		std::fflush(NULL);
+
+		/// _exit skips the static destructors and atexit handlers the child inherited from the filter process
+		::_exit(status);
+	}
+	if (pid < 0)
+	{
+		std::cerr << "Error starting plot worker, rendering in the foreground" << std::endl;
+		try
+		{
+			job();
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Error rendering plot: " << e.what() << std::endl;
+		}
+		return false;
+	}
+	this->children.push_back(pid);
+	return true;
+}
+
+/// Reap every child, a child that was killed or exited with an error makes the result false
+bool plotWorkers::wait()
+{
+	bool all_ok = true;
+	for (pid_t pid : this->children)
+	{
+		int status = 0;
+		pid_t result;
+		do
+		{
+			result = ::waitpid(pid, &status, 0);
+		}
+		while (result < 0 and errno == EINTR);
+
+		if (result != pid or !WIFEXITED(status) or WEXITSTATUS(status) != 0)
+		{
+			all_ok = false;
+		}
+	}
+	this->children.clear();
+	return all_ok;
+}
+
+std::size_t plotWorkers::running() const
+{
+	return this->children.size();
+}
@@ -0,0 +1,50 @@
+#ifndef PLOT_WORKERS_H
+#define PLOT_WORKERS_H
+
+/// Std includes
+#include <vector>
+#include <functional>
+
+/// POSIX includes
+#include <sys/types.h>
+
+/**
+ * @file plotWorkers.h
+ * @brief contains the declaration of the worker processes that render the plots in the background
+ */
+
+/**
+ * @brief The plotWorkers class renders every figure in a process of its own, forked from the filter process.
+ * matplotlib is not thread-safe and runs under the Python global interpreter lock, so the figures are rendered in separate
+ * processes, each with its own interpreter, all at the same time. The children share the filter histories copy-on-write,
+ * nothing is serialized. The parent must not have started the Python interpreter before the first spawn.
+ * Children that are not waited for keep running after the parent has exited.
+ */
+class plotWorkers
+{
+private:
+	/// Children still to be waited for
+	std::vector<pid_t> children;
+
+public:
+	/**
+	 * @brief spawn run the job in a new child process, which exits when the job returns
+	 * @param job the rendering work, e.g. a matPlot call
+	 * @return boolean value, false if no process could be forked and the job ran in the calling process instead
+	 */
+	bool spawn(const std::function<void()> job);
+
+	/**
+	 * @brief wait block until every spawned child has exited
+	 * @return boolean value, false if a child failed
+	 */
+	bool wait();
+
+	/**
+	 * @brief running number of children not waited for yet
+	 * @return the count
+	 */
+	std::size_t running() const;
+};
+
+#endif // PLOT_WORKERS_H
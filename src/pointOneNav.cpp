@@ -0,0 +1,383 @@
+#include "pointOneNav.h"
+
+/// Std includes
+#include <iostream>
+#include <fstream>
+#include <cstdlib> // std::atoi
+#include <memory>  // std::unique_ptr
+#include <iomanip> // std::setprecision
+#include <sstream> // std::stringstream
+#include <numeric> // std::iota
+
+/// Buffered output formatting
+#include "bufferedWriter.h"
+
+/// Binary sidecars of the parsed input files
+#include "inputCache.h"
+
+/// Multi-threaded parsing of the text input files
+#include "textParser.h"
+
+/// Decimation of long series before plotting
+#include "downsample.h"
+
+/// Multi-resolution output for zooming into long runs
+#include "outputPyramid.h"
+
+/// Streaming NIS consistency statistics
+#include "filterStats.h"
+
+/// Per-stage timing and memory instrumentation
+#include "stageProfiler.h"
+
+/// Trace-event spans for pipeline visualisation
+#include "traceEvents.h"
+
+/// Hardware performance counters around the parse loop
+#include "perfCounters.h"
+
+/**
+ * @file pointOneNav.cpp
+ * @brief contains all the class member function definitions declared in .h file 
+ */
+
+/// class constructor, makes a check to command line args to set dt value
+twoStateClockModel::twoStateClockModel(bool arg_input, float arg_val)
+{
+	this->arg_check = arg_input;
+	this->use_input_cache = false;
+	this->input_dir = "../filter_input/";
+	this->parse_threads = 0;
+	this->sync_outputs = false;
+	this->parse_counters = NULL;
+	this->headless_plots = false;
+	this->plot_decimation = decimation_method::lttb;
+	this->plot_points = 4000;
+	if (arg_input)
+	{
+		this->arg_in = arg_val;
+	}
+	else
+	{
+		this->arg_in = 1.0; 
+	}
+}
+
+/// twoStateClockModel dynamics function
+void twoStateClockModel::f(const mat x_k, const mat w_k)
+{	
+	mat a = mat::Identity(2,2);
+	a(0,1) = this->arg_in;		
+
+	mat b = mat::Identity(2,2);
+
+	this->x_kp1_k = a * x_k + b * w_k;
+	this->df_dxk = a;
+	this->df_dwk = b;
+}
+
+/// twoStateClockModel measurement function
+void twoStateClockModel::h(const mat x_kp1_k, const mat v_kp1)
+{
+	this->y_kp1_k = this->x_kp1_k + v_kp1;
+	this->dh_dxkp1 = mat::Identity(2,2);
+}
+
+/// Extended Kalman Filter algorithm to update state and covariance
+void twoStateClockModel::simpleEKF(const mat& xk_est, const mat xcovk_est, const mat w_k, const mat clock_noise_cov, 
+									const mat y_kp1, const mat v_kp1, const mat measurement_cov)
+{
+	/// Propogate the states
+	f(xk_est, w_k);
+
+	/// Predict the measurements
+	h(this->x_kp1_k, v_kp1);
+	this->zkp1 = y_kp1 - this->y_kp1_k;
+
+	/// Propogate the covariance
+	mat p_kp1_k = this->df_dxk  * xcovk_est * this->df_dxk.transpose() + this->df_dwk * clock_noise_cov * this->df_dwk.transpose();
+
+	/// Compute filter gain and k_kp1
+	skp1 = this->dh_dxkp1  * p_kp1_k * this->dh_dxkp1.transpose() + measurement_cov;
+
+	/// No measurement this epoch (dropout), the prediction is the estimate
+	if (!y_kp1.allFinite())
+	{
+		this->x_kp1 = this->x_kp1_k;
+		xcov_kp1 = p_kp1_k;
+		return;
+	}
+
+	mat k_kp1 = p_kp1_k * (this->dh_dxkp1.transpose() * skp1.inverse());
+
+	/// Compute the a posteriori state estimate
+	this->x_kp1 = this->x_kp1_k + k_kp1 * this->zkp1;
+
+	/// Compute the a posteriori covariance estimate
+	int n_x = xk_est.rows();
+	mat imwh = mat::Identity(2,2) - k_kp1 * this->dh_dxkp1;
+
+	/// Joseph form to enforce positive semi-definiteness of the covariance matrix
+	xcov_kp1 = imwh * p_kp1_k * imwh.transpose() + k_kp1 * measurement_cov * k_kp1.transpose();
+}
+
+/// Return the a posteriori state estimate
+mat twoStateClockModel::get_xkp1()
+{
+	return this->x_kp1;
+}
+
+/// Return the predicted measurements
+mat twoStateClockModel::get_zkp1()
+{
+	return this->zkp1;
+}
+
+/// Return the filter gain
+mat twoStateClockModel::get_skp1()
+{
+	return this->skp1;
+}
+
+/// Return the covariance matrix
+mat twoStateClockModel::get_xcov_kp1()
+{
+	return this->xcov_kp1;
+}
+
+/// *********************
+//! FILE I/O OPERATIONS |
+/// *********************
+
+/// Read in the contents of the input text file, parsed in parallel chunks straight into one vector per line
+bool twoStateClockModel::readFromFile(const std::string file_name, std::vector<std::vector<double> >& values_from_file)
+{
+	TRACE_SCOPE(trace, "readFromFile", "io", file_name.c_str());
+	textParser parser(this->parse_threads);
+	if (!parser.open(file_name))
+	{
+		std::cout << "Error opening the file " << file_name << ", ";
+		return false;
+	}
+
+	std::vector<std::vector<double> > lines;
+	if (this->parse_counters != NULL)
+	{
+		this->parse_counters->start();
+	}
+	parser.parseRows(lines);
+	if (this->parse_counters != NULL)
+	{
+		this->parse_counters->stop(parser.bytes());
+	}
+	for (auto it=lines.begin(); it!=lines.end(); it++)
+	{
+		values_from_file.push_back(std::vector<double>());
+		values_from_file.back().swap(*it);
+	}
+	TRACE_ARG(trace, lines.size());
+	return true;
+}
+
+/// Insert the data from the input file to the given input matrix, if reading in file is successful
+void twoStateClockModel::getInputData(const std::string file_name, mat& input_mat)
+{
+	/// Location of the filter input files
+	std::stringstream file_input;
+	file_input << this->input_dir << file_name;
+	STAGE_SCOPE(stage, "getInputData", file_name);
+	TRACE_SCOPE(trace, "getInputData", "io", file_name.c_str());
+
+	/// A valid sidecar holds the values parsed in an earlier run
+	if (this->use_input_cache and inputCache::load(file_input.str(), input_mat))
+	{
+		STAGE_ITEMS(stage, input_mat.size());
+		TRACE_ARG(trace, input_mat.size());
+		return;
+	}
+
+	/// The text file as it is before parsing it, the sidecar is only stored if it is still the same afterwards
+	cache_source source;
+	const bool cacheable = this->use_input_cache and inputCache::identify(file_input.str(), source);
+
+	textParser parser(this->parse_threads);
+	if (!parser.open(file_input.str()))
+	{
+		std::cout << "Error opening the file " << file_input.str() << ", ";
+		std::cerr << " check the input file!" << std::endl;
+		return;
+	}
+
+	/// Rectangular files are parsed straight into the matrix, anything else line by line
+	if (this->parse_counters != NULL)
+	{
+		this->parse_counters->start();
+	}
+	std::vector<std::vector<double> > values_from_file;
+	const bool rectangular = parser.parseMatrix(input_mat);
+	if (!rectangular)
+	{
+		parser.parseRows(values_from_file);
+	}
+	if (this->parse_counters != NULL)
+	{
+		this->parse_counters->stop(parser.bytes());
+	}
+	if (!rectangular)
+	{
+		if (values_from_file.empty())
+		{
+			std::cerr << "No values in " << file_input.str() << ", check the input file!" << std::endl;
+			return;
+		}
+
+		int rows = values_from_file.size();
+		int cols = values_from_file[0].size();
+
+		mat temp = mat::Zero(rows, cols);
+		for (int i=0; i<rows; ++i)
+		{
+			for (int j=0; j<cols and j<static_cast<int>(values_from_file[i].size()); ++j)
+			{
+				temp(i,j) = values_from_file[i][j];
+			}
+		}
+		input_mat = temp;
+	}
+
+	/// Rebuild the sidecar, replacing a stale one
+	if (cacheable)
+	{
+		inputCache::store(file_input.str(), source, input_mat);
+	}
+	STAGE_ITEMS(stage, input_mat.size());
+	TRACE_ARG(trace, input_mat.size());
+}
+
+/// Set the directory of the filter input files
+void twoStateClockModel::setInputDir(const std::string directory)
+{
+	this->input_dir = directory.empty() or directory.back() == '/' ? directory : directory + "/";
+}
+
+/// Enable or disable the parsed-input cache
+void twoStateClockModel::setInputCache(const bool enable)
+{
+	this->use_input_cache = enable;
+}
+
+/// Set the number of parser threads
+void twoStateClockModel::setParseThreads(const unsigned num_threads)
+{
+	this->parse_threads = num_threads;
+}
+
+/// Select whether the output files are flushed to disk
+void twoStateClockModel::setSyncOutputs(const bool enable)
+{
+	this->sync_outputs = enable;
+}
+
+/// Count the hardware events of the text parses
+void twoStateClockModel::setParseCounters(perfCounters* counters)
+{
+	this->parse_counters = counters;
+}
+
+/// If reading from file is successful, insert the data from the input file to the given input vector
+void twoStateClockModel::getInputData(const std::string file_name, std::vector<std::vector<double> >& values_from_file)
+{
+	if (readFromFile(file_name, values_from_file))
+	{
+		return;
+	}
+	else
+	{
+		std::cerr << " check the input file!" << std::endl;
+	}
+}
+
+/// Check if all the filter inputs files are read in correctly
+bool twoStateClockModel::checkInputs(struct filter_input f_in)
+{
+	if (f_in.initial_state_estimate.size() > 0 and f_in.initial_state_estimate_covariance.size() > 0 and 
+		f_in.measurement_noise_covariance.size() > 0 and f_in.process_noise_covariance.size() > 0 and 
+		f_in.measurement_history.size() > 0)
+	{
+		return true;
+	}
+	return false;
+}
+
+/// Write the contents of a given matrix to a text file
+bool twoStateClockModel::writeToFile(const std::string file_name, const mat& output)
+{
+	/// Decimal precision as given in the filter output provided
+	return writeToFile(file_name, output, matrix_layout::matrix, number_style::fixed16);
+}
+
+/// Write the contents of a given matrix to a text file, formatted into a large buffer and written in a few chunks
+bool twoStateClockModel::writeToFile(const std::string file_name, const mat& output, const matrix_layout layout, const number_style style)
+{
+	std::stringstream ss;
+	ss << "../filter_output/" << file_name;
+	STAGE_SCOPE(stage, "writeToFile", file_name);
+	STAGE_ITEMS(stage, output.size());
+	TRACE_SCOPE(trace, "writeToFile", "io", file_name.c_str());
+	TRACE_ARG(trace, output.size());
+
+	bufferedWriter file;
+	if (file.open(ss.str()))
+	{
+		file.putMatrix(output, layout, style);
+		if (file.close(this->sync_outputs))
+		{
+			return true;
+		}
+	}
+
+	std::cerr << "Error writing output to file, " << std::endl;
+	return false;
+}
+
+/// Write the output pyramid next to the text outputs
+bool twoStateClockModel::writePyramid(const std::string file_name, const std::vector<const mat*> histories, const double t0, const double dt)
+{
+	std::stringstream ss;
+	ss << "../filter_output/" << file_name;
+	STAGE_SCOPE(stage, "writePyramid", file_name);
+	STAGE_ITEMS(stage, histories.empty() ? 0 : histories.front()->cols());
+	TRACE_SCOPE(trace, "writePyramid", "io", file_name.c_str());
+	return outputPyramid::write(ss.str(), histories, t0, dt, this->sync_outputs);
+}
+
+/// If writing to file is successful, the data are then read and added into the input vector container
+bool twoStateClockModel::getVectorValues(const mat mat_in, const std::string file_name, std::vector<std::vector<double> >& output_values)
+{
+	STAGE_SCOPE(stage, "getVectorValues", file_name);
+	STAGE_ITEMS(stage, mat_in.size());
+	if (writeToFile(file_name, mat_in))
+	{
+		/// read from the output folder
+		std::stringstream ss;
+		ss << "../filter_output/" << file_name;
+		getInputData(ss.str(), output_values);
+		return true;
+	}
+
+	std::cerr << " no values added into the vector!" << std::endl;
+	return false;
+}
+
+/// Select the headless plotting mode; the backend is chosen when the first plot is drawn
+void twoStateClockModel::setHeadless(const bool enable)
+{
+	this->headless_plots = enable;
+}
+
+/// Select the decimation of long series
+void twoStateClockModel::setPlotDecimation(const decimation_method method, const std::size_t points)
+{
+	this->plot_decimation = method;
+	this->plot_points = points;
+}
@@ -2,24 +2,36 @@
 #define POINT_ONE_NAV_H
 
 /// Std includes
-#include <iostream>
-#include <fstream>
-#include <cstdlib> // std::atoi
-#include <memory>  // std::unique_ptr
-#include <iomanip> // std::setprecision
+#include <string>
+#include <vector>
+#include <cstddef>
 
 /// Eigen includes
 #include <Eigen/Dense> 
-#include <Eigen/StdVector> 
 
 /**
  * @file pointOneNav.h
  * @brief contains the main class declaration along with the corresponding function prototypes along with struct and typedef declaration
+ * @note the public header of the pointonenav library, it only needs the standard library and Eigen; the enums of the output and plot
+ *       options are defined by bufferedWriter.h and downsample.h, included by the programs selecting them
  */
 
+/// Output number formatting and matrix orientation, defined in bufferedWriter.h
+enum class number_style;
+enum class matrix_layout;
+
+/// Decimation of long series before plotting, defined in downsample.h
+enum class decimation_method;
+
+/// Hardware performance counters, defined in perfCounters.h
+class perfCounters;
+
 /// typedef declaration for Eigen matrix
 typedef Eigen::MatrixXd mat;
 
+/// typedef declaration for a row of an Eigen matrix viewed in place, such as xhat_hist.row(0)
+typedef Eigen::Ref<const Eigen::RowVectorXd, 0, Eigen::InnerStride<> > row_view;
+
 /**
  * @brief filter_input struct initialization to hold all the filter input matrices 
  */
@@ -42,6 +54,28 @@ private:
 	float arg_in;
 	bool arg_check;
 
+	/// Use binary sidecars of the parsed input matrices instead of parsing the text files again
+	bool use_input_cache;
+
+	/// Directory of the filter input files, ../filter_input/ unless set
+	std::string input_dir;
+
+	/// Number of threads used to parse the input text files, 0 uses all hardware threads
+	unsigned parse_threads;
+
+	/// Flush the output files to disk (fsync) before writeToFile returns
+	bool sync_outputs;
+
+	/// Counters run around every text parse, per byte parsed; NULL counts nothing
+	perfCounters* parse_counters;
+
+	/// Render plots with the non-interactive Agg backend and only save them to file
+	bool headless_plots;
+
+	/// Series longer than plot_points are decimated before plotting
+	decimation_method plot_decimation;
+	std::size_t plot_points;
+
 	/// Initialize system defining matrices
 	/// State and covariance 
 	mat x_kp1 = mat::Zero(2,1);
@@ -81,7 +115,8 @@ public:
 	void h(const mat x_kp1_k, const mat v_kp1);
 
 	/**
-	 * @brief simpleEKF Extended Kalman Filter implementation
+	 * @brief simpleEKF Extended Kalman Filter implementation; an epoch whose measurement holds a non-finite value (a dropout) is
+	 * only predicted: the state and covariance are propagated, the innovation is nan
 	 * @param xk_est a posteriori state at the previous time step k
 	 * @param xcovk_est a posteriori state covariance estimate at k
 	 * @param w_k a priori estimate of process noise  at k to k+1
@@ -124,6 +159,36 @@ public:
 	 */
 	void getInputData(const std::string file_name, mat& input_mat);
 
+	/**
+	 * @brief setInputDir set the directory getInputData reads the filter input files from, such as a simulated dataset
+	 * @param directory the directory, ../filter_input by default
+	 */
+	void setInputDir(const std::string directory);
+
+	/**
+	 * @brief setInputCache enable or disable the parsed-input cache used by getInputData for matrices
+	 * @param enable boolean value, when set a valid sidecar is mapped instead of parsing the text file, and written after parsing otherwise
+	 */
+	void setInputCache(const bool enable);
+
+	/**
+	 * @brief setParseThreads set the number of threads used to parse the input text files
+	 * @param num_threads number of threads, 0 uses all hardware threads
+	 */
+	void setParseThreads(const unsigned num_threads);
+
+	/**
+	 * @brief setSyncOutputs make writeToFile flush every output file to disk before it returns
+	 * @param enable boolean value, when set the outputs are durable once writeToFile returns
+	 */
+	void setSyncOutputs(const bool enable);
+
+	/**
+	 * @brief setParseCounters count the hardware events of every input text file parsed by readFromFile and getInputData
+	 * @param counters opened counters, the bytes parsed are their units; NULL stops counting
+	 */
+	void setParseCounters(perfCounters* counters);
+
 	/**
 	 * @brief getInputData function used to extract the contents of a file into a vector
 	 * @param file_name the file name, extract values from
@@ -152,7 +217,27 @@ public:
 	 * @param output matrix from which the data is written to file
 	 * @return boolean value
 	 */
-	bool writeToFile(const std::string file_name, const mat output);
+	bool writeToFile(const std::string file_name, const mat& output);
+
+	/**
+	 * @brief writeToFile function to write the output from the process to a text file in the given format
+	 * @param file_name the file name, to write the output to
+	 * @param output matrix from which the data is written to file
+	 * @param layout matrix orientation in the file, as a matrix or as one comma separated row per epoch
+	 * @param style number formatting, fixed 16-digit scientific or shortest round-trip
+	 * @return boolean value
+	 */
+	bool writeToFile(const std::string file_name, const mat& output, const matrix_layout layout, const number_style style);
+
+	/**
+	 * @brief writePyramid write the output histories at full resolution with their min/max/mean pyramid, see outputPyramid
+	 * @param file_name the file name, to write the pyramid to
+	 * @param histories output histories, every row is a series and every column an epoch
+	 * @param t0 time of the first epoch
+	 * @param dt time between epochs
+	 * @return boolean value
+	 */
+	bool writePyramid(const std::string file_name, const std::vector<const mat*> histories, const double t0, const double dt);
 
 	/**
 	 * @brief getVectorValues write the contents of a matrix to file and read it into a vector for other operations
@@ -163,19 +248,65 @@ public:
 	 */
 	bool getVectorValues(const mat mat_in, const std::string file_name, std::vector<std::vector<double> >& output_values);
 
+	/**
+	 * @brief setHeadless select the headless plotting mode for batch jobs, must be called before the first plot
+	 * @param enable boolean value, when set the Agg backend is used, plots are saved as PNG and SVG and never shown
+	 * @note the built-in renderer (POINTONENAV_NATIVE_PLOT) always works this way
+	 */
+	void setHeadless(const bool enable);
+
+	/**
+	 * @brief setPlotDecimation select how series longer than the given number of points are reduced before plotting
+	 * @param method the decimation method, decimation_method::none plots every sample
+	 * @param points number of points to keep, about the plot width in pixels or a small multiple of it
+	 */
+	void setPlotDecimation(const decimation_method method, const std::size_t points);
+
 	/**
 	 * @brief matPlot function to plot the filter output against custom data
+	 * @note the matPlot members are defined in the plotting library (pointOneNavPlot.cpp), not in pointonenav: a program plotting
+	 *       links plotting as well, which is only built with -DPLOTTING=ON; built with -DPLOTTING=OFF they are part of pointonenav
+	 *       and only report an error
 	 * @param x vector containing values to be plotted along the x axis
 	 * @param y vector containing values to be plotted along the y axis
 	 * @param caption the title of the plot
 	 * @param x_label the x axis label on the plot
 	 * @param y_label the y axis label on the plot
-	 * @param gamma_high chi-squared inverse distibution with 2DOF for the given alpha value
+	 * @param gamma_high chi-squared inverse distibution with 2DOF for the given alpha value, see filterStats::chiSquareInv
+	 * @return boolean value, false if the figure could not be drawn or saved
+	 */
+	bool matPlot(const std::vector<double> x, const std::vector<double> y, std::string caption, const std::string x_label, const std::string y_label, const float gamma_high);
+
+	/**
+	 * @brief matPlot function to plot a row of the filter output history in place, without copying it into vectors
+	 * @param x row of values to be plotted, e.g. xhat_hist.row(0)
+	 * @param t0 time of the first value
+	 * @param dt time between the values
+	 * @param caption the title of the plot
+	 * @param x_label the x axis label on the plot
+	 * @param y_label the y axis label on the plot
+	 * @param gamma_high chi-squared inverse distibution with 2DOF for the given alpha value, see filterStats::chiSquareInv
+	 * @return boolean value, false if the figure could not be drawn or saved
+	 */
+	bool matPlot(const row_view x, const double t0, const double dt, std::string caption, const std::string x_label, const std::string y_label, const float gamma_high);
+
+	/**
+	 * @brief matPlot function to plot a row of the filter output history in place with its confidence envelope
+	 * @param x row of values to be plotted, e.g. xhat_hist.row(0)
+	 * @param variance row of the variances of the values, e.g. the (0,0) elements of xcov_hist
+	 * @param k_sigma half width of the envelope in standard deviations, x +- k_sigma*sqrt(variance)
+	 * @param t0 time of the first value
+	 * @param dt time between the values
+	 * @param caption the title of the plot
+	 * @param x_label the x axis label on the plot
+	 * @param y_label the y axis label on the plot
+	 * @note the envelope is evaluated at the samples kept by the decimation of x only, so it costs O(plot points), not O(n)
+	 * @return boolean value, false if the figure could not be drawn or saved
 	 */
-	void matPlot(const std::vector<double> x, const std::vector<double> y, std::string caption, const std::string x_label, const std::string y_label, const float gamma_high);
+	bool matPlot(const row_view x, const row_view variance, const double k_sigma, const double t0, const double dt, std::string caption,
+		const std::string x_label, const std::string y_label);
 
 
 };
 
-#include "pointOneNav.hpp"
 #endif // POINT_ONE_NAV_H
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "pointOneNav.h"
+
+/// Std includes
+#include <iostream>
+#include <iomanip> // std::setprecision
+#include <sstream> // std::stringstream
+#include <limits>
+#include <cmath>
+
+/// Decimation of long series before plotting
+#include "downsample.h"
+
+/// NIS threshold of the plot caption
+#include "filterStats.h"
+
+/// Per-stage timing and trace spans of the plots
+#include "stageProfiler.h"
+#include "traceEvents.h"
+
+/// The plotting library, not part of builds without plotting (POINTONENAV_NO_PLOT)
+#ifndef POINTONENAV_NO_PLOT
+#include "plotRenderer.h"
+#endif
+
+/**
+ * @file pointOneNavPlot.cpp
+ * @brief contains the plotting member function definitions of twoStateClockModel declared in pointOneNav.h
+ * @note compiled into the plotting library, so only the programs that plot link it (and through it Python); built with
+ *       POINTONENAV_NO_PLOT it is part of the pointonenav library and the plotting members only report an error
+ */
+
+namespace
+{
+	/// The plot options of a twoStateClockModel
+	struct plot_settings
+	{
+		decimation_method decimation;
+		std::size_t points;
+		bool headless;
+	};
+
+	/// Plot strided values against the given time values, or evenly spaced ones when there are none; false if the figure was not saved
+	bool drawPlot(const plot_settings& settings, const double* values, const std::ptrdiff_t stride, const std::size_t n, const double* time,
+		const double t0, const double dt, std::string caption, const std::string x_label, const std::string y_label, const float gamma_high,
+		const double* variance = NULL, const std::ptrdiff_t variance_stride = 1, const double k_sigma = 0.0)
+	{
+#ifdef POINTONENAV_NO_PLOT
+		(void)settings; (void)values; (void)stride; (void)n; (void)time; (void)t0; (void)dt; (void)x_label; (void)y_label; (void)gamma_high;
+		(void)variance; (void)variance_stride; (void)k_sigma;
+		std::cerr << "Error plotting " << caption << ", built without the plotting component!" << std::endl;
+		return false;
+#else
+		STAGE_SCOPE(stage, "matPlot", caption);
+		STAGE_ITEMS(stage, n);
+		TRACE_SCOPE(trace, "matPlot", "plot", caption.c_str());
+		TRACE_ARG(trace, n);
+		plot_figure figure;
+		figure.x_label = x_label;
+		figure.y_label = y_label;
+		auto timeAt = [time, t0, dt](const std::size_t i)
+		{
+			return time != NULL ? time[i] : t0 + dt * i;
+		};
+
+		/// Long runs are reduced to about plot_points points, keeping the NIS spikes above gamma_high, the full series are only used for the count
+		std::vector<std::size_t> kept;
+		bool decimate = settings.decimation != decimation_method::none and n > settings.points;
+		if (decimate and settings.decimation == decimation_method::min_max)
+		{
+			downsample::minMax(values, stride, n, settings.points, kept);
+		}
+		else if (decimate)
+		{
+			downsample::lttb(time, values, stride, n, settings.points, kept,
+				gamma_high != 0.0 ? gamma_high : std::numeric_limits<double>::infinity());
+		}
+
+		/// Gamma_high value obtained from inverse chi-squared probability distribution with 2 degrees of freedom, the alpha it stands for is evaluated back from it
+		std::vector<double> w(2, gamma_high);
+		std::vector<double> w_time(2);
+		if (gamma_high != 0.0)
+		{
+			std::size_t counter = 0, finite = 0;
+			for (std::size_t i=0; i<n; i++)
+			{
+				if (values[i * stride] > gamma_high)
+				{
+					counter++;
+				}
+				if (std::isfinite(values[i * stride]))
+				{
+					finite++;
+				}
+			}
+			double nis = finite > 0 ? static_cast<double>(counter) / finite : 0.0;
+			double alpha = 1.0 - filterStats::chiSquareCdf(gamma_high, 2);
+
+			/// Caption for this plot
+			std::stringstream ss;
+			ss << "NIS, " << nis << " above the " << std::setprecision(2) << alpha << " threshold";
+			caption = ss.str();
+
+			/// The threshold line only needs its end points
+			if (n > 0)
+			{
+				w_time[0] = timeAt(0);
+				w_time[1] = timeAt(n - 1);
+				figure.lines.push_back({w_time.data(), 0.0, 0.0, w.data(), 1, w.size(), "r-"});
+			}
+		}
+		figure.title = caption;
+
+		/// Decimated series are gathered, full ones are read in place
+		std::vector<double> plot_time, plot_values;
+		if (decimate)
+		{
+			plot_time.resize(kept.size());
+			for (std::size_t i=0; i<kept.size(); ++i)
+			{
+				plot_time[i] = timeAt(kept[i]);
+			}
+			plot_values = downsample::gather(values, stride, kept);
+			figure.lines.push_back({plot_time.data(), 0.0, 0.0, plot_values.data(), 1, plot_values.size(), ""});
+		}
+		else
+		{
+			figure.lines.push_back({time, t0, dt, values, stride, n, ""});
+		}
+
+		/// The envelope is evaluated at the samples the decimation kept, in one pass over them
+		std::vector<double> band_time, band_lower, band_upper;
+		if (variance != NULL)
+		{
+			const std::size_t count = decimate ? kept.size() : n;
+			band_time.resize(count);
+			band_lower.resize(count);
+			band_upper.resize(count);
+			for (std::size_t i=0; i<count; ++i)
+			{
+				const std::size_t j = decimate ? kept[i] : i;
+				const double half_width = k_sigma * std::sqrt(variance[j * variance_stride]);
+				band_time[i] = timeAt(j);
+				band_lower[i] = values[j * stride] - half_width;
+				band_upper[i] = values[j * stride] + half_width;
+			}
+			figure.bands.push_back({band_time.data(), band_lower.data(), band_upper.data(), count, 0.3});
+		}
+
+		/// Save plot to file in the given path
+		std::stringstream ss;
+		ss << "../filter_output/" << caption;
+		return plotRenderer::draw(figure, ss.str(), settings.headless);
+#endif
+	}
+}
+
+/// Plot the values using the given input vectors with the plot title and axis labels
+bool twoStateClockModel::matPlot(const std::vector<double> x, const std::vector<double> y, std::string caption, const std::string x_label, const std::string y_label, const float gamma_high)
+{
+	/// Make sure the input vector with values to be plotted has the same number of elements as y
+	if (x.size() == y.size())
+	{
+		const plot_settings settings = {this->plot_decimation, this->plot_points, this->headless_plots};
+		return drawPlot(settings, x.data(), 1, x.size(), y.data(), 0.0, 1.0, caption, x_label, y_label, gamma_high);
+	}
+	std::cerr << "Error plotting, vectors must be of the same length!" << std::endl;
+	return false;
+}
+
+/// Plot a row of an output history in place, against evenly spaced time values
+bool twoStateClockModel::matPlot(const row_view x, const double t0, const double dt, std::string caption, const std::string x_label, const std::string y_label, const float gamma_high)
+{
+	const plot_settings settings = {this->plot_decimation, this->plot_points, this->headless_plots};
+	return drawPlot(settings, x.data(), x.innerStride(), x.size(), NULL, t0, dt, caption, x_label, y_label, gamma_high);
+}
+
+/// Plot a row of an output history with the envelope of its standard deviation
+bool twoStateClockModel::matPlot(const row_view x, const row_view variance, const double k_sigma, const double t0, const double dt, std::string caption,
+	const std::string x_label, const std::string y_label)
+{
+	if (x.size() == variance.size())
+	{
+		const plot_settings settings = {this->plot_decimation, this->plot_points, this->headless_plots};
+		return drawPlot(settings, x.data(), x.innerStride(), x.size(), NULL, t0, dt, caption, x_label, y_label, 0.0, variance.data(), variance.innerStride(), k_sigma);
+	}
+	std::cerr << "Error plotting, values and variances must be of the same length!" << std::endl;
+	return false;
+}
@@ -0,0 +1,260 @@
+#include "stageProfiler.h"
+
+/// Std includes
+#include <cstdio>   // std::snprintf
+#include <cstring>  // std::strncpy
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+/// POSIX includes
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+/**
+ * @file stageProfiler.cpp
+ * @brief contains all the stageProfiler member function definitions declared in .h file
+ */
+
+const std::size_t stageProfiler::default_capacity;
+
+/// class constructor, recording is off until enable
+stageProfiler::stageProfiler()
+	: finished(NULL), records(NULL), capacity(0), mapped_bytes(0), started_unix(0), started_wall(0.0), owner(0)
+{
+}
+
+/// class destructor, the children unmap their copy of the mapping when they exit
+stageProfiler::~stageProfiler()
+{
+	if (this->finished != NULL)
+	{
+		::munmap(this->finished, this->mapped_bytes);
+	}
+}
+
+stageProfiler& stageProfiler::instance()
+{
+	static stageProfiler profiler;
+	return profiler;
+}
+
+double stageProfiler::wallSeconds()
+{
+	struct timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+double stageProfiler::cpuSeconds()
+{
+	struct timespec ts;
+	::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/// ru_maxrss is in kB on Linux
+std::int64_t stageProfiler::peakRssKb()
+{
+	struct rusage usage;
+	if (::getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return 0;
+	}
+	return usage.ru_maxrss;
+}
+
+/// The records live in a shared anonymous mapping, zero-filled, which the children forked later write into
+bool stageProfiler::enable(const std::string report_name, const std::string program, const std::size_t capacity)
+{
+	if (this->finished != NULL)
+	{
+		::munmap(this->finished, this->mapped_bytes);
+		this->finished = NULL;
+	}
+	this->capacity = std::max<std::size_t>(capacity, 1);
+	this->mapped_bytes = sizeof(stage_record) * (this->capacity + 1);
+	void* mapping = ::mmap(NULL, this->mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (mapping == MAP_FAILED)
+	{
+		std::cerr << "Error mapping the stage records, the run is not instrumented" << std::endl;
+		return false;
+	}
+
+	/// The counter takes the first record slot, so the records stay aligned
+	this->finished = static_cast<std::atomic<std::uint64_t>*>(mapping);
+	this->records = static_cast<stage_record*>(mapping) + 1;
+	this->report_name = report_name;
+	this->program = program;
+	this->started_unix = static_cast<std::int64_t>(std::time(NULL));
+	this->started_wall = wallSeconds();
+	this->owner = ::getpid();
+	return true;
+}
+
+bool stageProfiler::enabled() const
+{
+	return this->finished != NULL;
+}
+
+stage_mark stageProfiler::begin(const std::string name, const std::string detail) const
+{
+	stage_mark mark;
+	mark.active = this->enabled();
+	if (mark.active)
+	{
+		mark.name = name;
+		mark.detail = detail;
+		mark.peak_rss_kb = peakRssKb();
+		mark.cpu = cpuSeconds();
+		mark.wall = wallSeconds();
+	}
+	return mark;
+}
+
+/// A slot is claimed with one atomic increment, the pid is stored last to publish the record
+void stageProfiler::end(const stage_mark& mark, const std::uint64_t items)
+{
+	if (!mark.active or !this->enabled())
+	{
+		return;
+	}
+	const double wall = wallSeconds();
+	const double cpu = cpuSeconds();
+	const std::int64_t peak_rss_kb = peakRssKb();
+
+	const std::uint64_t slot = this->finished->fetch_add(1);
+	if (slot >= this->capacity)
+	{
+		return;
+	}
+	stage_record& record = this->records[slot];
+	std::strncpy(record.name, mark.name.c_str(), sizeof(record.name) - 1);
+	std::strncpy(record.detail, mark.detail.c_str(), sizeof(record.detail) - 1);
+	record.items = items;
+	record.start = mark.wall - this->started_wall;
+	record.wall = wall - mark.wall;
+	record.cpu = cpu - mark.cpu;
+	record.peak_rss_kb = peak_rss_kb;
+	record.peak_rss_delta_kb = peak_rss_kb - mark.peak_rss_kb;
+	record.pid.store(::getpid(), std::memory_order_release);
+}
+
+std::size_t stageProfiler::count() const
+{
+	return this->enabled() ? static_cast<std::size_t>(std::min<std::uint64_t>(this->finished->load(), this->capacity)) : 0;
+}
+
+std::uint64_t stageProfiler::dropped() const
+{
+	return this->enabled() ? this->finished->load() - this->count() : 0;
+}
+
+const stage_record& stageProfiler::record(const std::size_t n) const
+{
+	return this->records[n];
+}
+
+std::string stageProfiler::jsonString(const std::string text)
+{
+	std::string quoted = "\"";
+	for (const char c : text)
+	{
+		if (c == '"' or c == '\\')
+		{
+			quoted += '\\';
+			quoted += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			char escape[8];
+			std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+			quoted += escape;
+		}
+		else
+		{
+			quoted += c;
+		}
+	}
+	return quoted + "\"";
+}
+
+/// One object per run: the run itself, its totals, then one object per stage in order of completion
+bool stageProfiler::writeReport(const std::uint64_t epochs) const
+{
+	if (!this->enabled() or ::getpid() != this->owner)
+	{
+		return true;
+	}
+
+	std::ofstream file(this->report_name);
+	if (!file.is_open())
+	{
+		std::cerr << "Error opening the profile report " << this->report_name << std::endl;
+		return false;
+	}
+
+	char started[32];
+	std::time_t started_time = static_cast<std::time_t>(this->started_unix);
+	struct tm utc;
+	::gmtime_r(&started_time, &utc);
+	std::strftime(started, sizeof(started), "%Y-%m-%dT%H:%M:%SZ", &utc);
+	char host[256] = "";
+	::gethostname(host, sizeof(host) - 1);
+
+	std::size_t pending = 0;
+	file << std::setprecision(9) << "{\n";
+	file << "  \"schema\": \"pointonenav.stage_report.v1\",\n";
+	file << "  \"program\": " << jsonString(this->program) << ",\n";
+	file << "  \"host\": " << jsonString(host) << ",\n";
+	file << "  \"pid\": " << this->owner << ",\n";
+	file << "  \"started\": " << jsonString(started) << ",\n";
+	file << "  \"epochs\": " << epochs << ",\n";
+	file << "  \"total\": {\"wall_s\": " << wallSeconds() - this->started_wall << ", \"cpu_s\": " << cpuSeconds()
+		<< ", \"peak_rss_kb\": " << peakRssKb() << "},\n";
+	file << "  \"stages\": [";
+	for (std::size_t n=0, written=0; n<this->count(); ++n)
+	{
+		const stage_record& record = this->record(n);
+		const std::int32_t pid = record.pid.load(std::memory_order_acquire);
+		if (pid == 0)
+		{
+			++pending;
+			continue;
+		}
+		file << (written++ == 0 ? "\n" : ",\n") << "    {\"name\": " << jsonString(record.name) << ", \"detail\": " << jsonString(record.detail)
+			<< ", \"pid\": " << pid << ", \"worker\": " << (pid != this->owner ? "true" : "false") << ", \"items\": " << record.items
+			<< ", \"start_s\": " << record.start << ", \"wall_s\": " << record.wall << ", \"cpu_s\": " << record.cpu
+			<< ", \"peak_rss_kb\": " << record.peak_rss_kb << ", \"peak_rss_delta_kb\": " << record.peak_rss_delta_kb
+			<< ", \"items_per_s\": " << (record.wall > 0.0 ? record.items / record.wall : 0.0) << "}";
+	}
+	file << "\n  ],\n";
+	file << "  \"dropped_stages\": " << this->dropped() + pending << "\n";
+	file << "}\n";
+	file.close();
+	if (file.fail())
+	{
+		std::cerr << "Error writing the profile report " << this->report_name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Nothing is measured while the profiler is off, the mark stays inactive
+stageScope::stageScope(const std::string name, const std::string detail)
+	: mark(stageProfiler::instance().begin(name, detail)), items(0)
+{
+}
+
+stageScope::~stageScope()
+{
+	stageProfiler::instance().end(this->mark, this->items);
+}
+
+void stageScope::setItems(const std::uint64_t items)
+{
+	this->items = items;
+}
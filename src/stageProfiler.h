@@ -0,0 +1,200 @@
+#ifndef STAGE_PROFILER_H
+#define STAGE_PROFILER_H
+
+/// Std includes
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+/// POSIX includes
+#include <sys/types.h>
+
+/**
+ * @file stageProfiler.h
+ * @brief contains the declaration of the per-stage instrumentation of ekf: wall time, CPU time, peak RSS growth and item count
+ * of every stage, written as a JSON report
+ */
+
+/**
+ * @brief stage_record struct holds the measurements of one finished stage
+ * - start and wall: seconds since the profiler was enabled, and the length of the stage
+ * - cpu: CPU seconds of the whole process during the stage, every thread included (the parser threads, the output writer)
+ * - peak_rss_kb: peak resident set size of the process at the end of the stage; peak_rss_delta_kb: how much it grew during the stage
+ * - items: what the stage went through, in its own unit (values parsed or written, epochs filtered, samples plotted)
+ * - pid: the process that ran the stage, stored last: 0 while the record is being written
+ */
+struct stage_record
+{
+	char name[48];
+	char detail[80];
+	std::atomic<std::int32_t> pid;
+	std::uint64_t items;
+	double start;
+	double wall;
+	double cpu;
+	std::int64_t peak_rss_kb;
+	std::int64_t peak_rss_delta_kb;
+};
+
+/**
+ * @brief stage_mark struct is the state of a stage being measured, returned by stageProfiler::begin
+ */
+struct stage_mark
+{
+	bool active;
+	std::string name;
+	std::string detail;
+	double wall;
+	double cpu;
+	std::int64_t peak_rss_kb;
+};
+
+/**
+ * @brief The stageProfiler class records the stages of an ekf run. The records are kept in a shared anonymous mapping of fixed
+ * size, so the stages of the plot worker processes forked after enable() land in the same report as those of the filter.
+ * Recording is off until enable() is called, begin() and end() then cost two clock reads and a getrusage call each.
+ * The STAGE_* macros below are the interface used by ekf; built without POINTONENAV_INSTRUMENT they compile to nothing, their
+ * arguments not even evaluated.
+ */
+class stageProfiler
+{
+private:
+	/// Shared with the forked children: the number of stages finished, then the records
+	std::atomic<std::uint64_t>* finished;
+	stage_record* records;
+	std::size_t capacity;
+	std::size_t mapped_bytes;
+
+	std::string report_name;
+	std::string program;
+	std::int64_t started_unix;
+	double started_wall;
+	pid_t owner;
+
+	/// Monotonic wall clock and process CPU clock, in seconds
+	static double wallSeconds();
+	static double cpuSeconds();
+
+	/// Peak resident set size of the calling process, in kB
+	static std::int64_t peakRssKb();
+
+public:
+	/// Records kept per run, stages past it are counted as dropped
+	static const std::size_t default_capacity = 1024;
+
+	stageProfiler();
+	~stageProfiler();
+
+	/**
+	 * @brief instance the profiler of the process, used by the STAGE_* macros
+	 */
+	static stageProfiler& instance();
+
+	/**
+	 * @brief enable start recording; must be called before any plot worker is forked
+	 * @param report_name the JSON report file, written by writeReport
+	 * @param program name of the program in the report
+	 * @param capacity number of stages kept
+	 * @return boolean value, false if the record mapping could not be created
+	 */
+	bool enable(const std::string report_name, const std::string program = "ekf", const std::size_t capacity = default_capacity);
+
+	/**
+	 * @brief enabled whether the stages are recorded
+	 */
+	bool enabled() const;
+
+	/**
+	 * @brief begin start measuring a stage
+	 * @param name the stage, usually the function that runs it
+	 * @param detail what it runs on, e.g. the input file name
+	 * @return the mark to pass to end
+	 */
+	stage_mark begin(const std::string name, const std::string detail = "") const;
+
+	/**
+	 * @brief end finish measuring a stage and record it
+	 * @param mark returned by begin
+	 * @param items the number of items the stage went through
+	 */
+	void end(const stage_mark& mark, const std::uint64_t items);
+
+	/**
+	 * @brief count number of stages recorded so far, by this process and its children
+	 */
+	std::size_t count() const;
+
+	/**
+	 * @brief dropped number of stages finished once the records were full
+	 */
+	std::uint64_t dropped() const;
+
+	/**
+	 * @brief record the nth stage recorded, in order of completion
+	 */
+	const stage_record& record(const std::size_t n) const;
+
+	/**
+	 * @brief writeReport write the JSON report of the stages recorded so far, with the totals of the run: only the process
+	 * that enabled the profiler writes it
+	 * @param epochs the number of epochs of the run, stored in the report
+	 * @return boolean value
+	 */
+	bool writeReport(const std::uint64_t epochs) const;
+
+	/**
+	 * @brief jsonString quote and escape a string for JSON
+	 */
+	static std::string jsonString(const std::string text);
+};
+
+/**
+ * @brief The stageScope class measures the enclosing scope as one stage, recorded when it is left by any path, for functions
+ * with several returns
+ */
+class stageScope
+{
+private:
+	stage_mark mark;
+	std::uint64_t items;
+
+public:
+	/**
+	 * @brief stageScope class constructor, begins the stage
+	 * @param name the stage
+	 * @param detail what it runs on
+	 */
+	stageScope(const std::string name, const std::string detail);
+
+	/**
+	 * @brief stageScope class destructor, ends the stage with the items set so far
+	 */
+	~stageScope();
+
+	/**
+	 * @brief setItems set the number of items the stage went through
+	 */
+	void setItems(const std::uint64_t items);
+};
+
+/// Per-stage instrumentation, compiled in with POINTONENAV_INSTRUMENT (-DINSTRUMENTATION=ON):
+/// - STAGE_BEGIN / STAGE_END measure a span of statements, STAGE_SCOPE / STAGE_ITEMS the rest of a scope
+/// - STAGE_ENABLE starts recording for the run, STAGE_REPORT writes the JSON report
+#ifdef POINTONENAV_INSTRUMENT
+#define STAGE_ENABLE(report) stageProfiler::instance().enable(report)
+#define STAGE_BEGIN(mark, name, detail) stage_mark mark = stageProfiler::instance().begin(name, detail)
+#define STAGE_END(mark, items) stageProfiler::instance().end(mark, items)
+#define STAGE_SCOPE(scope, name, detail) stageScope scope(name, detail)
+#define STAGE_ITEMS(scope, items) scope.setItems(items)
+#define STAGE_REPORT(epochs) stageProfiler::instance().writeReport(epochs)
+#else
+#define STAGE_ENABLE(report) false
+#define STAGE_BEGIN(mark, name, detail) do {} while (0)
+#define STAGE_END(mark, items) do {} while (0)
+#define STAGE_SCOPE(scope, name, detail) do {} while (0)
+#define STAGE_ITEMS(scope, items) do {} while (0)
+#define STAGE_REPORT(epochs) true
+#endif
+
+#endif // STAGE_PROFILER_H
@@ -0,0 +1,389 @@
+#include "textParser.h"
+
+/// Std includes
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstring> // std::memcpy
+#include <cstdlib> // std::strtod
+
+/// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/// Spans of the chunk workers
+#include "traceEvents.h"
+
+/// std::from_chars for doubles is only available from C++17 on recent standard libraries
+#if defined(__has_include)
+#  if __has_include(<charconv>) && __cplusplus >= 201703L
+#    include <charconv>
+#  endif
+#endif
+
+/**
+ * @file textParser.cpp
+ * @brief contains all the textParser member function definitions declared in .h file
+ */
+
+/// Chunks smaller than this are not worth a thread of their own
+static const std::size_t parser_min_chunk = 1 << 20;
+
+/// Separators between values inside a line
+static inline bool isValueSeparator(const char c)
+{
+	return c == ' ' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+}
+
+/// Parse every number of a chunk and hand it to store(line, column, value) at its final position
+template <typename Store>
+static bool parseChunk(const char* data, std::size_t begin, std::size_t end, std::uint64_t line, std::uint64_t column, Store store)
+{
+	bool all_numbers = true;
+	std::size_t i = begin;
+	while (i < end)
+	{
+		char c = data[i];
+		if (c == '\n')
+		{
+			line++;
+			column = 0;
+			i++;
+		}
+		else if (isValueSeparator(c))
+		{
+			i++;
+		}
+		else
+		{
+			std::size_t token_end = i + 1;
+			while (token_end < end and data[token_end] != '\n' and !isValueSeparator(data[token_end]))
+			{
+				token_end++;
+			}
+			double value;
+			if (textParser::parseNumber(data + i, data + token_end, value))
+			{
+				store(line, column, value);
+			}
+			else
+			{
+				all_numbers = false;
+			}
+			column++;
+			i = token_end;
+		}
+	}
+	return all_numbers;
+}
+
+/// class constructor
+textParser::textParser(const unsigned num_threads)
+	: threads(num_threads), data(NULL), size(0)
+{
+	if (this->threads == 0)
+	{
+		this->threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+/// class destructor
+textParser::~textParser()
+{
+	close();
+}
+
+/// Map the file read-only
+bool textParser::open(const std::string file_name)
+{
+	close();
+
+	int fd = ::open(file_name.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	if (::fstat(fd, &st) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	this->size = st.st_size;
+	if (this->size > 0)
+	{
+		void* mapped = ::mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			::close(fd);
+			this->size = 0;
+			return false;
+		}
+		::madvise(mapped, this->size, MADV_SEQUENTIAL);
+		this->data = static_cast<const char*>(mapped);
+	}
+	::close(fd);
+	return true;
+}
+
+/// Unmap the file
+void textParser::close()
+{
+	if (this->data != NULL)
+	{
+		::munmap(const_cast<char*>(this->data), this->size);
+		this->data = NULL;
+	}
+	this->size = 0;
+}
+
+std::size_t textParser::bytes() const
+{
+	return this->size;
+}
+
+/// Longest valid number at the start of the token, like operator>> for a double
+bool textParser::parseNumber(const char* first, const char* last, double& value)
+{
+	if (first < last and *first == '+')
+	{
+		first++;
+	}
+#if defined(__cpp_lib_to_chars)
+	std::from_chars_result result = std::from_chars(first, last, value);
+	return result.ec == std::errc() and result.ptr != first;
+#else
+	char token[128];
+	std::size_t n = std::min<std::size_t>(last - first, sizeof(token) - 1);
+	std::memcpy(token, first, n);
+	token[n] = '\0';
+	char* parsed = NULL;
+	value = std::strtod(token, &parsed);
+	return parsed != token;
+#endif
+}
+
+/// Cut the file into chunks at whitespace, count the values and line breaks of every chunk in parallel
+void textParser::split(std::vector<chunk_info>& chunks, std::vector<std::uint64_t>& line_lengths) const
+{
+	std::size_t num_chunks = std::max<std::size_t>(1, std::min<std::size_t>(this->threads, this->size / parser_min_chunk));
+	chunks.assign(num_chunks, chunk_info());
+
+	std::size_t begin = 0;
+	for (std::size_t k=0; k<num_chunks; ++k)
+	{
+		std::size_t end = (k+1 == num_chunks) ? this->size : std::max(begin, (k+1) * this->size / num_chunks);
+		while (end < this->size and this->data[end] != '\n' and !isValueSeparator(this->data[end]))
+		{
+			end++;
+		}
+		chunks[k].begin = begin;
+		chunks[k].end = end;
+		begin = end;
+	}
+
+	/// Counting pass: numbers per line piece of every chunk
+	auto count = [this](chunk_info& chunk)
+	{
+		TRACE_SCOPE(trace, "countChunk", "parse", NULL);
+		TRACE_ARG(trace, chunk.end - chunk.begin);
+		chunk.line_tokens.assign(1, 0);
+		bool in_token = false;
+		for (std::size_t i=chunk.begin; i<chunk.end; ++i)
+		{
+			char c = this->data[i];
+			if (c == '\n')
+			{
+				chunk.line_tokens.push_back(0);
+				in_token = false;
+			}
+			else if (isValueSeparator(c))
+			{
+				in_token = false;
+			}
+			else if (!in_token)
+			{
+				chunk.line_tokens.back()++;
+				in_token = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (std::size_t k=1; k<num_chunks; ++k)
+	{
+		workers.push_back(std::thread([&count](chunk_info& chunk)
+		{
+			TRACE_THREAD_NAME("textParser");
+			count(chunk);
+		}, std::ref(chunks[k])));
+	}
+	count(chunks[0]);
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	/// Chain the pieces: every chunk starts where the previous one stopped
+	line_lengths.clear();
+	std::uint64_t column = 0;
+	for (auto& chunk : chunks)
+	{
+		chunk.first_line = line_lengths.size();
+		chunk.first_column = column;
+		for (std::size_t piece=0; piece<chunk.line_tokens.size(); ++piece)
+		{
+			if (piece > 0)
+			{
+				line_lengths.push_back(column);
+				column = 0;
+			}
+			column += chunk.line_tokens[piece];
+		}
+	}
+
+	/// Like std::getline, a last line without a line break still counts, an empty one after the final line break does not
+	if (this->size > 0 and this->data[this->size - 1] != '\n')
+	{
+		line_lengths.push_back(column);
+	}
+}
+
+/// Parse on the calling thread, keeping only the tokens that are numbers
+void textParser::parseSerial(std::vector<std::vector<double> >& rows) const
+{
+	rows.clear();
+	if (this->size > 0)
+	{
+		rows.push_back(std::vector<double>());
+	}
+	for (std::size_t i=0; i<this->size; ++i)
+	{
+		if (this->data[i] == '\n')
+		{
+			if (i+1 < this->size)
+			{
+				rows.push_back(std::vector<double>());
+			}
+			continue;
+		}
+		if (isValueSeparator(this->data[i]))
+		{
+			continue;
+		}
+		std::size_t token_end = i + 1;
+		while (token_end < this->size and this->data[token_end] != '\n' and !isValueSeparator(this->data[token_end]))
+		{
+			token_end++;
+		}
+		double value;
+		if (parseNumber(this->data + i, this->data + token_end, value))
+		{
+			rows.back().push_back(value);
+		}
+		i = token_end - 1;
+	}
+}
+
+/// Parse every line into its own vector, sized up front so the chunks fill them in place
+void textParser::parseRows(std::vector<std::vector<double> >& rows) const
+{
+	std::vector<chunk_info> chunks;
+	std::vector<std::uint64_t> line_lengths;
+	split(chunks, line_lengths);
+
+	rows.assign(line_lengths.size(), std::vector<double>());
+	for (std::size_t line=0; line<line_lengths.size(); ++line)
+	{
+		rows[line].resize(line_lengths[line]);
+	}
+
+	std::atomic<bool> all_numbers(true);
+	auto parse = [this, &rows, &all_numbers](const chunk_info& chunk)
+	{
+		TRACE_SCOPE(trace, "parseChunk", "parse", NULL);
+		TRACE_ARG(trace, chunk.end - chunk.begin);
+		auto store = [&rows](std::uint64_t line, std::uint64_t column, double value)
+		{
+			rows[line][column] = value;
+		};
+		if (!parseChunk(this->data, chunk.begin, chunk.end, chunk.first_line, chunk.first_column, store))
+		{
+			all_numbers = false;
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (std::size_t k=1; k<chunks.size(); ++k)
+	{
+		workers.push_back(std::thread([&parse](const chunk_info& chunk)
+		{
+			TRACE_THREAD_NAME("textParser");
+			parse(chunk);
+		}, std::cref(chunks[k])));
+	}
+	parse(chunks[0]);
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	/// Tokens that are not numbers shift the columns of the rest of their line, parse those files serially
+	if (!all_numbers)
+	{
+		parseSerial(rows);
+	}
+}
+
+/// Parse a rectangular file straight into the column-major matrix storage
+bool textParser::parseMatrix(Eigen::MatrixXd& output) const
+{
+	std::vector<chunk_info> chunks;
+	std::vector<std::uint64_t> line_lengths;
+	split(chunks, line_lengths);
+
+	if (line_lengths.empty() or line_lengths[0] == 0 or
+		std::count(line_lengths.begin(), line_lengths.end(), line_lengths[0]) != static_cast<std::ptrdiff_t>(line_lengths.size()))
+	{
+		return false;
+	}
+
+	output.resize(line_lengths.size(), line_lengths[0]);
+	double* values = output.data();
+	const std::uint64_t rows = output.rows();
+
+	std::atomic<bool> all_numbers(true);
+	auto parse = [this, values, rows, &all_numbers](const chunk_info& chunk)
+	{
+		TRACE_SCOPE(trace, "parseChunk", "parse", NULL);
+		TRACE_ARG(trace, chunk.end - chunk.begin);
+		auto store = [values, rows](std::uint64_t line, std::uint64_t column, double value)
+		{
+			values[column * rows + line] = value;
+		};
+		if (!parseChunk(this->data, chunk.begin, chunk.end, chunk.first_line, chunk.first_column, store))
+		{
+			all_numbers = false;
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (std::size_t k=1; k<chunks.size(); ++k)
+	{
+		workers.push_back(std::thread([&parse](const chunk_info& chunk)
+		{
+			TRACE_THREAD_NAME("textParser");
+			parse(chunk);
+		}, std::cref(chunks[k])));
+	}
+	parse(chunks[0]);
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	return all_numbers;
+}
@@ -0,0 +1,108 @@
+#ifndef TEXT_PARSER_H
+#define TEXT_PARSER_H
+
+/// Std includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// Eigen includes
+#include <Eigen/Dense>
+
+/**
+ * @file textParser.h
+ * @brief contains the declaration of the multi-threaded parser for the whitespace separated text input files
+ */
+
+/**
+ * @brief The textParser class maps a text file and parses its numbers in parallel chunks.
+ * The file is split at whitespace into one chunk per thread; a first pass counts the numbers and line breaks of every chunk,
+ * so each chunk knows the line and column it starts at, and a second pass parses every chunk straight into its final
+ * position in the output. Lines are separated by '\n', values by spaces, tabs or '\r', as read by std::getline and operator>>.
+ */
+class textParser
+{
+private:
+	/// Number of threads, at least 1
+	unsigned threads;
+
+	/// Read-only mapping of the file
+	const char* data;
+	std::size_t size;
+
+	/// Per chunk results of the counting pass
+	struct chunk_info
+	{
+		std::size_t begin;
+		std::size_t end;
+		std::vector<std::uint64_t> line_tokens; /// numbers in every line piece of the chunk, one more than its line breaks
+		std::uint64_t first_line;               /// line the chunk starts in
+		std::uint64_t first_column;             /// column of the first number of the chunk in that line
+	};
+
+	/**
+	 * @brief split cut the file into chunks at whitespace and run the counting pass on every chunk
+	 * @param chunks holds the chunks with their line and column offsets
+	 * @param line_lengths holds the number of values of every line of the file
+	 */
+	void split(std::vector<chunk_info>& chunks, std::vector<std::uint64_t>& line_lengths) const;
+
+	/**
+	 * @brief parseSerial parse the whole file on the calling thread, skipping values that are not numbers
+	 * @param rows holds the values of every line
+	 */
+	void parseSerial(std::vector<std::vector<double> >& rows) const;
+
+public:
+	/**
+	 * @brief textParser class constructor
+	 * @param num_threads number of threads to parse with, 0 uses all hardware threads
+	 */
+	explicit textParser(const unsigned num_threads = 0);
+
+	/**
+	 * @brief ~textParser class destructor, unmaps the file
+	 */
+	~textParser();
+
+	/**
+	 * @brief open map the given file for parsing
+	 * @param file_name the file name, read the values from
+	 * @return boolean value
+	 */
+	bool open(const std::string file_name);
+
+	/**
+	 * @brief close unmap the file
+	 */
+	void close();
+
+	/**
+	 * @brief bytes size of the mapped file, 0 when none is open
+	 */
+	std::size_t bytes() const;
+
+	/**
+	 * @brief parseRows parse the values of every line of the file
+	 * @param rows holds one vector of values per line
+	 */
+	void parseRows(std::vector<std::vector<double> >& rows) const;
+
+	/**
+	 * @brief parseMatrix parse the file into a matrix, one matrix row per line
+	 * @param output matrix to hold the values
+	 * @return boolean value, false if the lines do not all hold the same number of values
+	 */
+	bool parseMatrix(Eigen::MatrixXd& output) const;
+
+	/**
+	 * @brief parseNumber parse a single number the way operator>> reads a double: the longest valid prefix of the token
+	 * @param first beginning of the token
+	 * @param last end of the token
+	 * @param value holds the parsed value
+	 * @return boolean value, false if the token does not start with a number
+	 */
+	static bool parseNumber(const char* first, const char* last, double& value);
+};
+
+#endif // TEXT_PARSER_H
@@ -0,0 +1,303 @@
+#include "traceEvents.h"
+
+/// Std includes
+#include <cstring>  // std::strncpy
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <set>
+#include <utility>
+
+/// POSIX includes
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/// JSON string quoting shared with the stage report
+#include "stageProfiler.h"
+
+/**
+ * @file traceEvents.cpp
+ * @brief contains all the traceRecorder, traceScope and traceBatches member function definitions declared in .h file
+ */
+
+const std::size_t trace_chunk::capacity;
+const std::size_t traceRecorder::default_chunks;
+
+/// class constructor, recording is off until enable
+traceRecorder::traceRecorder()
+	: pool(NULL), chunks(NULL), chunk_count(0), mapped_bytes(0), started(0), owner(0)
+{
+}
+
+traceRecorder::~traceRecorder()
+{
+	if (this->pool != NULL)
+	{
+		::munmap(this->pool, this->mapped_bytes);
+	}
+}
+
+traceRecorder& traceRecorder::instance()
+{
+	static traceRecorder recorder;
+	return recorder;
+}
+
+trace_chunk*& traceRecorder::currentChunk()
+{
+	static thread_local trace_chunk* chunk = NULL;
+	return chunk;
+}
+
+const char*& traceRecorder::currentThreadName()
+{
+	static thread_local const char* name = NULL;
+	return name;
+}
+
+/// Runs in the child after a fork: the only thread left must not write to the chunk its parent keeps writing to
+void traceRecorder::forgetChunk()
+{
+	currentChunk() = NULL;
+}
+
+/// The pool is a zero-filled shared mapping: the counters, then the chunks on their own cache lines
+bool traceRecorder::enable(const std::string trace_name, const std::size_t chunks)
+{
+	if (this->pool != NULL)
+	{
+		::munmap(this->pool, this->mapped_bytes);
+		this->pool = NULL;
+	}
+	this->chunk_count = std::max<std::size_t>(chunks, 1);
+	this->mapped_bytes = 64 + sizeof(trace_chunk) * this->chunk_count;
+	void* mapping = ::mmap(NULL, this->mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (mapping == MAP_FAILED)
+	{
+		std::cerr << "Error mapping the trace buffers, the run is not traced" << std::endl;
+		return false;
+	}
+
+	static bool fork_handler = ::pthread_atfork(NULL, NULL, &traceRecorder::forgetChunk) == 0;
+	(void)fork_handler;
+	forgetChunk();
+	this->pool = static_cast<trace_pool*>(mapping);
+	this->chunks = reinterpret_cast<trace_chunk*>(static_cast<char*>(mapping) + 64);
+	this->trace_name = trace_name;
+	this->started = cycleClock::now();
+	this->owner = ::getpid();
+	cycleClock::nanosecondsPerTick();
+	return true;
+}
+
+bool traceRecorder::enabled() const
+{
+	return this->pool != NULL;
+}
+
+std::uint64_t traceRecorder::now() const
+{
+	return this->enabled() ? cycleClock::now() : 0;
+}
+
+trace_chunk* traceRecorder::writableChunk()
+{
+	trace_chunk*& chunk = currentChunk();
+	if (chunk != NULL and chunk->count.load(std::memory_order_relaxed) < trace_chunk::capacity)
+	{
+		return chunk;
+	}
+
+	const std::uint32_t index = this->pool->claimed.fetch_add(1);
+	if (index >= this->chunk_count)
+	{
+		chunk = NULL;
+		return NULL;
+	}
+	chunk = &this->chunks[index];
+	chunk->pid = ::getpid();
+	chunk->tid = static_cast<std::int32_t>(::syscall(SYS_gettid));
+	std::strncpy(chunk->thread_name, currentThreadName() != NULL ? currentThreadName() : "", sizeof(chunk->thread_name) - 1);
+	return chunk;
+}
+
+/// The event is written first, then published by the count
+void traceRecorder::complete(const char* name, const char* category, const char* detail, const std::uint64_t start, const std::int64_t arg)
+{
+	if (!this->enabled() or start == 0)
+	{
+		return;
+	}
+	const std::uint64_t end = cycleClock::now();
+	trace_chunk* chunk = this->writableChunk();
+	if (chunk == NULL)
+	{
+		this->pool->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	const std::uint32_t n = chunk->count.load(std::memory_order_relaxed);
+	trace_event& event = chunk->events[n];
+	std::strncpy(event.name, name, sizeof(event.name) - 1);
+	std::strncpy(event.category, category, sizeof(event.category) - 1);
+	std::strncpy(event.detail, detail != NULL ? detail : "", sizeof(event.detail) - 1);
+	event.start = start;
+	event.duration = end > start ? end - start : 0;
+	event.arg = arg;
+	chunk->count.store(n + 1, std::memory_order_release);
+}
+
+void traceRecorder::setThreadName(const char* name)
+{
+	currentThreadName() = name;
+	trace_chunk* chunk = currentChunk();
+	if (chunk != NULL)
+	{
+		std::strncpy(chunk->thread_name, name, sizeof(chunk->thread_name) - 1);
+	}
+}
+
+std::size_t traceRecorder::count() const
+{
+	std::size_t events = 0;
+	const std::size_t claimed = this->enabled() ? std::min<std::size_t>(this->pool->claimed.load(), this->chunk_count) : 0;
+	for (std::size_t c=0; c<claimed; ++c)
+	{
+		events += this->chunks[c].count.load(std::memory_order_acquire);
+	}
+	return events;
+}
+
+std::uint64_t traceRecorder::dropped() const
+{
+	return this->enabled() ? this->pool->dropped.load() : 0;
+}
+
+/// Complete events ("ph": "X") in microseconds from enable, with the process and thread names as metadata events
+bool traceRecorder::dump() const
+{
+	if (!this->enabled() or ::getpid() != this->owner)
+	{
+		return true;
+	}
+
+	std::ofstream file(this->trace_name);
+	if (!file.is_open())
+	{
+		std::cerr << "Error opening the trace file " << this->trace_name << std::endl;
+		return false;
+	}
+
+	const double us_per_tick = cycleClock::nanosecondsPerTick() / 1000.0;
+	const std::size_t claimed = std::min<std::size_t>(this->pool->claimed.load(), this->chunk_count);
+	std::set<std::int32_t> processes;
+	std::set<std::pair<std::int32_t, std::int32_t> > threads;
+	bool first = true;
+	auto separator = [&file, &first]()
+	{
+		file << (first ? "\n" : ",\n");
+		first = false;
+	};
+
+	file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_events\": " << this->dropped()
+		<< "}, \"traceEvents\": [";
+	for (std::size_t c=0; c<claimed; ++c)
+	{
+		const trace_chunk& chunk = this->chunks[c];
+		const std::uint32_t n = chunk.count.load(std::memory_order_acquire);
+		if (n == 0)
+		{
+			continue;
+		}
+		if (processes.insert(chunk.pid).second)
+		{
+			separator();
+			file << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << chunk.pid << ", \"tid\": " << chunk.tid
+				<< ", \"args\": {\"name\": " << (chunk.pid == this->owner ? "\"ekf\"" : "\"ekf plot worker\"") << "}}";
+		}
+		if (chunk.thread_name[0] != '\0' and threads.insert(std::make_pair(chunk.pid, chunk.tid)).second)
+		{
+			separator();
+			file << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << chunk.pid << ", \"tid\": " << chunk.tid
+				<< ", \"args\": {\"name\": " << stageProfiler::jsonString(chunk.thread_name) << "}}";
+		}
+		for (std::uint32_t e=0; e<n; ++e)
+		{
+			const trace_event& event = chunk.events[e];
+			separator();
+			file << "{\"name\": " << stageProfiler::jsonString(event.name) << ", \"cat\": " << stageProfiler::jsonString(event.category)
+				<< ", \"ph\": \"X\", \"ts\": " << (event.start > this->started ? (event.start - this->started) * us_per_tick : 0.0)
+				<< ", \"dur\": " << event.duration * us_per_tick << ", \"pid\": " << chunk.pid << ", \"tid\": " << chunk.tid << ", \"args\": {";
+			if (event.detail[0] != '\0')
+			{
+				file << "\"detail\": " << stageProfiler::jsonString(event.detail) << (event.arg >= 0 ? ", " : "");
+			}
+			if (event.arg >= 0)
+			{
+				file << "\"count\": " << event.arg;
+			}
+			file << "}}";
+		}
+	}
+	file << "\n]}\n";
+	file.close();
+	if (file.fail())
+	{
+		std::cerr << "Error writing the trace file " << this->trace_name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Nothing is read or copied while the recorder is off
+traceScope::traceScope(const char* name, const char* category, const char* detail)
+	: name(name), category(category), start(traceRecorder::instance().now()), arg(-1)
+{
+	this->detail[0] = '\0';
+	if (this->start != 0 and detail != NULL)
+	{
+		std::strncpy(this->detail, detail, sizeof(this->detail) - 1);
+		this->detail[sizeof(this->detail) - 1] = '\0';
+	}
+}
+
+traceScope::~traceScope()
+{
+	traceRecorder::instance().complete(this->name, this->category, this->detail, this->start, this->arg);
+}
+
+void traceScope::setArg(const std::int64_t arg)
+{
+	this->arg = arg;
+}
+
+/// Enough batches are skipped between two recorded ones to keep at most max_spans
+traceBatches::traceBatches(const char* name, const char* category, const std::uint64_t iterations, const std::uint64_t batch,
+	const std::uint64_t max_spans)
+	: name(name), category(category), iterations(iterations), batch(std::max<std::uint64_t>(batch, 1)), stride(1), first(0), start(0),
+	open(false)
+{
+	const std::uint64_t batches = (iterations + this->batch - 1) / this->batch;
+	const std::uint64_t spans = std::max<std::uint64_t>(max_spans, 1);
+	this->stride = std::max<std::uint64_t>(1, (batches + spans - 1) / spans);
+}
+
+void traceBatches::iteration(const std::uint64_t k)
+{
+	if (k % this->batch != 0 and k != this->iterations)
+	{
+		return;
+	}
+	if (this->open)
+	{
+		traceRecorder::instance().complete(this->name, this->category, NULL, this->start, static_cast<std::int64_t>(k - this->first));
+		this->open = false;
+	}
+	if (k < this->iterations and (k / this->batch) % this->stride == 0)
+	{
+		this->start = traceRecorder::instance().now();
+		this->first = k;
+		this->open = this->start != 0;
+	}
+}
@@ -0,0 +1,231 @@
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+/// Std includes
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+/// Calibrated cycle counter for the timestamps
+#include "latencyHistogram.h"
+
+/**
+ * @file traceEvents.h
+ * @brief contains the declaration of the tracing facility: scoped spans recorded into per-thread buffers and dumped as
+ * Chrome/Perfetto trace-event JSON (chrome://tracing, ui.perfetto.dev)
+ */
+
+/**
+ * @brief trace_event struct holds one finished span, timed in cycleClock ticks
+ * - arg: a count shown with the span (values parsed, epochs filtered, samples plotted), -1 for none
+ */
+struct trace_event
+{
+	char name[40];
+	char category[16];
+	char detail[48];
+	std::uint64_t start;
+	std::uint64_t duration;
+	std::int64_t arg;
+};
+
+/**
+ * @brief trace_chunk struct is a block of events written by a single thread; count is published after each event
+ */
+struct trace_chunk
+{
+	static const std::size_t capacity = 254;
+
+	std::atomic<std::uint32_t> count;
+	std::int32_t pid;
+	std::int32_t tid;
+	char thread_name[36];
+	trace_event events[capacity];
+};
+
+/**
+ * @brief The traceRecorder class collects the spans of every thread of ekf and of its forked plot workers. The events live in a
+ * shared anonymous mapping cut into chunks: a thread claims a chunk with one atomic increment the first time it records, and a
+ * new one when it is full, then writes its events with no lock and no allocation. A forked child starts on chunks of its own.
+ * Only the process that enabled the recorder dumps the trace, once every traced thread and child has finished.
+ * The TRACE_* macros below are the interface used by ekf; built without POINTONENAV_TRACE (-DTRACING=OFF, the default) they
+ * compile to nothing, so tracing costs nothing unless it is built in.
+ */
+class traceRecorder
+{
+private:
+	/// Shared with the forked children: the chunks claimed and the events dropped once all are, then the chunks
+	struct trace_pool
+	{
+		std::atomic<std::uint32_t> claimed;
+		std::atomic<std::uint64_t> dropped;
+	};
+	trace_pool* pool;
+	trace_chunk* chunks;
+	std::size_t chunk_count;
+	std::size_t mapped_bytes;
+
+	std::string trace_name;
+	std::uint64_t started;
+	std::int32_t owner;
+
+	/// Chunk the calling thread writes to, NULL until its first event, reset in forked children
+	static trace_chunk*& currentChunk();
+	static const char*& currentThreadName();
+	static void forgetChunk();
+
+	/// A chunk with room for one more event, claiming a new one when needed; NULL once the pool is used up
+	trace_chunk* writableChunk();
+
+public:
+	/// Chunks in the pool, about 32 MB of address space, only the pages written are backed by memory
+	static const std::size_t default_chunks = 1024;
+
+	traceRecorder();
+	~traceRecorder();
+
+	/**
+	 * @brief instance the recorder of the process, used by the TRACE_* macros
+	 */
+	static traceRecorder& instance();
+
+	/**
+	 * @brief enable start recording; must be called before the plot workers are forked
+	 * @param trace_name the trace-event JSON file written by dump
+	 * @param chunks number of chunks of 254 events in the pool
+	 * @return boolean value, false if the pool could not be mapped
+	 */
+	bool enable(const std::string trace_name, const std::size_t chunks = default_chunks);
+
+	/**
+	 * @brief enabled whether spans are recorded
+	 */
+	bool enabled() const;
+
+	/**
+	 * @brief now ticks of the cycle counter, 0 while disabled
+	 */
+	std::uint64_t now() const;
+
+	/**
+	 * @brief complete record a span of the calling thread
+	 * @param name the span, copied
+	 * @param category its category, e.g. "io", "parse", "filter", "plot"
+	 * @param detail what it runs on, e.g. a file name, may be NULL
+	 * @param start ticks at its start, from now()
+	 * @param arg the count shown with it, -1 for none
+	 */
+	void complete(const char* name, const char* category, const char* detail, const std::uint64_t start, const std::int64_t arg);
+
+	/**
+	 * @brief setThreadName name the calling thread in the trace
+	 * @param name the name, a string literal: only the pointer is kept until the next chunk is claimed
+	 */
+	void setThreadName(const char* name);
+
+	/**
+	 * @brief count number of events recorded so far by every thread and child
+	 */
+	std::size_t count() const;
+
+	/**
+	 * @brief dropped number of events lost once the pool was used up
+	 */
+	std::uint64_t dropped() const;
+
+	/**
+	 * @brief dump write the trace-event JSON of the events recorded so far; only the process that enabled the recorder writes it
+	 * @return boolean value
+	 */
+	bool dump() const;
+};
+
+/**
+ * @brief The traceScope class records the enclosing scope as one span when it is left by any path
+ */
+class traceScope
+{
+private:
+	const char* name;
+	const char* category;
+	char detail[48];
+	std::uint64_t start;
+	std::int64_t arg;
+
+public:
+	/**
+	 * @brief traceScope class constructor, starts the span
+	 * @param name the span, a string literal
+	 * @param category its category, a string literal
+	 * @param detail what it runs on, copied, may be NULL
+	 */
+	traceScope(const char* name, const char* category, const char* detail = NULL);
+
+	/**
+	 * @brief traceScope class destructor, records the span
+	 */
+	~traceScope();
+
+	/**
+	 * @brief setArg set the count shown with the span
+	 */
+	void setArg(const std::int64_t arg);
+};
+
+/**
+ * @brief The traceBatches class records a long loop as spans of batch iterations, at most max_spans of them spread evenly over
+ * the loop (every stride-th batch), so a run of any length gives a trace of bounded size
+ */
+class traceBatches
+{
+private:
+	const char* name;
+	const char* category;
+	std::uint64_t iterations;
+	std::uint64_t batch;
+	std::uint64_t stride;
+	std::uint64_t first;
+	std::uint64_t start;
+	bool open;
+
+public:
+	/**
+	 * @brief traceBatches class constructor
+	 * @param name the spans, a string literal
+	 * @param category their category, a string literal
+	 * @param iterations number of iterations of the loop
+	 * @param batch iterations per span
+	 * @param max_spans most spans recorded
+	 */
+	traceBatches(const char* name, const char* category, const std::uint64_t iterations, const std::uint64_t batch = 1024,
+		const std::uint64_t max_spans = 256);
+
+	/**
+	 * @brief iteration called at the start of every iteration k, and with k = iterations after the loop to close the last span
+	 */
+	void iteration(const std::uint64_t k);
+};
+
+/// Tracing, compiled in with POINTONENAV_TRACE (-DTRACING=ON):
+/// - TRACE_SCOPE / TRACE_ARG record the rest of a scope as a span, TRACE_BATCHES / TRACE_ITERATION a loop as sampled batches
+/// - TRACE_THREAD_NAME names the calling thread, TRACE_ENABLE starts recording and TRACE_DUMP writes the JSON
+#ifdef POINTONENAV_TRACE
+#define TRACE_ENABLE(file) traceRecorder::instance().enable(file)
+#define TRACE_SCOPE(scope, name, category, detail) traceScope scope(name, category, detail)
+#define TRACE_ARG(scope, arg) scope.setArg(arg)
+#define TRACE_BATCHES(batches, name, category, iterations) traceBatches batches(name, category, iterations)
+#define TRACE_ITERATION(batches, k) batches.iteration(k)
+#define TRACE_THREAD_NAME(name) traceRecorder::instance().setThreadName(name)
+#define TRACE_DUMP() traceRecorder::instance().dump()
+#else
+#define TRACE_ENABLE(file) false
+#define TRACE_SCOPE(scope, name, category, detail) do {} while (0)
+#define TRACE_ARG(scope, arg) do {} while (0)
+#define TRACE_BATCHES(batches, name, category, iterations) do {} while (0)
+#define TRACE_ITERATION(batches, k) do {} while (0)
+#define TRACE_THREAD_NAME(name) do {} while (0)
+#define TRACE_DUMP() true
+#endif
+
+#endif // TRACE_EVENTS_H
@@ -0,0 +1,227 @@
+/**
+ * @file test_asyncOutputSink.cpp
+ * @brief asynchronous output sink writing the per-epoch filter results from a background thread
+ * @function asyncOutputSink::push(epoch_result), asyncOutputSink::shutdown()
+ * @note test cases check that every result is written in order on shutdown, the three backpressure policies and the binary records
+ * @note the slow storage test runs the filter against a held destination and checks the loop completes before anything is written
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/asyncOutputSink.h"
+
+namespace
+{
+	/// Destination collecting everything written, optionally slowed down or held until released
+	struct test_destination
+	{
+		std::mutex lock;
+		std::string data;
+		std::atomic<bool> hold;
+		std::chrono::microseconds delay;
+
+		test_destination() : hold(false), delay(0) {}
+
+		bufferedWriter::destination get()
+		{
+			return [this](const char* bytes, std::size_t n)
+			{
+				while (this->hold.load())
+				{
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+				}
+				std::this_thread::sleep_for(this->delay);
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->data.append(bytes, n);
+				return true;
+			};
+		}
+	};
+
+	epoch_result makeResult(std::uint64_t k)
+	{
+		epoch_result result;
+		result.epoch = k;
+		result.state[0] = -3.2e4 + k;
+		result.state[1] = 25.9;
+		for (int i=0; i<4; ++i)
+		{
+			result.covariance[i] = 0.01 * (i+1);
+		}
+		result.nis = 1.0 / (k+1);
+		return result;
+	}
+
+	TEST(asyncOutputSink, push_text)
+	{
+		test_destination dest;
+		asyncOutputSink sink(dest.get(), sink_format::text, backpressure_policy::block, 16, 256);
+		for (std::uint64_t k=0; k<1000; ++k)
+		{
+			ASSERT_TRUE(sink.push(makeResult(k)));
+		}
+		ASSERT_TRUE(sink.shutdown());
+		EXPECT_EQ(sink.written(), 1000);
+
+		std::stringstream ss(dest.data);
+		std::string line;
+		std::uint64_t k = 0;
+		while (std::getline(ss, line))
+		{
+			EXPECT_EQ(std::strtoull(line.c_str(), NULL, 10), k);
+			EXPECT_EQ(std::count(line.begin(), line.end(), ','), 7);
+			k++;
+		}
+		EXPECT_EQ(k, 1000);
+	}
+
+	TEST(asyncOutputSink, push_binary)
+	{
+		test_destination dest;
+		asyncOutputSink sink(dest.get(), sink_format::binary, backpressure_policy::block);
+		for (std::uint64_t k=0; k<500; ++k)
+		{
+			sink.push(makeResult(k));
+		}
+		ASSERT_TRUE(sink.shutdown());
+
+		ASSERT_EQ(dest.data.size(), 500 * sizeof(epoch_result));
+		const epoch_result* records = reinterpret_cast<const epoch_result*>(dest.data.data());
+		for (std::uint64_t k=0; k<500; ++k)
+		{
+			EXPECT_EQ(records[k].epoch, k);
+			EXPECT_EQ(records[k].state[0], makeResult(k).state[0]);
+			EXPECT_EQ(records[k].nis, makeResult(k).nis);
+		}
+	}
+
+	TEST(asyncOutputSink, backpressure_drop)
+	{
+		test_destination dest;
+		dest.hold = true;
+		asyncOutputSink sink(dest.get(), sink_format::text, backpressure_policy::drop, 8, 64);
+		std::uint64_t accepted = 0;
+		for (std::uint64_t k=0; k<1000; ++k)
+		{
+			accepted += sink.push(makeResult(k));
+		}
+		dest.hold = false;
+		ASSERT_TRUE(sink.shutdown());
+
+		EXPECT_GT(sink.dropped(), 0);
+		EXPECT_EQ(sink.dropped() + accepted, 1000);
+		EXPECT_EQ(sink.written(), accepted);
+	}
+
+	TEST(asyncOutputSink, backpressure_grow)
+	{
+		test_destination dest;
+		dest.hold = true;
+		asyncOutputSink sink(dest.get(), sink_format::text, backpressure_policy::grow, 8, 64);
+		for (std::uint64_t k=0; k<5000; ++k)
+		{
+			ASSERT_TRUE(sink.push(makeResult(k)));
+		}
+		dest.hold = false;
+		ASSERT_TRUE(sink.shutdown());
+
+		EXPECT_EQ(sink.dropped(), 0);
+		EXPECT_EQ(sink.written(), 5000);
+		EXPECT_EQ(std::count(dest.data.begin(), dest.data.end(), '\n'), 5000);
+	}
+
+	TEST(asyncOutputSink, output_file)
+	{
+		{
+			asyncOutputSink sink("test_asyncOutputSink.txt", sink_format::text, backpressure_policy::block);
+			ASSERT_TRUE(sink.isOpen());
+			for (std::uint64_t k=0; k<100; ++k)
+			{
+				sink.push(makeResult(k));
+			}
+		}
+		std::ifstream file_in("../filter_output/test_asyncOutputSink.txt");
+		std::string line;
+		int lines = 0;
+		while (std::getline(file_in, line))
+		{
+			lines++;
+		}
+		EXPECT_EQ(lines, 100);
+		remove("../filter_output/test_asyncOutputSink.txt");
+
+		asyncOutputSink bad_sink("../filter____output/test_asyncOutputSink.txt", sink_format::text, backpressure_policy::block);
+		EXPECT_FALSE(bad_sink.isOpen());
+		EXPECT_FALSE(bad_sink.shutdown());
+	}
+
+	/// The filter loop never waits for the storage: with the destination held, the loop over every epoch completes before a byte
+	/// is written, and once released everything arrives in order. The filter step time with a slow sink is in bench_outputSink
+	TEST(asyncOutputSink, slow_storage)
+	{
+		filter_input f_in;
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->getInputData("initial_state_estimate.txt", f_in.initial_state_estimate);
+		clockModel->getInputData("initial_state_estimate_covariance.txt", f_in.initial_state_estimate_covariance);
+		clockModel->getInputData("measurement_noise_covariance.txt", f_in.measurement_noise_covariance);
+		clockModel->getInputData("process_noise_covariance.txt", f_in.process_noise_covariance);
+		clockModel->getInputData("measurement_history.txt", f_in.measurement_history);
+
+		test_destination dest;
+		dest.hold = true;
+		dest.delay = std::chrono::microseconds(1000);
+		asyncOutputSink sink(dest.get(), sink_format::text, backpressure_policy::grow, 64, 4096);
+		mat xk_est = f_in.initial_state_estimate;
+		mat xcovk_est = f_in.initial_state_estimate_covariance;
+		mat w_k = mat::Zero(2,1);
+		mat v_kp1 = mat::Zero(2,1);
+		std::vector<double> bias;
+		for (int kp1=0; kp1<f_in.measurement_history.cols(); ++kp1)
+		{
+			mat y_kp1 = f_in.measurement_history.col(kp1);
+			clockModel->simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, y_kp1, v_kp1, f_in.measurement_noise_covariance);
+			xk_est = clockModel->get_xkp1();
+			xcovk_est = clockModel->get_xcov_kp1();
+			epoch_result result = makeResult(kp1);
+			result.state[0] = xk_est(0);
+			ASSERT_TRUE(sink.push(result));
+			bias.push_back(xk_est(0));
+		}
+		{
+			std::lock_guard<std::mutex> guard(dest.lock);
+			EXPECT_TRUE(dest.data.empty());
+		}
+		dest.hold = false;
+		ASSERT_TRUE(sink.shutdown());
+		EXPECT_EQ(sink.dropped(), 0);
+		EXPECT_EQ(sink.written(), bias.size());
+
+		/// "<epoch>,<bias>,..." per line, in the order pushed
+		std::stringstream ss(dest.data);
+		std::string line;
+		std::size_t k = 0;
+		while (std::getline(ss, line) and k < bias.size())
+		{
+			char* field = NULL;
+			EXPECT_EQ(std::strtoull(line.c_str(), &field, 10), k);
+			EXPECT_NEAR(std::strtod(field + 1, NULL), bias[k], 1e-9 * std::fabs(bias[k]));
+			k++;
+		}
+		EXPECT_EQ(k, bias.size());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
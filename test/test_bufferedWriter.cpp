@@ -0,0 +1,156 @@
+/**
+ * @file test_bufferedWriter.cpp
+ * @brief buffered output formatting used to write the filter outputs to text files
+ * @function bufferedWriter, twoStateClockModel::writeToFile(std::string, mat, matrix_layout, number_style)
+ * @note test cases check that both number styles read back to the exact values written, in both matrix layouts
+ * @note the large output test writes many times the size of the buffer
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/bufferedWriter.h"
+
+namespace
+{
+	/// Matrix with values spread over many orders of magnitude, signs and a few exact zeros
+	mat testMatrix(int rows, int cols)
+	{
+		mat m = mat::Random(rows, cols);
+		for (int j=0; j<cols; ++j)
+		{
+			m(0,j) *= 1.0e5;
+			m(rows-1,j) *= 1.0e-7;
+		}
+		m(0,0) = 0.0;
+		return m;
+	}
+
+	TEST(bufferedWriter, writeToFile_fixed16)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		mat file_contents = testMatrix(2, 500);
+		std::string file_name = "test_bufferedWriter.txt";
+		ASSERT_TRUE(clockModel->writeToFile(file_name, file_contents, matrix_layout::matrix, number_style::fixed16));
+
+		std::vector<std::vector<double> > values_from_file;
+		ASSERT_TRUE(clockModel->readFromFile("../filter_output/" + file_name, values_from_file));
+		ASSERT_EQ(values_from_file.size(), 2);
+		for (int i=0; i<2; ++i)
+		{
+			ASSERT_EQ(values_from_file[i].size(), 500);
+			for (int j=0; j<500; ++j)
+			{
+				EXPECT_EQ(values_from_file[i][j], file_contents(i,j));
+			}
+		}
+		remove(("../filter_output/" + file_name).c_str());
+	}
+
+	TEST(bufferedWriter, writeToFile_shortest)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		mat file_contents = testMatrix(2, 500);
+		file_contents(1,1) = 0.1;
+		file_contents(1,2) = 25.907051059734886;
+		std::string file_name = "test_bufferedWriter.txt";
+		ASSERT_TRUE(clockModel->writeToFile(file_name, file_contents, matrix_layout::matrix, number_style::shortest));
+
+		std::vector<std::vector<double> > values_from_file;
+		ASSERT_TRUE(clockModel->readFromFile("../filter_output/" + file_name, values_from_file));
+		ASSERT_EQ(values_from_file.size(), 2);
+		for (int i=0; i<2; ++i)
+		{
+			ASSERT_EQ(values_from_file[i].size(), 500);
+			for (int j=0; j<500; ++j)
+			{
+				EXPECT_EQ(values_from_file[i][j], file_contents(i,j));
+			}
+		}
+		remove(("../filter_output/" + file_name).c_str());
+	}
+
+	TEST(bufferedWriter, writeToFile_csv_rows)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		mat file_contents = testMatrix(2, 300);
+		std::string file_name = "test_bufferedWriter.csv";
+		ASSERT_TRUE(clockModel->writeToFile(file_name, file_contents, matrix_layout::csv_rows, number_style::fixed16));
+
+		std::ifstream file_in("../filter_output/" + file_name);
+		std::string line;
+		int j = 0;
+		while (std::getline(file_in, line))
+		{
+			ASSERT_LT(j, 300);
+			std::size_t comma = line.find(',');
+			ASSERT_NE(comma, std::string::npos);
+			EXPECT_EQ(std::strtod(line.substr(0, comma).c_str(), NULL), file_contents(0,j));
+			EXPECT_EQ(std::strtod(line.substr(comma+1).c_str(), NULL), file_contents(1,j));
+			j++;
+		}
+		EXPECT_EQ(j, 300);
+		remove(("../filter_output/" + file_name).c_str());
+	}
+
+	TEST(bufferedWriter, formatDouble_fixed16)
+	{
+		const double values[] = {0.0, -0.0, 1.0, -3.2168832582847695e+04, 2.0814695877451838e-02, 1.0e100, -1.0e-300, 5.9915};
+		for (auto value : values)
+		{
+			char expected[64], formatted[64];
+			std::snprintf(expected, sizeof(expected), "%.16e", value);
+			char* last = bufferedWriter::formatDouble(formatted, value, number_style::fixed16);
+			EXPECT_EQ(std::string(formatted, last), std::string(expected));
+		}
+	}
+
+	TEST(bufferedWriter, writeToFile_2)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		mat file_contents = mat::Identity(10,2);
+		std::string file_name = "../filter____output/test_bufferedWriter.txt";
+		bool file_write = clockModel->writeToFile(file_name, file_contents, matrix_layout::csv_rows, number_style::shortest);
+
+		ASSERT_FALSE(file_write);
+	}
+
+	/// Output many times the size of the buffer: every byte counted reaches the file and every value reads back exactly; the
+	/// throughput is measured by BM_writeToFile in bench/bench_fileIO.cpp
+	TEST(bufferedWriter, large_output)
+	{
+		mat file_contents = testMatrix(2, 200000);
+		std::string file_name = "../filter_output/test_bufferedWriter_large.txt";
+
+		bufferedWriter writer;
+		ASSERT_TRUE(writer.open(file_name));
+		writer.putMatrix(file_contents, matrix_layout::matrix, number_style::fixed16);
+		ASSERT_TRUE(writer.close());
+
+		std::ifstream file_in(file_name, std::ifstream::ate | std::ifstream::binary);
+		EXPECT_EQ(static_cast<std::int64_t>(file_in.tellg()), static_cast<std::int64_t>(writer.bytesWritten()));
+		file_in.seekg(0);
+		for (int i=0; i<file_contents.rows(); ++i)
+		{
+			for (int j=0; j<file_contents.cols(); ++j)
+			{
+				std::string value;
+				ASSERT_TRUE(static_cast<bool>(file_in >> value));
+				ASSERT_EQ(std::strtod(value.c_str(), NULL), file_contents(i,j));
+			}
+		}
+		std::string rest;
+		EXPECT_FALSE(static_cast<bool>(file_in >> rest));
+		remove(file_name.c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
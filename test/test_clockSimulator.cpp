@@ -0,0 +1,242 @@
+/**
+ * @file test_clockSimulator.cpp
+ * @brief synthetic dataset generator, the two-state clock model simulated with its ground truth in the filter_input layout
+ * @function clockSimulator::simulate(unsigned, uint64_t, uint64_t, MatrixXd, MatrixXd), clockSimulator::write(std::string, bool),
+ *           twoStateClockModel::setInputDir(std::string), clockSimulator::readModel(std::string, simulation_config),
+ *           clockSimulator::parseOption(int, char**, int, simulation_config)
+ * @note test cases check that the dataset only depends on the seed, that the noise follows Q and R, that the written files
+ *       read back through getInputData and the parsed-input cache, and the model and options the tools configure it with
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/inputCache.h"
+#include "../src/clockSimulator.h"
+
+namespace
+{
+	const std::string output_dir = "../filter_output/test_clockSimulator";
+
+	simulation_config testConfig()
+	{
+		simulation_config config;
+		config.epochs = 3 * clockSimulator::block_epochs + 123;
+		config.seed = 42;
+		config.initial_state << -32186.470260709215, 26.07840844955248;
+		config.initial_covariance << 49.0, 0.0, 0.0, 0.04;
+		config.process_noise_covariance << 0.020814695877451838, 0.017740716135125494, 0.017740716135125494, 0.035481432270250989;
+		config.measurement_noise_covariance << 49.0, 0.0, 0.0, 0.04;
+		return config;
+	}
+
+	void removeOutput()
+	{
+		for (std::string name : {"initial_state_estimate.txt", "initial_state_estimate_covariance.txt", "process_noise_covariance.txt",
+			"measurement_noise_covariance.txt", "measurement_history.txt", "truth.txt"})
+		{
+			std::string file_name = output_dir + "/" + name;
+			remove(file_name.c_str());
+			remove(inputCache::sidecarName(file_name).c_str());
+		}
+		remove(output_dir.c_str());
+	}
+
+	TEST(clockSimulator, same_seed_any_threads)
+	{
+		simulation_config config = testConfig();
+		config.dropout_rate = 0.1;
+		config.outlier_rate = 0.01;
+		config.jump_rate = 0.001;
+		config.jump_sigma = 100.0;
+		config.threads = 1;
+		clockSimulator serial(config);
+		config.threads = 4;
+		clockSimulator parallel(config);
+
+		Eigen::MatrixXd truth_1, measurements_1, truth_4, measurements_4;
+		ASSERT_TRUE(serial.simulate(0, 0, config.epochs, truth_1, measurements_1));
+		ASSERT_TRUE(parallel.simulate(0, 0, config.epochs, truth_4, measurements_4));
+		EXPECT_TRUE(truth_1 == truth_4);
+		EXPECT_TRUE(measurements_1.array().isNaN().matrix() == measurements_4.array().isNaN().matrix());
+		EXPECT_TRUE(measurements_1.array().isNaN().select(0.0, measurements_1).matrix() ==
+			measurements_4.array().isNaN().select(0.0, measurements_4).matrix());
+
+		/// Another seed is another dataset
+		config.seed = 43;
+		clockSimulator other(config);
+		ASSERT_TRUE(other.simulate(0, 0, config.epochs, truth_4, measurements_4));
+		EXPECT_FALSE(truth_1 == truth_4);
+	}
+
+	TEST(clockSimulator, windows_match_full_run)
+	{
+		simulation_config config = testConfig();
+		config.clocks = 2;
+		clockSimulator simulator(config);
+
+		Eigen::MatrixXd truth, measurements, window_truth, window_measurements;
+		ASSERT_TRUE(simulator.simulate(1, 0, config.epochs, truth, measurements));
+
+		/// A window crossing two block boundaries, starting inside a block
+		const std::uint64_t first = clockSimulator::block_epochs - 7;
+		const std::uint64_t count = clockSimulator::block_epochs + 20;
+		ASSERT_TRUE(simulator.simulate(1, first, count, window_truth, window_measurements));
+		EXPECT_TRUE(window_truth == truth.middleCols(first, count));
+		EXPECT_TRUE(window_measurements == measurements.middleCols(first, count));
+
+		/// Clocks are independent
+		Eigen::MatrixXd truth_0, measurements_0;
+		ASSERT_TRUE(simulator.simulate(0, 0, config.epochs, truth_0, measurements_0));
+		EXPECT_FALSE(truth_0 == truth);
+
+		EXPECT_FALSE(simulator.simulate(2, 0, 1, truth, measurements));
+		EXPECT_FALSE(simulator.simulate(0, config.epochs - 1, 2, truth, measurements));
+	}
+
+	TEST(clockSimulator, noise_statistics)
+	{
+		simulation_config config = testConfig();
+		clockSimulator simulator(config);
+		Eigen::MatrixXd truth, measurements;
+		ASSERT_TRUE(simulator.simulate(0, 0, config.epochs, truth, measurements));
+		const double n = static_cast<double>(config.epochs - 1);
+
+		/// Process noise: w(k) = x(k+1) - F x(k)
+		Eigen::MatrixXd w = truth.rightCols(config.epochs - 1) - truth.leftCols(config.epochs - 1);
+		w.row(0) -= config.dt * truth.row(1).leftCols(config.epochs - 1);
+		Eigen::Matrix2d q = w * w.transpose() / n;
+		EXPECT_NEAR(q(0, 0), config.process_noise_covariance(0, 0), 0.01 * config.process_noise_covariance(0, 0));
+		EXPECT_NEAR(q(0, 1), config.process_noise_covariance(0, 1), 0.01 * config.process_noise_covariance(0, 0));
+		EXPECT_NEAR(q(1, 1), config.process_noise_covariance(1, 1), 0.01 * config.process_noise_covariance(1, 1));
+
+		/// Measurement noise: v(k) = y(k) - x(k)
+		Eigen::MatrixXd v = measurements - truth;
+		Eigen::Matrix2d r = v * v.transpose() / n;
+		EXPECT_NEAR(r(0, 0), config.measurement_noise_covariance(0, 0), 0.01 * config.measurement_noise_covariance(0, 0));
+		EXPECT_NEAR(r(0, 1), 0.0, 0.01 * std::sqrt(config.measurement_noise_covariance(0, 0) * config.measurement_noise_covariance(1, 1)));
+		EXPECT_NEAR(r(1, 1), config.measurement_noise_covariance(1, 1), 0.01 * config.measurement_noise_covariance(1, 1));
+	}
+
+	TEST(clockSimulator, dropouts_outliers_jumps)
+	{
+		simulation_config config = testConfig();
+		config.dropout_rate = 0.05;
+		config.outlier_rate = 0.02;
+		config.outlier_scale = 20.0;
+		clockSimulator simulator(config);
+		Eigen::MatrixXd truth, measurements;
+		ASSERT_TRUE(simulator.simulate(0, 0, config.epochs, truth, measurements));
+
+		/// Dropouts are whole columns
+		const double dropouts = measurements.row(0).array().isNaN().count();
+		EXPECT_EQ(dropouts, measurements.row(1).array().isNaN().count());
+		EXPECT_NEAR(dropouts / config.epochs, config.dropout_rate, 0.005);
+
+		/// Outliers: residuals past 5 sigma only come from the scaled noise
+		const double sigma = std::sqrt(config.measurement_noise_covariance(0, 0));
+		const double outliers = ((measurements.row(0) - truth.row(0)).array().abs() > 5.0 * sigma).count();
+		EXPECT_NEAR(outliers / (config.epochs - dropouts), config.outlier_rate * 0.8, 0.005);
+
+		/// Jumps move the truth, not the rate
+		config.dropout_rate = 0.0;
+		config.outlier_rate = 0.0;
+		config.jump_rate = 0.01;
+		config.jump_sigma = 1000.0;
+		clockSimulator jumping(config);
+		Eigen::MatrixXd jump_truth, jump_measurements;
+		ASSERT_TRUE(jumping.simulate(0, 0, config.epochs, jump_truth, jump_measurements));
+		EXPECT_TRUE(jump_truth.row(1) == truth.row(1));
+		const Eigen::RowVectorXd steps = jump_truth.row(0).rightCols(config.epochs - 1) - jump_truth.row(0).leftCols(config.epochs - 1) -
+			config.dt * jump_truth.row(1).leftCols(config.epochs - 1);
+		EXPECT_NEAR((steps.array().abs() > 100.0).count() / static_cast<double>(config.epochs), config.jump_rate, 0.002);
+	}
+
+	TEST(clockSimulator, write_and_read_back)
+	{
+		simulation_config config = testConfig();
+		config.epochs = clockSimulator::block_epochs + 1000;
+		config.dropout_rate = 0.05;
+		config.threads = 3;
+		clockSimulator simulator(config);
+		ASSERT_TRUE(simulator.write(output_dir, true));
+
+		Eigen::MatrixXd truth, measurements;
+		ASSERT_TRUE(simulator.simulate(0, 0, config.epochs, truth, measurements));
+
+		/// The text files, parsed by the filter
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setInputCache(false);
+		clockModel->setInputDir(output_dir);
+		filter_input f_in;
+		clockModel->getInputData("initial_state_estimate.txt", f_in.initial_state_estimate);
+		clockModel->getInputData("initial_state_estimate_covariance.txt", f_in.initial_state_estimate_covariance);
+		clockModel->getInputData("measurement_noise_covariance.txt", f_in.measurement_noise_covariance);
+		clockModel->getInputData("process_noise_covariance.txt", f_in.process_noise_covariance);
+		clockModel->getInputData("measurement_history.txt", f_in.measurement_history);
+		EXPECT_TRUE(clockModel->checkInputs(f_in));
+		EXPECT_TRUE(f_in.process_noise_covariance == config.process_noise_covariance);
+		EXPECT_TRUE(f_in.initial_state_estimate == config.initial_state);
+
+		mat parsed_truth;
+		clockModel->getInputData("truth.txt", parsed_truth);
+		EXPECT_TRUE(parsed_truth == truth);
+		ASSERT_EQ(f_in.measurement_history.cols(), static_cast<Eigen::Index>(config.epochs));
+		EXPECT_TRUE(f_in.measurement_history.array().isNaN().matrix() == measurements.array().isNaN().matrix());
+		EXPECT_TRUE(f_in.measurement_history.array().isNaN().select(0.0, f_in.measurement_history).matrix() ==
+			measurements.array().isNaN().select(0.0, measurements).matrix());
+
+		/// The binary sidecars hold the same values
+		mat cached;
+		ASSERT_TRUE(inputCache::load(output_dir + "/truth.txt", cached, true));
+		EXPECT_TRUE(cached == truth);
+		ASSERT_TRUE(inputCache::load(output_dir + "/measurement_history.txt", cached, true));
+		EXPECT_TRUE(cached.array().isNaN().select(0.0, cached).matrix() == measurements.array().isNaN().select(0.0, measurements).matrix());
+
+		removeOutput();
+	}
+
+	/// The model of filter_input as the tools read it, and the dataset options they share
+	TEST(clockSimulator, readModel_parseOption)
+	{
+		simulation_config config;
+		ASSERT_TRUE(clockSimulator::readModel("../filter_input", config));
+		simulation_config expected = testConfig();
+		EXPECT_EQ(config.initial_state, expected.initial_state);
+		EXPECT_EQ(config.initial_covariance, expected.initial_covariance);
+		EXPECT_EQ(config.process_noise_covariance, expected.process_noise_covariance);
+		EXPECT_EQ(config.measurement_noise_covariance, expected.measurement_noise_covariance);
+		EXPECT_FALSE(clockSimulator::readModel("../filter_output/test_clockSimulator_missing", config));
+
+		const char* args[] = {"tool", "--epochs", "5000", "--dt", "0.5", "--outlier-scale", "8", "--binary", "--seed"};
+		char** argv = const_cast<char**>(args);
+		const int argc = 9;
+		int i = 1;
+		ASSERT_TRUE(clockSimulator::parseOption(argc, argv, i, config));
+		EXPECT_EQ(i, 2);
+		EXPECT_EQ(config.epochs, 5000u);
+		i = 3;
+		ASSERT_TRUE(clockSimulator::parseOption(argc, argv, i, config));
+		EXPECT_EQ(config.dt, 0.5);
+		i = 5;
+		ASSERT_TRUE(clockSimulator::parseOption(argc, argv, i, config));
+		EXPECT_EQ(config.outlier_scale, 8.0);
+
+		/// An option of the tool itself, and one without its value
+		i = 7;
+		EXPECT_FALSE(clockSimulator::parseOption(argc, argv, i, config));
+		EXPECT_EQ(i, 7);
+		i = 8;
+		EXPECT_FALSE(clockSimulator::parseOption(argc, argv, i, config));
+		EXPECT_EQ(config.seed, 1u);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
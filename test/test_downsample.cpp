@@ -0,0 +1,185 @@
+/**
+ * @file test_downsample.cpp
+ * @brief decimation of long series before plotting
+ * @function downsample::lttb(double*, double*, size_t, size_t, std::vector<size_t>, double), downsample::minMax(double*, size_t, size_t, std::vector<size_t>)
+ * @note test cases check the number and order of the kept points, that spikes above the threshold and gaps survive,
+ *       and that min_max keeps the exact envelope of every bucket
+ * @note the decimation time per sample is measured by BM_downsample_select in bench/bench_matPlot.cpp
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/downsample.h"
+
+namespace
+{
+	/// NIS like series: chi-squared with 2 degrees of freedom, time axis in seconds
+	void nisSeries(std::size_t n, std::vector<double>& t, std::vector<double>& nis)
+	{
+		std::mt19937_64 rng(7);
+		std::exponential_distribution<double> dist(0.5);
+		t.resize(n);
+		nis.resize(n);
+		for (std::size_t i=0; i<n; ++i)
+		{
+			t[i] = static_cast<double>(i);
+			nis[i] = dist(rng);
+		}
+	}
+
+	bool increasing(const std::vector<std::size_t>& indices)
+	{
+		for (std::size_t i=1; i<indices.size(); ++i)
+		{
+			if (indices[i] <= indices[i-1])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	TEST(downsample, lttb_count)
+	{
+		std::vector<double> t, nis;
+		nisSeries(100000, t, nis);
+		std::vector<std::size_t> kept;
+		downsample::lttb(t.data(), nis.data(), t.size(), 1000, kept);
+		EXPECT_EQ(kept.size(), 1000u);
+		EXPECT_TRUE(increasing(kept));
+		EXPECT_EQ(kept.front(), 0u);
+		EXPECT_EQ(kept.back(), t.size() - 1);
+
+		/// Short series are not touched
+		downsample::lttb(t.data(), nis.data(), 500, 1000, kept);
+		EXPECT_EQ(kept.size(), 500u);
+	}
+
+	TEST(downsample, lttb_shape)
+	{
+		/// A straight line with a single outlier: the outlier is the largest triangle of its bucket
+		std::vector<double> t(10000), y(10000);
+		for (std::size_t i=0; i<t.size(); ++i)
+		{
+			t[i] = i;
+			y[i] = 0.001 * i;
+		}
+		y[4321] = 50.0;
+		std::vector<std::size_t> kept;
+		downsample::lttb(t.data(), y.data(), t.size(), 100, kept);
+		EXPECT_NE(std::find(kept.begin(), kept.end(), 4321u), kept.end());
+	}
+
+	TEST(downsample, spikes_above_threshold)
+	{
+		const double gamma_high = 5.9915;
+		std::vector<double> t, nis;
+		nisSeries(1000000, t, nis);
+
+		for (auto method : {decimation_method::lttb, decimation_method::min_max})
+		{
+			std::vector<std::size_t> kept;
+			downsample::select(method, t, nis, 2000, kept, gamma_high);
+			ASSERT_TRUE(increasing(kept));
+
+			/// Every bucket with a spike still shows it: the largest value of each stretch between kept points
+			/// above the threshold is among the kept values
+			double max_all = *std::max_element(nis.begin(), nis.end());
+			std::vector<double> values = downsample::gather(nis, kept);
+			EXPECT_EQ(*std::max_element(values.begin(), values.end()), max_all);
+
+			std::size_t bucket = nis.size() / 1000;
+			for (std::size_t b=0; b<1000; ++b)
+			{
+				double max_bucket = *std::max_element(nis.begin() + b*bucket, nis.begin() + (b+1)*bucket);
+				if (max_bucket > gamma_high)
+				{
+					auto first = std::lower_bound(kept.begin(), kept.end(), b*bucket);
+					auto last = std::lower_bound(kept.begin(), kept.end(), (b+1)*bucket);
+					bool spike = false;
+					for (auto it=first; it!=last; ++it)
+					{
+						spike = spike or nis[*it] > gamma_high;
+					}
+					EXPECT_TRUE(spike) << "bucket " << b;
+				}
+			}
+		}
+	}
+
+	TEST(downsample, minMax_envelope)
+	{
+		std::vector<double> t, nis;
+		nisSeries(123457, t, nis);
+		std::vector<std::size_t> kept;
+		downsample::minMax(nis.data(), nis.size(), 640, kept);
+		ASSERT_TRUE(increasing(kept));
+		EXPECT_LE(kept.size(), 642u);
+
+		for (std::size_t b=0; b<320; ++b)
+		{
+			std::size_t begin = b * nis.size() / 320;
+			std::size_t end = (b+1) * nis.size() / 320;
+			auto range = std::minmax_element(nis.begin() + begin, nis.begin() + end);
+			EXPECT_NE(std::find(kept.begin(), kept.end(), range.first - nis.begin()), kept.end());
+			EXPECT_NE(std::find(kept.begin(), kept.end(), range.second - nis.begin()), kept.end());
+		}
+	}
+
+	TEST(downsample, gaps)
+	{
+		std::vector<double> t, nis;
+		nisSeries(50000, t, nis);
+		for (std::size_t i=20000; i<20100; ++i)
+		{
+			nis[i] = NAN;
+		}
+		nis[30000] = std::numeric_limits<double>::infinity();
+
+		for (auto method : {decimation_method::lttb, decimation_method::min_max})
+		{
+			std::vector<std::size_t> kept;
+			downsample::select(method, t, nis, 500, kept, 5.9915);
+			ASSERT_TRUE(increasing(kept));
+			bool nan_gap = false, inf_gap = false;
+			for (std::size_t index : kept)
+			{
+				nan_gap = nan_gap or std::isnan(nis[index]);
+				inf_gap = inf_gap or index == 30000u;
+			}
+			EXPECT_TRUE(nan_gap);
+			EXPECT_TRUE(inf_gap);
+		}
+	}
+
+#ifndef POINTONENAV_NO_PLOT
+	TEST(downsample, matPlot_long)
+	{
+		std::vector<double> t, nis;
+		nisSeries(2000000, t, nis);
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+		clockModel->setPlotDecimation(decimation_method::lttb, 2000);
+
+		clockModel->matPlot(nis, t, "test_downsample", "Receiver time, s", " ", 0.0);
+
+		std::ifstream png("../filter_output/test_downsample.png");
+		EXPECT_TRUE(png.good());
+		remove("../filter_output/test_downsample.png");
+		remove("../filter_output/test_downsample.svg");
+	}
+#endif
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,218 @@
+/**
+ * @file test_filterStats.cpp
+ * @brief streaming filter consistency statistics fed one NIS value per epoch
+ * @function filterStats::chiSquareCdf, filterStats::chiSquareInv, filterStats::add, filterStats::summary, p2Quantile::value
+ * @note the chi-square quantiles are checked against tabulated values, the running statistics against ones computed directly
+ *       from the whole series; the long run checks that the memory stays bounded by the window
+ */
+
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "../src/filterStats.h"
+
+namespace
+{
+	TEST(filterStats, chiSquareInv)
+	{
+		/// Tabulated quantiles, including the 5.9915 the NIS plot used to hard-code
+		EXPECT_NEAR(filterStats::chiSquareInv(0.95, 2), 5.991464547, 1.0e-8);
+		EXPECT_NEAR(filterStats::chiSquareInv(0.95, 1), 3.841458821, 1.0e-8);
+		EXPECT_NEAR(filterStats::chiSquareInv(0.025, 10), 3.246972780, 1.0e-8);
+		EXPECT_NEAR(filterStats::chiSquareInv(0.975, 10), 20.48317735, 1.0e-7);
+		EXPECT_NEAR(filterStats::chiSquareInv(0.05, 2), 0.1025865888, 1.0e-9);
+		EXPECT_NEAR(filterStats::chiSquareInv(0.999, 3), 16.26623620, 1.0e-7);
+		EXPECT_NEAR(filterStats::chiSquareInv(0.5, 100), 99.33412923, 1.0e-6);
+
+		/// The CDF of the inverse is the probability back
+		for (unsigned dof : {1u, 2u, 3u, 6u, 30u})
+		{
+			for (double p : {1.0e-6, 0.01, 0.3, 0.5, 0.9, 0.999999})
+			{
+				EXPECT_NEAR(filterStats::chiSquareCdf(filterStats::chiSquareInv(p, dof), dof), p, 1.0e-12);
+			}
+		}
+
+		EXPECT_EQ(filterStats::chiSquareInv(0.0, 2), 0.0);
+		EXPECT_TRUE(std::isnan(filterStats::chiSquareInv(1.0, 2)));
+		EXPECT_TRUE(std::isnan(filterStats::chiSquareInv(-0.1, 2)));
+		EXPECT_TRUE(std::isnan(filterStats::chiSquareInv(0.5, 0)));
+	}
+
+	TEST(filterStats, bounds)
+	{
+		filterStats stats(2, 0.1);
+		EXPECT_NEAR(stats.lowerBound(), 0.1025865888, 1.0e-9);
+		EXPECT_NEAR(stats.upperBound(), 5.991464547, 1.0e-8);
+		EXPECT_EQ(stats.count(), 0u);
+		EXPECT_TRUE(std::isnan(stats.mean()));
+		EXPECT_TRUE(std::isnan(stats.windowMean()));
+		EXPECT_EQ(stats.fractionOutside(), 0.0);
+	}
+
+	/// Chi-square distributed values: the statistics match the ones of the whole series and of its last window at every epoch
+	TEST(filterStats, running)
+	{
+		const int epochs = 5000;
+		const std::size_t window = 100;
+		std::mt19937_64 generator(7);
+		std::chi_squared_distribution<double> chi_square(2.0);
+		std::vector<double> values(epochs);
+		for (double& v : values)
+		{
+			v = chi_square(generator);
+		}
+
+		filterStats stats(2, 0.05, window);
+		for (int k=0; k<epochs; ++k)
+		{
+			stats.add(values[k]);
+			if (k % 997 != 0 and k != epochs - 1)
+			{
+				continue;
+			}
+
+			/// Queried mid-run
+			std::size_t first = k + 1 > static_cast<int>(window) ? k + 1 - window : 0;
+			double sum = 0.0, window_sum = 0.0;
+			std::size_t outside = 0, window_outside = 0;
+			for (int j=0; j<=k; ++j)
+			{
+				bool out = values[j] < stats.lowerBound() or values[j] > stats.upperBound();
+				sum += values[j];
+				outside += out;
+				if (static_cast<std::size_t>(j) >= first)
+				{
+					window_sum += values[j];
+					window_outside += out;
+				}
+			}
+			double mean = sum / (k + 1);
+			double squares = 0.0;
+			for (int j=0; j<=k; ++j)
+			{
+				squares += (values[j] - mean) * (values[j] - mean);
+			}
+			EXPECT_EQ(stats.count(), static_cast<std::uint64_t>(k + 1));
+			EXPECT_NEAR(stats.mean(), mean, 1.0e-12 * mean);
+			if (k > 0)
+			{
+				EXPECT_NEAR(stats.variance(), squares / k, 1.0e-10 * squares / k);
+			}
+			EXPECT_NEAR(stats.windowMean(), window_sum / (k + 1 - first), 1.0e-12);
+			EXPECT_DOUBLE_EQ(stats.fractionOutside(), static_cast<double>(outside) / (k + 1));
+			EXPECT_DOUBLE_EQ(stats.windowFractionOutside(), static_cast<double>(window_outside) / (k + 1 - first));
+		}
+
+		/// A consistent filter: about alpha outside, mean about the degrees of freedom
+		EXPECT_NEAR(stats.fractionOutside(), 0.05, 0.015);
+		EXPECT_NEAR(stats.mean(), 2.0, 0.15);
+
+		/// P-square estimates against the sorted series and the exact quantiles of chi-square with 2 DOF
+		nis_summary s = stats.summary();
+		std::sort(values.begin(), values.end());
+		EXPECT_NEAR(s.median, values[epochs / 2], 0.05);
+		EXPECT_NEAR(s.quantile_95, values[static_cast<int>(0.95 * epochs)], 0.2);
+		EXPECT_NEAR(s.median, filterStats::chiSquareInv(0.5, 2), 0.1);
+		EXPECT_NEAR(s.quantile_95, filterStats::chiSquareInv(0.95, 2), 0.4);
+	}
+
+	TEST(filterStats, dropouts)
+	{
+		filterStats stats(2, 0.05, 4);
+		stats.add(1.0);
+		stats.add(NAN);
+		stats.add(3.0);
+		stats.add(INFINITY);
+		stats.add(100.0);
+
+		nis_summary s = stats.summary();
+		EXPECT_EQ(s.count, 3u);
+		EXPECT_EQ(s.dropouts, 2u);
+		EXPECT_DOUBLE_EQ(s.mean, 104.0 / 3.0);
+		EXPECT_DOUBLE_EQ(s.fraction_above, 1.0 / 3.0);
+		EXPECT_EQ(s.fraction_below, 0.0);
+		EXPECT_DOUBLE_EQ(s.median, 3.0);
+
+		stats.reset();
+		EXPECT_EQ(stats.count(), 0u);
+		EXPECT_TRUE(std::isnan(stats.summary().median));
+		EXPECT_NEAR(stats.upperBound(), filterStats::chiSquareInv(0.975, 2), 1.0e-12);
+	}
+
+	TEST(filterStats, p2Quantile)
+	{
+		/// Exact while fewer than five values are seen
+		p2Quantile median(0.5);
+		median.add(4.0);
+		median.add(1.0);
+		median.add(3.0);
+		EXPECT_DOUBLE_EQ(median.value(), 3.0);
+		median.add(2.0);
+		EXPECT_DOUBLE_EQ(median.value(), 2.5);
+
+		/// A uniform ramp, shuffled
+		std::vector<double> values(100001);
+		for (std::size_t i=0; i<values.size(); ++i)
+		{
+			values[i] = static_cast<double>(i);
+		}
+		std::shuffle(values.begin(), values.end(), std::mt19937_64(3));
+		p2Quantile q10(0.1), q50(0.5), q99(0.99);
+		for (double v : values)
+		{
+			q10.add(v);
+			q50.add(v);
+			q99.add(v);
+		}
+		EXPECT_NEAR(q10.value(), 10000.0, 200.0);
+		EXPECT_NEAR(q50.value(), 50000.0, 200.0);
+		EXPECT_NEAR(q99.value(), 99000.0, 200.0);
+	}
+
+	/// Memory bounded by the window: after 10^7 epochs only the last window values are held, and the window statistics are
+	/// those of these values; the cost per epoch is measured by BM_filterStats_add in bench/bench_simpleEKF.cpp
+	TEST(filterStats, long_run)
+	{
+		std::mt19937_64 generator(11);
+		std::chi_squared_distribution<double> chi_square(2.0);
+		std::vector<double> values(1 << 16);
+		for (double& v : values)
+		{
+			v = chi_square(generator);
+		}
+
+		const std::size_t epochs = 10000000;
+		for (std::size_t window : {std::size_t(100), std::size_t(100000)})
+		{
+			filterStats stats(2, 0.05, window);
+			for (std::size_t k=0; k<epochs; ++k)
+			{
+				stats.add(values[k & (values.size() - 1)]);
+			}
+			EXPECT_EQ(stats.count(), epochs);
+			EXPECT_EQ(stats.windowCount(), window);
+
+			double window_sum = 0.0;
+			std::size_t window_outside = 0;
+			for (std::size_t k=epochs-window; k<epochs; ++k)
+			{
+				const double v = values[k & (values.size() - 1)];
+				window_sum += v;
+				window_outside += (v < stats.lowerBound() or v > stats.upperBound()) ? 1 : 0;
+			}
+			EXPECT_NEAR(stats.windowMean(), window_sum / window, 1.0e-9);
+			EXPECT_DOUBLE_EQ(stats.windowFractionOutside(), static_cast<double>(window_outside) / window);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
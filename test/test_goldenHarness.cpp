@@ -0,0 +1,190 @@
+/**
+ * @file test_goldenHarness.cpp
+ * @brief golden-output harness comparing filter engines with the reference simpleEKF epoch by epoch
+ * @function goldenHarness::ulpDistance(double, double), goldenHarness::compare(filter_history, filter_history, golden_tolerance, unsigned),
+ *           goldenHarness::run(filter_input, float, filter_engine, golden_tolerance, unsigned), goldenHarness::referenceEngine(float),
+ *           goldenHarness::fixedSizeEngine(float)
+ * @note test cases check the ULP distance at its edges, that a perturbed history diverges at the perturbed value with the same
+ *       report for any number of threads, and that the fixed-size engine matches the reference on a long simulated run and for
+ *       time steps that are not integers
+ */
+
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <gtest/gtest.h>
+
+#include "../src/goldenHarness.h"
+#include "../src/clockSimulator.h"
+
+namespace
+{
+	/// The clock model of filter_input, simulated with dropouts and outliers
+	filter_input simulatedInputs(const std::uint64_t epochs)
+	{
+		simulation_config config;
+		config.epochs = epochs;
+		config.seed = 11;
+		config.dropout_rate = 0.01;
+		config.outlier_rate = 0.001;
+		config.initial_state << -32186.470260709215, 26.07840844955248;
+		config.initial_covariance << 49.0, 0.0, 0.0, 0.04;
+		config.process_noise_covariance << 0.020814695877451838, 0.017740716135125494, 0.017740716135125494, 0.035481432270250989;
+		config.measurement_noise_covariance << 49.0, 0.0, 0.0, 0.04;
+
+		filter_input f_in;
+		Eigen::MatrixXd truth;
+		clockSimulator(config).simulate(0, 0, epochs, truth, f_in.measurement_history);
+		f_in.initial_state_estimate = config.initial_state;
+		f_in.initial_state_estimate_covariance = config.initial_covariance;
+		f_in.process_noise_covariance = config.process_noise_covariance;
+		f_in.measurement_noise_covariance = config.measurement_noise_covariance;
+		return f_in;
+	}
+
+	TEST(goldenHarness, ulpDistance)
+	{
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		const double inf = std::numeric_limits<double>::infinity();
+		EXPECT_EQ(goldenHarness::ulpDistance(1.0, 1.0), 0u);
+		EXPECT_EQ(goldenHarness::ulpDistance(0.0, -0.0), 0u);
+		EXPECT_EQ(goldenHarness::ulpDistance(1.0, std::nextafter(1.0, 2.0)), 1u);
+		EXPECT_EQ(goldenHarness::ulpDistance(std::nextafter(1.0, 2.0), 1.0), 1u);
+		EXPECT_EQ(goldenHarness::ulpDistance(-1.0, std::nextafter(-1.0, -2.0)), 1u);
+
+		/// Across zero: the smallest denormals on each side are 2 apart
+		const double tiny = std::numeric_limits<double>::denorm_min();
+		EXPECT_EQ(goldenHarness::ulpDistance(-tiny, tiny), 2u);
+		EXPECT_EQ(goldenHarness::ulpDistance(nan, nan), 0u);
+		EXPECT_EQ(goldenHarness::ulpDistance(nan, 1.0), std::numeric_limits<std::uint64_t>::max());
+		EXPECT_EQ(goldenHarness::ulpDistance(inf, inf), 0u);
+		EXPECT_GT(goldenHarness::ulpDistance(-inf, inf), goldenHarness::ulpDistance(0.0, inf));
+	}
+
+	/// The reference engine against itself: bit for bit, NIS nan at the dropouts on both sides
+	TEST(goldenHarness, reference_identical)
+	{
+		const filter_input f_in = simulatedInputs(20000);
+		golden_tolerance exact;
+		exact.max_ulps = 0;
+		exact.max_relative = 0.0;
+		golden_report report = goldenHarness::run(f_in, 1.0, goldenHarness::referenceEngine(), exact);
+		EXPECT_FALSE(report.diverged) << goldenHarness::describe(report);
+		EXPECT_EQ(report.epochs, 20000u);
+		EXPECT_EQ(report.worst_ulps.ulps, 0u);
+		EXPECT_EQ(report.mismatches, 0u);
+	}
+
+	/// Perturbations planted in different chunks: the earliest is reported, the largest is the worst, whatever the threads
+	TEST(goldenHarness, first_divergence_and_worst)
+	{
+		const Eigen::Index n = 5 * goldenHarness::chunk_epochs + 17;
+		filter_history reference;
+		reference.state = Eigen::MatrixXd::Random(2, n);
+		reference.covariance = Eigen::MatrixXd::Random(4, n);
+		reference.nis = Eigen::MatrixXd::Random(1, n).cwiseAbs();
+
+		filter_history candidate = reference;
+		candidate.covariance(3, 4 * goldenHarness::chunk_epochs + 3) *= 1.0 + 1e-6;
+		candidate.state(1, 2 * goldenHarness::chunk_epochs + 5) *= 1.0 + 1e-9;
+		candidate.state(0, 100) = std::nextafter(candidate.state(0, 100), 0.0);
+
+		golden_tolerance tolerance;
+		for (unsigned threads : {1u, 2u, 8u})
+		{
+			golden_report report = goldenHarness::compare(reference, candidate, tolerance, threads);
+			EXPECT_TRUE(report.diverged);
+			EXPECT_EQ(report.mismatches, 2u);
+			EXPECT_EQ(report.first_divergence.epoch, 2 * goldenHarness::chunk_epochs + 5);
+			EXPECT_EQ(goldenHarness::quantityName(report.first_divergence.quantity), "state[1]");
+			EXPECT_EQ(report.worst_relative.epoch, 4 * goldenHarness::chunk_epochs + 3);
+			EXPECT_EQ(goldenHarness::quantityName(report.worst_relative.quantity), "covariance[3]");
+			EXPECT_NEAR(report.worst_relative.relative, 1e-6, 1e-9);
+		}
+
+		/// A single ULP is within the tolerance, not with 0 ULPs and no relative tolerance
+		golden_tolerance exact;
+		exact.max_ulps = 0;
+		exact.max_relative = 0.0;
+		golden_report report = goldenHarness::compare(reference, candidate, exact, 4);
+		EXPECT_EQ(report.first_divergence.epoch, 100u);
+		EXPECT_EQ(report.first_divergence.ulps, 1u);
+		EXPECT_EQ(report.mismatches, 3u);
+	}
+
+	/// A missing NIS (nan where the reference has a number, even 0) and a shorter history both diverge
+	TEST(goldenHarness, nan_and_length)
+	{
+		filter_history reference;
+		goldenHarness::referenceEngine()(simulatedInputs(1000), reference);
+		filter_history candidate = reference;
+		for (int k=0; k<1000; ++k)
+		{
+			if (std::isfinite(candidate.nis(0, k)) and k > 500)
+			{
+				candidate.nis(0, k) = std::nan("");
+				break;
+			}
+		}
+		golden_report report = goldenHarness::compare(reference, candidate, golden_tolerance());
+		EXPECT_TRUE(report.diverged);
+		EXPECT_EQ(goldenHarness::quantityName(report.first_divergence.quantity), "nis");
+		EXPECT_GT(report.first_divergence.epoch, 500u);
+		EXPECT_TRUE(std::isinf(report.worst_relative.relative));
+
+		/// A nan against a reference of 0 is within none of the tolerances, the abs_floor included
+		candidate = reference;
+		reference.nis(0, 10) = 0.0;
+		candidate.nis(0, 10) = std::nan("");
+		report = goldenHarness::compare(reference, candidate, golden_tolerance());
+		EXPECT_TRUE(report.diverged);
+		EXPECT_EQ(report.mismatches, 1u);
+		EXPECT_EQ(report.first_divergence.epoch, 10u);
+		EXPECT_EQ(goldenHarness::quantityName(report.first_divergence.quantity), "nis");
+		reference.nis(0, 10) = std::nan("");
+		report = goldenHarness::compare(reference, candidate, golden_tolerance());
+		EXPECT_FALSE(report.diverged);
+
+		candidate = reference;
+		candidate.state.conservativeResize(2, 900);
+		candidate.covariance.conservativeResize(4, 900);
+		candidate.nis.conservativeResize(1, 900);
+		report = goldenHarness::compare(reference, candidate, golden_tolerance());
+		EXPECT_TRUE(report.diverged);
+		EXPECT_EQ(report.epochs, 900u);
+		EXPECT_EQ(report.first_divergence.epoch, 900u);
+	}
+
+	/// The fixed-size engine on a long run: within the relative tolerance everywhere, though not bit for bit
+	TEST(goldenHarness, fixed_size_engine)
+	{
+		const filter_input f_in = simulatedInputs(200000);
+		golden_report report = goldenHarness::run(f_in, 1.0, goldenHarness::fixedSizeEngine(), golden_tolerance());
+		std::cout << goldenHarness::describe(report);
+		EXPECT_FALSE(report.diverged);
+		EXPECT_EQ(report.epochs, 200000u);
+	}
+
+	/// A time step with no exact float: both engines round it the same way, the reference of run is built with it as well
+	TEST(goldenHarness, fixed_size_engine_dt)
+	{
+		const filter_input f_in = simulatedInputs(20000);
+		for (float dt : {0.1f, 0.3f, 2.5f})
+		{
+			golden_report report = goldenHarness::run(f_in, dt, goldenHarness::fixedSizeEngine(dt), golden_tolerance());
+			EXPECT_FALSE(report.diverged) << "dt " << dt << std::endl << goldenHarness::describe(report);
+			EXPECT_EQ(report.mismatches, 0u);
+		}
+
+		/// An engine built with another time step than the reference diverges
+		golden_report report = goldenHarness::run(f_in, 1.0, goldenHarness::fixedSizeEngine(0.1f), golden_tolerance());
+		EXPECT_TRUE(report.diverged);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
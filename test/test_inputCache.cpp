@@ -0,0 +1,169 @@
+/**
+ * @file test_inputCache.cpp
+ * @brief parsed-input cache, binary sidecars used by getInputData instead of parsing the text input files again
+ * @function inputCache::load(std::string, mat, bool), inputCache::identify(std::string, cache_source),
+ *           inputCache::store(std::string, cache_source, mat), twoStateClockModel::setInputCache(bool)
+ * @note test cases check that the sidecar gives back exactly the parsed values, and that stale or foreign sidecars are rebuilt
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/inputCache.h"
+
+namespace
+{
+	const std::string input_name = "../filter_output/test_inputCache.txt";
+
+	void writeInput(const std::string text)
+	{
+		std::ofstream file(input_name);
+		file << text;
+	}
+
+	void removeInput()
+	{
+		remove(input_name.c_str());
+		remove(inputCache::sidecarName(input_name).c_str());
+	}
+
+	TEST(inputCache, getInputData_cached)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setInputCache(true);
+
+		mat parsed, cached;
+		clockModel->getInputData("measurement_history.txt", parsed);
+		ASSERT_EQ(parsed.cols(), 1000);
+
+		/// The first call left a sidecar behind, the second one uses it
+		std::string sidecar = inputCache::sidecarName("../filter_input/measurement_history.txt");
+		ASSERT_TRUE(inputCache::load("../filter_input/measurement_history.txt", cached, true));
+		EXPECT_TRUE(parsed == cached);
+
+		mat again;
+		clockModel->getInputData("measurement_history.txt", again);
+		EXPECT_TRUE(parsed == again);
+		remove(sidecar.c_str());
+	}
+
+	TEST(inputCache, load_without_sidecar)
+	{
+		removeInput();
+		writeInput("1.0 2.0\n3.0 4.0\n");
+		mat cached;
+		EXPECT_FALSE(inputCache::load(input_name, cached));
+		removeInput();
+		EXPECT_FALSE(inputCache::load(input_name, cached));
+	}
+
+	TEST(inputCache, load_stale)
+	{
+		writeInput("1.0 2.0\n3.0 4.0\n");
+		mat values(2,2);
+		values << 1.0, 2.0, 3.0, 4.0;
+		cache_source source;
+		ASSERT_TRUE(inputCache::identify(input_name, source));
+		ASSERT_TRUE(inputCache::store(input_name, source, values));
+
+		mat cached;
+		ASSERT_TRUE(inputCache::load(input_name, cached, true));
+		EXPECT_TRUE(values == cached);
+
+		/// Same size, new contents and modification time
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		writeInput("5.0 6.0\n7.0 8.0\n");
+		EXPECT_FALSE(inputCache::load(input_name, cached));
+
+		/// getInputData parses the text file again and rebuilds the sidecar
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setInputCache(true);
+		mat input_mat;
+		clockModel->getInputData(input_name, input_mat);
+		EXPECT_EQ(input_mat(1,1), 8.0);
+		ASSERT_TRUE(inputCache::load(input_name, cached, true));
+		EXPECT_TRUE(input_mat == cached);
+		removeInput();
+	}
+
+	/// The text file is replaced between the parse and the store: the values are of the old file, no sidecar is written
+	TEST(inputCache, store_changed)
+	{
+		removeInput();
+		writeInput("1.0 2.0\n3.0 4.0\n");
+		cache_source source;
+		ASSERT_TRUE(inputCache::identify(input_name, source));
+		mat values(2,2);
+		values << 1.0, 2.0, 3.0, 4.0;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		writeInput("5.0 6.0\n7.0 8.0\n");
+		EXPECT_FALSE(inputCache::store(input_name, source, values));
+		std::ifstream sidecar(inputCache::sidecarName(input_name));
+		EXPECT_FALSE(sidecar.good());
+		removeInput();
+	}
+
+	/// A header announcing more values than the sidecar holds is rejected, also when rows*cols*8 wraps around
+	TEST(inputCache, load_oversized)
+	{
+		writeInput("1.0 2.0\n3.0 4.0\n");
+		mat values(2,2);
+		values << 1.0, 2.0, 3.0, 4.0;
+		cache_source source;
+		ASSERT_TRUE(inputCache::identify(input_name, source));
+		ASSERT_TRUE(inputCache::store(input_name, source, values));
+
+		for (std::int64_t rows : {std::int64_t(3), std::int64_t(1) << 61})
+		{
+			cache_header header;
+			{
+				std::fstream sidecar(inputCache::sidecarName(input_name), std::ios::in | std::ios::out | std::ios::binary);
+				sidecar.read(reinterpret_cast<char*>(&header), sizeof(header));
+				header.rows = rows;
+				header.cols = rows == 3 ? 2 : 1;
+				sidecar.seekp(0);
+				sidecar.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			}
+			mat cached;
+			EXPECT_FALSE(inputCache::load(input_name, cached));
+		}
+		removeInput();
+	}
+
+	TEST(inputCache, load_corrupt)
+	{
+		writeInput("1.0 2.0\n3.0 4.0\n");
+		{
+			std::ofstream sidecar(inputCache::sidecarName(input_name));
+			sidecar << "not a sidecar";
+		}
+		mat cached;
+		EXPECT_FALSE(inputCache::load(input_name, cached));
+		removeInput();
+	}
+
+	TEST(inputCache, contentHash)
+	{
+		writeInput("1.0 2.0\n3.0 4.0\n");
+		std::uint64_t hash_1 = 0, hash_2 = 0;
+		ASSERT_TRUE(inputCache::contentHash(input_name, hash_1));
+		writeInput("1.0 2.0\n3.0 4.1\n");
+		ASSERT_TRUE(inputCache::contentHash(input_name, hash_2));
+		EXPECT_NE(hash_1, hash_2);
+		removeInput();
+		EXPECT_FALSE(inputCache::contentHash(input_name, hash_1));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+/**
+ * @file test_latencyHistogram.cpp
+ * @brief per-epoch latency histograms, log-linear buckets timed with the calibrated cycle counter
+ * @function latencyHistogram::record(uint64_t), latencyHistogram::quantile(double), latencyHistogram::merge(latencyHistogram),
+ *           cycleClock::now(), cycleClock::nanosecondsPerTick()
+ * @note test cases check the quantiles against known distributions within the bucket precision (1/128), and the calibration
+ *       against the steady clock
+ */
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include "../src/latencyHistogram.h"
+
+namespace
+{
+	TEST(latencyHistogram, empty)
+	{
+		latencyHistogram histogram;
+		EXPECT_EQ(histogram.count(), 0u);
+		EXPECT_EQ(histogram.max(), 0u);
+		EXPECT_EQ(histogram.quantile(0.5), 0.0);
+		EXPECT_EQ(histogram.summary().mean, 0.0);
+	}
+
+	TEST(latencyHistogram, exact_below_128)
+	{
+		latencyHistogram histogram;
+		for (std::uint64_t v=0; v<100; ++v)
+		{
+			histogram.record(v);
+		}
+		EXPECT_EQ(histogram.count(), 100u);
+		EXPECT_EQ(histogram.quantile(0.5), 49.0);
+		EXPECT_EQ(histogram.quantile(0.99), 98.0);
+		EXPECT_EQ(histogram.quantile(1.0), 99.0);
+		EXPECT_DOUBLE_EQ(histogram.summary().mean, 49.5);
+	}
+
+	/// 1 to 10^6 ns uniformly: every quantile within the bucket precision
+	TEST(latencyHistogram, quantiles_within_precision)
+	{
+		latencyHistogram histogram;
+		const std::uint64_t n = 1000000;
+		for (std::uint64_t v=1; v<=n; ++v)
+		{
+			histogram.record(v);
+		}
+		for (double q : {0.5, 0.9, 0.99, 0.999})
+		{
+			EXPECT_NEAR(histogram.quantile(q), q * n, q * n / 128.0) << q;
+		}
+		EXPECT_EQ(histogram.max(), n);
+		latency_summary s = histogram.summary();
+		EXPECT_EQ(s.count, n);
+		EXPECT_DOUBLE_EQ(s.max, static_cast<double>(n));
+		EXPECT_NEAR(s.p999, 999000.0, 999000.0 / 128.0);
+	}
+
+	/// A tail of slow steps shows in p99.9 and max, not in p50
+	TEST(latencyHistogram, tail)
+	{
+		latencyHistogram histogram;
+		for (int i=0; i<99800; ++i)
+		{
+			histogram.record(300);
+		}
+		for (int i=0; i<200; ++i)
+		{
+			histogram.record(50000);
+		}
+		histogram.record(3000000000ull);
+		latency_summary s = histogram.summary();
+		EXPECT_NEAR(s.p50, 300.0, 3.0);
+		EXPECT_NEAR(s.p99, 300.0, 3.0);
+		EXPECT_NEAR(s.p999, 50000.0, 50000.0 / 128.0);
+		EXPECT_EQ(s.max, 3e9);
+
+		/// The largest values still land in a bucket
+		histogram.record(~0ull);
+		EXPECT_EQ(histogram.max(), ~0ull);
+	}
+
+	TEST(latencyHistogram, merge_and_reset)
+	{
+		latencyHistogram a, b;
+		for (std::uint64_t v=1; v<=1000; ++v)
+		{
+			(v % 2 ? a : b).record(v * 1000);
+		}
+		a.merge(b);
+		EXPECT_EQ(a.count(), 1000u);
+		EXPECT_EQ(a.max(), 1000000u);
+		EXPECT_NEAR(a.quantile(0.5), 500000.0, 500000.0 / 128.0);
+
+		a.reset();
+		EXPECT_EQ(a.count(), 0u);
+		EXPECT_EQ(a.quantile(0.5), 0.0);
+	}
+
+	TEST(cycleClock, calibration)
+	{
+		EXPECT_GT(cycleClock::nanosecondsPerTick(), 0.0);
+		const std::uint64_t c0 = cycleClock::now();
+		const auto t0 = std::chrono::steady_clock::now();
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		const std::uint64_t c1 = cycleClock::now();
+		const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+		EXPECT_NEAR(static_cast<double>(cycleClock::toNanoseconds(c1 - c0)), ns, 0.05 * ns);
+
+		latencyHistogram histogram;
+		histogram.recordTicks(c0, c1);
+		histogram.recordTicks(c1, c0);
+		EXPECT_EQ(histogram.count(), 2u);
+		EXPECT_EQ(histogram.quantile(0.0), 0.0);
+	}
+
+	TEST(latencyHistogram, format)
+	{
+		EXPECT_EQ(latencyHistogram::format(312.0), "312 ns");
+		EXPECT_EQ(latencyHistogram::format(1234.0), "1.23 us");
+		EXPECT_EQ(latencyHistogram::format(45.6e6), "45.6 ms");
+		EXPECT_EQ(latencyHistogram::format(2e9), "2 s");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,82 @@
+/**
+ * @file test_matPlot.cpp
+ * @brief function to plot the filter output against custom data
+ * @function twoStateClockModel::matPlot(std::vector<double>, std::vector<double>, std::string, std::string, std::string, float)
+ * @note test cases run in the headless mode, so the plots are saved as PNG and SVG without opening a window; matPlot_lazy has to
+ *       run first, before any figure has started the interpreter
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/downsample.h"
+#include "../src/plotRenderer.h"
+
+namespace
+{
+	bool fileExists(const std::string file_name)
+	{
+		std::ifstream file_in(file_name);
+		return file_in.good();
+	}
+
+	/// Setting up the plots does not start the Python interpreter, the first figure drawn does
+	TEST(twoStateClockModel, matPlot_lazy)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+		clockModel->setPlotDecimation(decimation_method::lttb, 1000);
+
+		/// Vectors of different lengths are rejected before anything is drawn
+		clockModel->matPlot(std::vector<double>(10, 1.0), std::vector<double>(5, 1.0), "test_matPlot_lazy", " ", " ", 0.0);
+		EXPECT_FALSE(plotRenderer::started());
+
+		clockModel->matPlot(std::vector<double>(10, 1.0), std::vector<double>(10, 1.0), "test_matPlot_lazy", " ", " ", 0.0);
+#ifndef POINTONENAV_NATIVE_PLOT
+		EXPECT_TRUE(plotRenderer::started());
+#endif
+		remove("../filter_output/test_matPlot_lazy.png");
+		remove("../filter_output/test_matPlot_lazy.svg");
+	}
+
+	TEST(twoStateClockModel, matPlot_1)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		std::vector<double> x(100), y(100);
+		for (int i=0; i<100; ++i)
+		{
+			x[i] = 0.5 * i;
+			y[i] = i;
+		}
+		clockModel->matPlot(x, y, "test_matPlot", "Receiver time, s", "Clock bias estimate, m", 0.0);
+
+		EXPECT_TRUE(fileExists("../filter_output/test_matPlot.png"));
+		EXPECT_TRUE(fileExists("../filter_output/test_matPlot.svg"));
+		remove("../filter_output/test_matPlot.png");
+		remove("../filter_output/test_matPlot.svg");
+	}
+
+	TEST(twoStateClockModel, matPlot_2)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		/// Vectors of different lengths are not plotted
+		std::vector<double> x(100, 1.0), y(50, 1.0);
+		clockModel->matPlot(x, y, "test_matPlot_2", " ", " ", 0.0);
+
+		EXPECT_FALSE(fileExists("../filter_output/test_matPlot_2.png"));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
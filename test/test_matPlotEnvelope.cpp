@@ -0,0 +1,122 @@
+/**
+ * @file test_matPlotEnvelope.cpp
+ * @brief function to plot a row of the filter output history with its +-k sigma confidence envelope
+ * @function twoStateClockModel::matPlot(row_view, row_view, double, double, double, std::string, std::string, std::string)
+ * @note test cases run in the headless mode; the variances are read in place from a std::vector of 2x2 matrices like
+ *       xcov_hist in main.cpp, and the long run checks that the envelope of a 10^6 epoch history is decimated with the line
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/downsample.h"
+
+namespace
+{
+	typedef Eigen::Map<const Eigen::RowVectorXd, 0, Eigen::InnerStride<4> > variance_row;
+
+	std::string readFile(const std::string file_name)
+	{
+		std::ifstream file_in(file_name, std::ifstream::binary);
+		return std::string((std::istreambuf_iterator<char>(file_in)), std::istreambuf_iterator<char>());
+	}
+
+	std::size_t countOf(const std::string& text, const std::string& pattern)
+	{
+		std::size_t count = 0;
+		for (std::size_t pos=text.find(pattern); pos!=std::string::npos; pos=text.find(pattern, pos+1))
+		{
+			count++;
+		}
+		return count;
+	}
+
+	/// Histories shaped like xhat_hist and xcov_hist, the variances converge like those of the filter
+	void histories(int epochs, mat& xhat_hist, std::vector<Eigen::Matrix<double,2,2> >& xcov_hist)
+	{
+		xhat_hist.resize(2, epochs);
+		xcov_hist.resize(epochs);
+		for (int k=0; k<epochs; ++k)
+		{
+			xhat_hist(0, k) = 10.0 * std::sin(1.0e-3 * k);
+			xhat_hist(1, k) = 0.01 * std::cos(1.0e-3 * k);
+			xcov_hist[k] << 4.0 / (1.0 + k), 0.0, 0.0, 1.0e-4 / (1.0 + k);
+		}
+	}
+
+	TEST(twoStateClockModel, matPlot_envelope)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		mat xhat_hist;
+		std::vector<Eigen::Matrix<double,2,2> > xcov_hist;
+		histories(500, xhat_hist, xcov_hist);
+		variance_row bias_variance(xcov_hist.front().data(), 500);
+		clockModel->matPlot(xhat_hist.row(0), bias_variance, 2.0, 0.0, 1.0, "test_matPlotEnvelope", "Receiver time, s", "Clock bias estimate, m");
+
+		std::string svg = readFile("../filter_output/test_matPlotEnvelope.svg");
+		EXPECT_FALSE(svg.empty());
+#ifdef POINTONENAV_NATIVE_PLOT
+		/// The envelope is one polygon under the line, 2 points per sample
+		EXPECT_EQ(countOf(svg, "<polygon"), 1u);
+		std::size_t begin = svg.find("points=\"", svg.find("<polygon"));
+		std::size_t end = svg.find("\"", begin + 8);
+		EXPECT_EQ(countOf(svg.substr(begin, end - begin), ","), 1000u);
+		EXPECT_LT(svg.find("<polygon"), svg.find("<polyline"));
+#endif
+		remove("../filter_output/test_matPlotEnvelope.png");
+		remove("../filter_output/test_matPlotEnvelope.svg");
+	}
+
+	TEST(twoStateClockModel, matPlot_envelope_invalid)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		mat xhat_hist;
+		std::vector<Eigen::Matrix<double,2,2> > xcov_hist;
+		histories(100, xhat_hist, xcov_hist);
+		variance_row short_variance(xcov_hist.front().data(), 50);
+		clockModel->matPlot(xhat_hist.row(0), short_variance, 2.0, 0.0, 1.0, "test_matPlotEnvelope_2", " ", " ");
+
+		std::ifstream png("../filter_output/test_matPlotEnvelope_2.png");
+		EXPECT_FALSE(png.good());
+	}
+
+	/// The envelope follows the decimation of the series: a 10^6 epoch history is drawn from the decimated points only, the cost
+	/// against the line alone is measured by BM_matPlot_envelope in bench/bench_matPlot.cpp
+	TEST(twoStateClockModel, matPlot_envelope_long)
+	{
+		const int epochs = 1000000;
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+		clockModel->setPlotDecimation(decimation_method::lttb, 2000);
+
+		mat xhat_hist;
+		std::vector<Eigen::Matrix<double,2,2> > xcov_hist;
+		histories(epochs, xhat_hist, xcov_hist);
+		variance_row rate_variance(xcov_hist.front().data() + 3, epochs);
+		clockModel->matPlot(xhat_hist.row(1), rate_variance, 3.0, 0.0, 1.0, "test_matPlotEnvelope_3", " ", " ");
+
+		std::string svg = readFile("../filter_output/test_matPlotEnvelope_3.svg");
+		EXPECT_FALSE(svg.empty());
+#ifdef POINTONENAV_NATIVE_PLOT
+		std::size_t begin = svg.find("points=\"", svg.find("<polygon"));
+		std::size_t end = svg.find("\"", begin + 8);
+		EXPECT_LE(countOf(svg.substr(begin, end - begin), ","), 2u * 2100u);
+#endif
+		remove("../filter_output/test_matPlotEnvelope_3.png");
+		remove("../filter_output/test_matPlotEnvelope_3.svg");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,100 @@
+/**
+ * @file test_matPlotRow.cpp
+ * @brief function to plot a row of the filter output history in place, without copying it into vectors
+ * @function twoStateClockModel::matPlot(row_view, double, double, std::string, std::string, std::string, float)
+ * @note test cases run in the headless mode; with matplotlib the handoff test draws a large history in place through strided
+ *       arrays
+ */
+
+#include <iostream>
+#include <fstream>
+#include <numeric>
+#include <cstdio>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/plotRenderer.h"
+
+namespace
+{
+	std::string readFile(const std::string file_name)
+	{
+		std::ifstream file_in(file_name, std::ifstream::binary);
+		return std::string((std::istreambuf_iterator<char>(file_in)), std::istreambuf_iterator<char>());
+	}
+
+	/// History shaped like xhat_hist: two states, one column per epoch
+	mat history(int epochs)
+	{
+		mat xhat_hist(2, epochs);
+		for (int k=0; k<epochs; ++k)
+		{
+			xhat_hist(0, k) = 1.0e3 * std::sin(1.0e-3 * k);
+			xhat_hist(1, k) = 0.1 * std::cos(1.0e-3 * k);
+		}
+		return xhat_hist;
+	}
+
+	TEST(twoStateClockModel, matPlot_row)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		mat xhat_hist = history(500);
+		clockModel->matPlot(xhat_hist.row(1), 0.0, 1.0, "test_matPlotRow", "Receiver time, s", "Clock rate estimate, m/s", 0.0);
+
+		std::ifstream png("../filter_output/test_matPlotRow.png");
+		EXPECT_TRUE(png.good());
+		remove("../filter_output/test_matPlotRow.png");
+		remove("../filter_output/test_matPlotRow.svg");
+	}
+
+#ifdef POINTONENAV_NATIVE_PLOT
+	/// The row of the matrix gives the same figure as the vectors read back from the output file
+	TEST(twoStateClockModel, matPlot_row_vector)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		mat nis_hist = history(3000).cwiseAbs() * 0.005;
+		std::vector<std::vector<double> > values;
+		ASSERT_TRUE(clockModel->getVectorValues(nis_hist, "test_matPlotRow.txt", values));
+		std::vector<double> y(values[0].size());
+		std::iota(y.begin(), y.end(), 0);
+
+		clockModel->matPlot(nis_hist.row(0), 0.0, 1.0, "test_matPlotRow_1", " ", " ", 5.9915);
+		std::string from_row = readFile("../filter_output/NIS, 0 above the 0.05 threshold.svg");
+		clockModel->matPlot(values[0], y, "test_matPlotRow_2", " ", " ", 5.9915);
+		std::string from_vector = readFile("../filter_output/NIS, 0 above the 0.05 threshold.svg");
+		EXPECT_FALSE(from_row.empty());
+		EXPECT_EQ(from_row, from_vector);
+
+		remove("../filter_output/test_matPlotRow.txt");
+		remove("../filter_output/NIS, 0 above the 0.05 threshold.png");
+		remove("../filter_output/NIS, 0 above the 0.05 threshold.svg");
+	}
+#else
+	/// A 10^6 epoch history is handed to matplotlib as the strided row of the matrix, not copied; the cost against the file
+	/// round trip main.cpp used to do is measured by BM_plot_handoff in bench/bench_matPlot.cpp
+	TEST(plotRenderer, plot_handoff)
+	{
+		const int epochs = 1000000;
+		mat xhat_hist = history(epochs);
+		plot_figure figure;
+		figure.lines.push_back({NULL, 0.0, 1.0, xhat_hist.data(), xhat_hist.rows(), static_cast<std::size_t>(epochs), ""});
+		EXPECT_TRUE(plotRenderer::draw(figure, "../filter_output/test_matPlotRow", true));
+
+		std::ifstream png("../filter_output/test_matPlotRow.png");
+		EXPECT_TRUE(png.good());
+		remove("../filter_output/test_matPlotRow.png");
+		remove("../filter_output/test_matPlotRow.svg");
+	}
+#endif
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,209 @@
+/**
+ * @file test_measurementSource.cpp
+ * @brief live measurement source used to run the filter one epoch at a time
+ * @function measurementSource::open(std::string), measurementSource::next(Eigen::Vector2d)
+ * @note test cases send epochs through a named pipe, a Unix-domain socket and a UDP socket, including blank and malformed lines,
+ *       a line longer than the receive buffer and a last line without a newline
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/measurementSource.h"
+
+namespace
+{
+	/// Writes the given text to a connected stream socket, retrying until the source listens
+	void unixClient(const std::string path, const std::string text)
+	{
+		struct sockaddr_un addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+		for (int attempt=0; attempt<200; ++attempt)
+		{
+			int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+			if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0)
+			{
+				/// Split the text so lines arrive across several reads
+				std::size_t half = text.size() / 2;
+				ASSERT_EQ(::write(fd, text.data(), half), half);
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+				ASSERT_EQ(::write(fd, text.data() + half, text.size() - half), text.size() - half);
+				::close(fd);
+				return;
+			}
+			::close(fd);
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+
+	TEST(measurementSource, next_fifo)
+	{
+		std::string path = "../filter_output/test_measurementSource.fifo";
+		std::thread writer([path]()
+		{
+			/// Wait for the source to create the pipe
+			int fd = -1;
+			for (int attempt=0; attempt<200 and fd < 0; ++attempt)
+			{
+				fd = ::open(path.c_str(), O_WRONLY | O_NONBLOCK);
+				if (fd < 0)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+			}
+			std::string text = "-3.2168832582847695e+04   2.5907051059734886e+01\n\n1.5,2.5\r\n";
+			::write(fd, text.data(), text.size());
+			::close(fd);
+		});
+
+		measurementSource source;
+		ASSERT_TRUE(source.open("fifo:" + path));
+		Eigen::Vector2d y;
+		ASSERT_TRUE(source.next(y));
+		EXPECT_EQ(y(0), -3.2168832582847695e+04);
+		EXPECT_EQ(y(1), 2.5907051059734886e+01);
+		ASSERT_TRUE(source.next(y));
+		EXPECT_EQ(y(0), 1.5);
+		EXPECT_EQ(y(1), 2.5);
+		EXPECT_FALSE(source.next(y));
+		EXPECT_EQ(source.malformed(), 0);
+		writer.join();
+		source.close();
+
+		/// The pipe created by the source is removed again
+		struct stat st;
+		EXPECT_NE(::stat(path.c_str(), &st), 0);
+	}
+
+	/// A line longer than the receive buffer is skipped whole, and a last line without a newline is still read at the end
+	TEST(measurementSource, next_long_and_last_line)
+	{
+		std::string path = "../filter_output/test_measurementSource_last.fifo";
+		std::thread writer([path]()
+		{
+			int fd = -1;
+			for (int attempt=0; attempt<200 and fd < 0; ++attempt)
+			{
+				fd = ::open(path.c_str(), O_WRONLY | O_NONBLOCK);
+				if (fd < 0)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+			}
+			::fcntl(fd, F_SETFL, 0);
+			std::string text = "1 2\n" + std::string(100000, '1') + " 3 4\n7 8\n9 10";
+			for (std::size_t written=0; written<text.size(); )
+			{
+				ssize_t n = ::write(fd, text.data() + written, text.size() - written);
+				if (n <= 0)
+				{
+					break;
+				}
+				written += n;
+			}
+			::close(fd);
+		});
+
+		measurementSource source;
+		ASSERT_TRUE(source.open("fifo:" + path));
+		Eigen::Vector2d y;
+		ASSERT_TRUE(source.next(y));
+		EXPECT_EQ(y(0), 1.0);
+		ASSERT_TRUE(source.next(y));
+		EXPECT_EQ(y(0), 7.0);
+		EXPECT_EQ(y(1), 8.0);
+		ASSERT_TRUE(source.next(y));
+		EXPECT_EQ(y(0), 9.0);
+		EXPECT_EQ(y(1), 10.0);
+		EXPECT_FALSE(source.next(y));
+		EXPECT_EQ(source.malformed(), 1);
+		writer.join();
+	}
+
+	TEST(measurementSource, next_unix)
+	{
+		std::string path = "../filter_output/test_measurementSource.sock";
+		std::stringstream text;
+		for (int k=0; k<1000; ++k)
+		{
+			text << k << " " << 0.5 * k << "\n";
+		}
+		text << "not a measurement\n1.0\n";
+		std::thread client(unixClient, path, text.str());
+
+		measurementSource source;
+		ASSERT_TRUE(source.open("unix:" + path));
+		Eigen::Vector2d y;
+		int k = 0;
+		while (source.next(y))
+		{
+			EXPECT_EQ(y(0), k);
+			EXPECT_EQ(y(1), 0.5 * k);
+			k++;
+		}
+		EXPECT_EQ(k, 1000);
+		EXPECT_EQ(source.malformed(), 2);
+		client.join();
+	}
+
+	TEST(measurementSource, next_udp)
+	{
+		measurementSource source;
+		ASSERT_TRUE(source.open("udp:47813"));
+
+		std::thread sender([]()
+		{
+			struct sockaddr_in addr;
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_port = htons(47813);
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+			for (int k=0; k<100; ++k)
+			{
+				std::string line = std::to_string(k) + " " + std::to_string(2 * k);
+				::sendto(fd, line.data(), line.size(), 0, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+			}
+			::sendto(fd, "", 0, 0, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+			::close(fd);
+		});
+
+		Eigen::Vector2d y;
+		int k = 0;
+		while (source.next(y))
+		{
+			EXPECT_EQ(y(0), k);
+			EXPECT_EQ(y(1), 2 * k);
+			k++;
+		}
+		EXPECT_EQ(k, 100);
+		sender.join();
+	}
+
+	TEST(measurementSource, open_invalid)
+	{
+		measurementSource source;
+		EXPECT_FALSE(source.open("tcp:1234"));
+		EXPECT_FALSE(source.open("fifo:../filter____output/test.fifo"));
+		Eigen::Vector2d y;
+		EXPECT_FALSE(source.next(y));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
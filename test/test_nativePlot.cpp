@@ -0,0 +1,158 @@
+/**
+ * @file test_nativePlot.cpp
+ * @brief built-in plot renderer, writes the matPlot figures as PNG and SVG without Python
+ * @function nativePlot::plot(std::vector<double>, std::vector<double>, std::string), nativePlot::save(std::string),
+ *           nativePlot::fillBetween(std::vector<double>, std::vector<double>, std::vector<double>, std::string, double)
+ * @note test cases check the PNG structure (signature, header, chunk checksums) and the SVG contents; the PNG pixels were
+ *       checked against zlib when the renderer was written; the render time is measured by BM_matPlot in bench/bench_matPlot.cpp,
+ *       built with -DNATIVE_PLOT=ON
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "../src/nativePlot.h"
+
+namespace
+{
+	const std::string png_name = "../filter_output/test_nativePlot.png";
+	const std::string svg_name = "../filter_output/test_nativePlot.svg";
+
+	std::string readFile(const std::string file_name)
+	{
+		std::ifstream file_in(file_name, std::ifstream::binary);
+		return std::string((std::istreambuf_iterator<char>(file_in)), std::istreambuf_iterator<char>());
+	}
+
+	std::uint32_t get32(const std::string& data, std::size_t pos)
+	{
+		return (std::uint32_t(std::uint8_t(data[pos])) << 24) | (std::uint32_t(std::uint8_t(data[pos+1])) << 16) |
+			(std::uint32_t(std::uint8_t(data[pos+2])) << 8) | std::uint32_t(std::uint8_t(data[pos+3]));
+	}
+
+	std::size_t countOf(const std::string& text, const std::string& pattern)
+	{
+		std::size_t count = 0;
+		for (std::size_t pos=text.find(pattern); pos!=std::string::npos; pos=text.find(pattern, pos+1))
+		{
+			count++;
+		}
+		return count;
+	}
+
+	/// The NIS figure of matPlot: a threshold line and the filter output
+	void nisFigure(nativePlot& figure, int n)
+	{
+		std::vector<double> t(n), nis(n), threshold(n, 5.9915);
+		for (int i=0; i<n; ++i)
+		{
+			t[i] = i;
+			nis[i] = 3.0 * std::fabs(std::sin(0.05 * i)) + (i % 97 == 0 ? 8.0 : 0.0);
+		}
+		figure.plot(t, threshold, "r-");
+		figure.plot(t, nis);
+		figure.title("NIS, 0.011 above the 0.05 threshold");
+		figure.xlabel("Receiver time, s");
+		figure.ylabel(" ");
+	}
+
+	TEST(nativePlot, savePNG)
+	{
+		nativePlot figure(320, 240);
+		nisFigure(figure, 1000);
+		ASSERT_TRUE(figure.save(png_name));
+
+		std::string png = readFile(png_name);
+		ASSERT_GT(png.size(), 8u);
+		EXPECT_EQ(png.substr(0, 8), std::string("\x89PNG\r\n\x1a\n", 8));
+
+		/// Walk the chunks, every CRC must match
+		std::vector<std::string> types;
+		std::size_t pos = 8;
+		while (pos + 12 <= png.size())
+		{
+			std::uint32_t length = get32(png, pos);
+			ASSERT_LE(pos + 12 + length, png.size());
+			types.push_back(png.substr(pos + 4, 4));
+			EXPECT_EQ(get32(png, pos + 8 + length), pngCrc(reinterpret_cast<const unsigned char*>(png.data() + pos + 4), length + 4));
+			if (types.back() == "IHDR")
+			{
+				EXPECT_EQ(get32(png, pos + 8), 320u);
+				EXPECT_EQ(get32(png, pos + 12), 240u);
+			}
+			pos += 12 + length;
+		}
+		EXPECT_EQ(pos, png.size());
+		ASSERT_EQ(types.size(), 3u);
+		EXPECT_EQ(types[0], "IHDR");
+		EXPECT_EQ(types[1], "IDAT");
+		EXPECT_EQ(types[2], "IEND");
+		remove(png_name.c_str());
+	}
+
+	TEST(nativePlot, saveSVG)
+	{
+		nativePlot figure;
+		std::vector<double> x = {0.0, 1.0, 2.0, 3.0, 4.0};
+		std::vector<double> y = {1.0, 2.0, NAN, 4.0, 5.0};
+		figure.plot(x, y, "k");
+		figure.title("a < b & c");
+		ASSERT_TRUE(figure.save(svg_name));
+
+		std::string svg = readFile(svg_name);
+		EXPECT_EQ(svg.compare(0, 4, "<svg"), 0);
+		EXPECT_NE(svg.find("</svg>"), std::string::npos);
+		EXPECT_NE(svg.find("a &lt; b &amp; c"), std::string::npos);
+
+		/// The non-finite value splits the series in two polylines
+		EXPECT_EQ(countOf(svg, "<polyline"), 2u);
+		EXPECT_NE(svg.find("stroke=\"#000000\" stroke-width=\"2\""), std::string::npos);
+		remove(svg_name.c_str());
+	}
+
+	/// Bands are polygons below the lines, split at gaps, and widen the axis limits
+	TEST(nativePlot, fillBetween)
+	{
+		nativePlot figure;
+		std::vector<double> x = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+		std::vector<double> y = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+		std::vector<double> lower = {-9.0, 0.0, 0.0, NAN, 0.0, 0.0};
+		std::vector<double> upper = {2.0, 2.0, 2.0, 2.0, 2.0, 2.0};
+		EXPECT_FALSE(figure.fillBetween(x, lower, std::vector<double>(5, 2.0)));
+		figure.plot(x, y, "k");
+		ASSERT_TRUE(figure.fillBetween(x, lower, upper, "", 0.25));
+		ASSERT_TRUE(figure.save(svg_name));
+		ASSERT_TRUE(figure.save(png_name));
+
+		std::string svg = readFile(svg_name);
+		EXPECT_EQ(countOf(svg, "<polygon"), 2u);
+		EXPECT_NE(svg.find("fill=\"#1f77b4\" fill-opacity=\"0.25\""), std::string::npos);
+		EXPECT_LT(svg.find("<polygon"), svg.find("<polyline"));
+		EXPECT_NE(svg.find(">-8</text>"), std::string::npos);
+		remove(svg_name.c_str());
+		remove(png_name.c_str());
+	}
+
+	TEST(nativePlot, plot_invalid)
+	{
+		nativePlot figure;
+		EXPECT_FALSE(figure.plot(std::vector<double>(3, 1.0), std::vector<double>(2, 1.0)));
+		EXPECT_FALSE(figure.save("../filter_output/test_nativePlot.jpg"));
+		EXPECT_FALSE(figure.save("../filter____output/test_nativePlot.png"));
+
+		/// An empty figure or a constant series still gets valid limits
+		EXPECT_TRUE(figure.save(png_name));
+		figure.plot(std::vector<double>(10, 2.0), std::vector<double>(10, 2.0));
+		EXPECT_TRUE(figure.save(png_name));
+		remove(png_name.c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,202 @@
+/**
+ * @file test_outputPyramid.cpp
+ * @brief multi-resolution output file, the full resolution histories with their min/max/mean pyramid
+ * @function outputPyramid::write, outputPyramid::open, outputPyramid::levelFor, outputPyramid::read
+ * @note the summaries read back are compared with ones computed directly from the histories, up to the coarsest level of a
+ *       10^7 epoch run
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "../src/outputPyramid.h"
+
+namespace
+{
+	const std::string pyramid_name = "../filter_output/test_outputPyramid.p1pyr";
+
+	/// Histories shaped like xhat_hist and nis_hist, with a dropout in the NIS
+	void histories(int epochs, Eigen::MatrixXd& xhat_hist, Eigen::MatrixXd& nis_hist)
+	{
+		xhat_hist.resize(2, epochs);
+		nis_hist.resize(1, epochs);
+		for (int k=0; k<epochs; ++k)
+		{
+			xhat_hist(0, k) = 100.0 * std::sin(1.0e-2 * k) + k;
+			xhat_hist(1, k) = std::cos(3.0e-2 * k);
+			nis_hist(0, k) = (k >= 40 and k < 48) ? NAN : std::fabs(std::sin(0.7 * k)) * 6.0;
+		}
+	}
+
+	TEST(outputPyramid, levels)
+	{
+		Eigen::MatrixXd xhat_hist, nis_hist;
+		histories(1001, xhat_hist, nis_hist);
+		ASSERT_TRUE(outputPyramid::write(pyramid_name, {&xhat_hist, &nis_hist}, 10.0, 0.5));
+
+		outputPyramid pyramid;
+		ASSERT_TRUE(pyramid.open(pyramid_name));
+		EXPECT_EQ(pyramid.info().channels, 3u);
+		EXPECT_EQ(pyramid.info().epochs, 1001u);
+		EXPECT_EQ(pyramid.info().t0, 10.0);
+		EXPECT_EQ(pyramid.info().dt, 0.5);
+
+		/// 1001 epochs halve down to one record in 10 steps
+		ASSERT_EQ(pyramid.levels().size(), 11u);
+		for (std::size_t l=0; l<pyramid.levels().size(); ++l)
+		{
+			EXPECT_EQ(pyramid.levels()[l].factor, 1u << l);
+			EXPECT_EQ(pyramid.levels()[l].count, (1001u + (1u << l) - 1) >> l);
+			EXPECT_EQ(pyramid.levels()[l].offset % 64, 0u);
+		}
+		remove(pyramid_name.c_str());
+	}
+
+	/// Every level read back matches the summaries of the histories over the same epochs
+	TEST(outputPyramid, read)
+	{
+		Eigen::MatrixXd xhat_hist, nis_hist;
+		histories(1001, xhat_hist, nis_hist);
+		ASSERT_TRUE(outputPyramid::write(pyramid_name, {&xhat_hist, &nis_hist}, 10.0, 0.5));
+		outputPyramid pyramid;
+		ASSERT_TRUE(pyramid.open(pyramid_name));
+
+		pyramid_window window;
+		ASSERT_TRUE(pyramid.read(10.0 + 0.5 * 100, 10.0 + 0.5 * 199, 0, window));
+		ASSERT_EQ(window.values.cols(), 100);
+		ASSERT_EQ(window.values.rows(), 3);
+		EXPECT_EQ(window.first, 100u);
+		EXPECT_EQ(window.time[0], 60.0);
+		EXPECT_EQ(window.values(0, 5), xhat_hist(0, 105));
+		EXPECT_EQ(window.values(1, 5), xhat_hist(1, 105));
+		EXPECT_EQ(window.values(2, 5), nis_hist(0, 105));
+
+		for (std::uint32_t level=1; level<pyramid.levels().size(); ++level)
+		{
+			ASSERT_TRUE(pyramid.read(0.0, 1.0e9, level, window));
+			ASSERT_EQ(window.values.rows(), 9);
+			ASSERT_EQ(static_cast<std::uint64_t>(window.values.cols()), pyramid.levels()[level].count);
+			for (Eigen::Index b=0; b<window.values.cols(); ++b)
+			{
+				Eigen::Index begin = b * window.factor;
+				Eigen::Index end = std::min<Eigen::Index>(begin + window.factor, 1001);
+				EXPECT_EQ(window.time[b], 10.0 + 0.5 * begin);
+				for (int c=0; c<3; ++c)
+				{
+					Eigen::RowVectorXd values = c < 2 ? xhat_hist.row(c).segment(begin, end - begin) : nis_hist.row(0).segment(begin, end - begin);
+					double lo = INFINITY, hi = -INFINITY, sum = 0.0;
+					int count = 0;
+					for (Eigen::Index k=0; k<values.size(); ++k)
+					{
+						if (std::isfinite(values[k]))
+						{
+							lo = std::min(lo, values[k]);
+							hi = std::max(hi, values[k]);
+							sum += values[k];
+							count++;
+						}
+					}
+					if (count == 0)
+					{
+						/// A bucket inside the dropout
+						EXPECT_TRUE(std::isnan(window.values(3*c, b)));
+						EXPECT_TRUE(std::isnan(window.values(3*c + 2, b)));
+						continue;
+					}
+					EXPECT_EQ(window.values(3*c, b), lo);
+					EXPECT_EQ(window.values(3*c + 1, b), hi);
+					EXPECT_NEAR(window.values(3*c + 2, b), sum / count, 1.0e-9 * std::max(1.0, std::fabs(sum / count)));
+				}
+			}
+		}
+		remove(pyramid_name.c_str());
+	}
+
+	TEST(outputPyramid, window_bounds)
+	{
+		Eigen::MatrixXd xhat_hist, nis_hist;
+		histories(1000, xhat_hist, nis_hist);
+		ASSERT_TRUE(outputPyramid::write(pyramid_name, {&xhat_hist, &nis_hist}, 0.0, 1.0));
+		outputPyramid pyramid;
+		ASSERT_TRUE(pyramid.open(pyramid_name));
+
+		/// Clamped to the run, windows outside it are rejected
+		pyramid_window window;
+		ASSERT_TRUE(pyramid.read(-50.0, 10.0, 2, window));
+		EXPECT_EQ(window.first, 0u);
+		EXPECT_EQ(window.values.cols(), 3);
+		ASSERT_TRUE(pyramid.read(990.0, 5000.0, 0, window));
+		EXPECT_EQ(window.values.cols(), 10);
+		EXPECT_FALSE(pyramid.read(1000.0, 2000.0, 0, window));
+		EXPECT_FALSE(pyramid.read(-20.0, -10.0, 0, window));
+		EXPECT_FALSE(pyramid.read(20.0, 10.0, 0, window));
+		EXPECT_FALSE(pyramid.read(0.0, 10.0, 99, window));
+
+		/// Full resolution for a short window, coarser levels for the whole run
+		EXPECT_EQ(pyramid.levelFor(100.0, 200.0, 4000), 0u);
+		EXPECT_EQ(pyramid.levelFor(0.0, 999.0, 100), 4u);
+		EXPECT_EQ(pyramid.levelFor(0.0, 999.0, 1), 10u);
+		remove(pyramid_name.c_str());
+	}
+
+	TEST(outputPyramid, invalid)
+	{
+		Eigen::MatrixXd xhat_hist, nis_hist;
+		histories(100, xhat_hist, nis_hist);
+		Eigen::MatrixXd short_hist = nis_hist.leftCols(50);
+		EXPECT_FALSE(outputPyramid::write(pyramid_name, {&xhat_hist, &short_hist}, 0.0, 1.0));
+		EXPECT_FALSE(outputPyramid::write(pyramid_name, {&xhat_hist}, 0.0, 0.0));
+		EXPECT_FALSE(outputPyramid::write("../filter____output/test_outputPyramid.p1pyr", {&xhat_hist}, 0.0, 1.0));
+
+		outputPyramid pyramid;
+		EXPECT_FALSE(pyramid.open("../filter_output/test_outputPyramid_missing.p1pyr"));
+		std::ofstream("../filter_output/test_outputPyramid.txt") << "not a pyramid";
+		EXPECT_FALSE(pyramid.open("../filter_output/test_outputPyramid.txt"));
+		pyramid_window window;
+		EXPECT_FALSE(pyramid.read(0.0, 1.0, 0, window));
+		remove("../filter_output/test_outputPyramid.txt");
+	}
+
+	/// A 10^7 epoch run: every query at the level picked for 2000 points stays under 2000 records, and the coarsest level
+	/// summarizes the whole run; the write and query times are measured by BM_outputPyramid_write and BM_outputPyramid_query
+	/// in bench/bench_fileIO.cpp
+	TEST(outputPyramid, long_run)
+	{
+		const int epochs = 10000000;
+		Eigen::MatrixXd xhat_hist = Eigen::MatrixXd::Random(2, epochs);
+		Eigen::MatrixXd nis_hist = Eigen::MatrixXd::Random(1, epochs).cwiseAbs();
+		ASSERT_TRUE(outputPyramid::write(pyramid_name, {&xhat_hist, &nis_hist}, 0.0, 1.0));
+
+		outputPyramid pyramid;
+		ASSERT_TRUE(pyramid.open(pyramid_name));
+		pyramid_window window;
+		for (int q=0; q<1000; ++q)
+		{
+			double t_begin = (q * 7919.0 * 1237.0);
+			t_begin = std::fmod(t_begin, epochs - 100000.0);
+			std::uint32_t level = pyramid.levelFor(t_begin, t_begin + 100000.0, 2000);
+			ASSERT_TRUE(pyramid.read(t_begin, t_begin + 100000.0, level, window));
+			ASSERT_LE(window.values.cols(), 2000);
+		}
+		EXPECT_EQ(window.values(1, 0), xhat_hist.row(0).segment(window.first * window.factor, window.factor).maxCoeff());
+
+		const std::uint32_t top = pyramid.info().levels - 1;
+		ASSERT_TRUE(pyramid.read(0.0, epochs - 1.0, top, window));
+		ASSERT_EQ(window.values.cols(), 1);
+		EXPECT_EQ(window.values(0, 0), xhat_hist.row(0).minCoeff());
+		EXPECT_EQ(window.values(1, 0), xhat_hist.row(0).maxCoeff());
+		EXPECT_EQ(window.values(7, 0), nis_hist.maxCoeff());
+		EXPECT_NEAR(window.values(5, 0), xhat_hist.row(1).mean(), 1.0e-12);
+		remove(pyramid_name.c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_perfCounters.cpp
+ * @brief hardware performance counters read with perf_event_open around a region
+ * @function perfCounters::open(), perfCounters::start(), perfCounters::stop(uint64_t), perfCounters::counts(),
+ *           perfCounters::report(string, string), twoStateClockModel::setParseCounters(perfCounters*)
+ * @note the hardware counters are often unavailable (perf_event_paranoid, VMs, containers): the test cases then check that the
+ *       counters degrade to the software ones, or to nothing, without failing a run
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio> // std::remove
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/perfCounters.h"
+
+namespace
+{
+	/// Some work the counters can see: a dependent chain the compiler cannot fold
+	double spin(const int n)
+	{
+		volatile double x = 1.0;
+		for (int i=0; i<n; ++i)
+		{
+			x = x * 1.0000001 + 1e-9;
+		}
+		return x;
+	}
+
+	/// Unopened counters count nothing and say so
+	TEST(perfCounters, not_opened)
+	{
+		perfCounters counters;
+		EXPECT_FALSE(counters.available());
+		EXPECT_FALSE(counters.hardwareAvailable());
+		counters.start();
+		spin(1000);
+		counters.stop(10);
+		EXPECT_EQ(counters.units(), 0u);
+		EXPECT_EQ(counters.counts().cycles, 0u);
+		EXPECT_EQ(counters.report("Filter loop", "epoch"), "Filter loop counters unavailable: not opened");
+	}
+
+	/// Only what runs between start and stop is counted, the units of every region add up
+	TEST(perfCounters, regions)
+	{
+		perfCounters counters;
+		if (!counters.open())
+		{
+			std::cout << "No counters: " << counters.why() << std::endl;
+			EXPECT_FALSE(counters.why().empty());
+			return;
+		}
+
+		counters.start();
+		spin(1000000);
+		counters.stop(1000);
+		const perf_counts first = counters.counts();
+		spin(10000000);
+		counters.start();
+		spin(1000000);
+		counters.stop(1000);
+		const perf_counts both = counters.counts();
+		EXPECT_EQ(counters.units(), 2000u);
+		EXPECT_GT(both.task_clock_ns, first.task_clock_ns);
+		EXPECT_LT(both.task_clock_ns, 5 * first.task_clock_ns);
+
+		if (counters.hardwareAvailable())
+		{
+			EXPECT_TRUE(counters.why().empty());
+			EXPECT_GT(first.instructions, 1000000u);
+			EXPECT_LT(both.instructions, 5 * first.instructions);
+			EXPECT_NE(counters.report("Filter loop", "epoch").find("IPC"), std::string::npos);
+		}
+		else
+		{
+			std::cout << "Hardware counters unavailable: " << counters.why() << std::endl;
+			EXPECT_EQ(both.cycles, 0u);
+			EXPECT_NE(counters.report("Filter loop", "epoch").find("hardware counters unavailable"), std::string::npos);
+		}
+		EXPECT_NE(counters.report("Filter loop", "epoch").find("per epoch"), std::string::npos);
+	}
+
+	/// Threads started after open and joined before stop are counted with the calling thread
+	TEST(perfCounters, inherited_threads)
+	{
+		perfCounters counters;
+		if (!counters.open())
+		{
+			return;
+		}
+		counters.start();
+		spin(2000000);
+		counters.stop(1);
+		const std::uint64_t alone = counters.counts().task_clock_ns;
+
+		counters.start();
+		std::thread worker([]() { spin(2000000); });
+		spin(2000000);
+		worker.join();
+		counters.stop(1);
+		EXPECT_GT(counters.counts().task_clock_ns - alone, alone + alone / 2);
+	}
+
+	/// The text parses of getInputData are counted per byte of the file
+	TEST(perfCounters, parse_counters)
+	{
+		perfCounters counters;
+		if (!counters.open())
+		{
+			return;
+		}
+		std::ofstream("perf_parse.txt") << "1 2 3\n4 5 6\n";
+		twoStateClockModel model(false, 1);
+		model.setInputDir(".");
+		model.setParseCounters(&counters);
+		mat values;
+		model.getInputData("perf_parse.txt", values);
+		EXPECT_EQ(values.rows(), 2);
+		EXPECT_EQ(counters.units(), 12u);
+
+		std::vector<std::vector<double> > rows;
+		EXPECT_TRUE(model.readFromFile("perf_parse.txt", rows));
+		EXPECT_EQ(counters.units(), 24u);
+		EXPECT_NE(counters.report("Parse", "byte").find("24 bytes"), std::string::npos);
+		std::remove("perf_parse.txt");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
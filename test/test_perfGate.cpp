@@ -0,0 +1,291 @@
+/**
+ * @file test_perfGate.cpp
+ * @brief performance regression gate: filter epochs/s, parse MB/s and write MB/s against the baseline in perf_baseline.txt
+ * @function twoStateClockModel::simpleEKF, twoStateClockModel::getInputData, twoStateClockModel::writeToFile
+ * @note every throughput is divided by the score of a fixed calibration loop run on the same host, so the baseline holds
+ *       ratios that carry over between machines; a test case fails when its ratio is lower than the baseline by more than the
+ *       tolerance (25%, "--tolerance <fraction>" or POINTONENAV_PERF_TOLERANCE) in three attempts. "--update-baseline" rewrites
+ *       the baseline file with the median ratios of this run instead. Run by "ctest -L perf", built optimized whatever the build type.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/clockSimulator.h"
+
+namespace
+{
+	/// Set by main from the command line
+	std::string baseline_file = "perf_baseline.txt";
+	double tolerance = 0.25;
+	bool update_baseline = false;
+
+	/// Reduced set: large enough to be past the fixed costs, small enough for a few seconds per run
+	const std::uint64_t gate_epochs = 200000;
+	const int repetitions = 5;
+
+	/// A shared host has slow spells: a throughput below the tolerance is measured again, calibration included, before failing
+	const int attempts = 3;
+
+	const std::string history_file = "perf_gate_history.txt";
+	const std::string history_input = "../filter_output/perf_gate_history.txt";
+
+	/// Ratios measured by this run, written by --update-baseline
+	std::map<std::string, double> measured;
+
+	double seconds(const std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/**
+	 * @brief calibration score of the host, runs per second of a fixed loop: a dependent floating-point chain like the filter
+	 * arithmetic and a pass over 16 MB like the parse and write buffers, best of the repetitions
+	 */
+	double calibration()
+	{
+		std::vector<double> buffer(2 * 1024 * 1024, 1.0);
+		double best = 0.0;
+		for (int r=0; r<repetitions; ++r)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			volatile double sink = 0.0;
+			double a = 1.0, b = 0.5, c = 0.25, d = 0.125;
+			for (int i=0; i<4000000; ++i)
+			{
+				const double t = a * d - b * c + 1e-9;
+				a = b * 0.999999 + t;
+				b = c * 1.000001 - t;
+				c = d + 0.5 * t;
+				d = 1.0 / (1.0 + t * t);
+			}
+			double sum = 0.0;
+			for (int pass=0; pass<4; ++pass)
+			{
+				for (std::size_t i=0; i<buffer.size(); ++i)
+				{
+					buffer[i] = buffer[i] * 0.5 + 0.5;
+					sum += buffer[i];
+				}
+			}
+			sink = a + b + c + d + sum;
+			(void)sink;
+			const double elapsed = seconds(start);
+			best = best == 0.0 ? elapsed : std::min(best, elapsed);
+		}
+		return 1.0 / best;
+	}
+
+	/**
+	 * @brief readBaseline the ratios of the baseline file, "<name> <ratio>" per line, '#' comments
+	 */
+	std::map<std::string, double> readBaseline()
+	{
+		std::map<std::string, double> baseline;
+		std::ifstream file(baseline_file);
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream fields(line);
+			std::string name;
+			double ratio;
+			if (line.empty() or line[0] == '#' or !(fields >> name >> ratio))
+			{
+				continue;
+			}
+			baseline[name] = ratio;
+		}
+		return baseline;
+	}
+
+	/**
+	 * @brief check compare a throughput with its baseline, once scaled by the calibration score measured just before it; the
+	 * baseline written by --update-baseline is the median of the attempts
+	 * @param name the throughput in the baseline file
+	 * @param measure measures the throughput, in its own unit
+	 */
+	void check(const std::string name, const std::function<double()> measure)
+	{
+		std::map<std::string, double> baseline = readBaseline();
+		ASSERT_TRUE(update_baseline or baseline.count(name)) << name << " missing from " << baseline_file << ", rerun with --update-baseline";
+
+		std::vector<double> ratios;
+		double ratio = 0.0;
+		for (int a=0; a<attempts; ++a)
+		{
+			const double score = calibration();
+			const double throughput = measure();
+			ratios.push_back(throughput / score);
+			ratio = std::max(ratio, ratios.back());
+			std::cout << std::setprecision(4) << name << ": " << throughput << ", " << ratios.back() << " per calibration run/s" << std::endl;
+			if (!update_baseline and ratio >= (1.0 - tolerance) * baseline[name])
+			{
+				break;
+			}
+		}
+		if (update_baseline)
+		{
+			std::sort(ratios.begin(), ratios.end());
+			measured[name] = ratios[ratios.size() / 2];
+			return;
+		}
+		EXPECT_GE(ratio, (1.0 - tolerance) * baseline[name]) << name << " is " << 100.0 * (1.0 - ratio / baseline[name])
+			<< "% slower than the baseline, more than the " << 100.0 * tolerance << "% tolerated";
+	}
+
+	/// Measurements and filter inputs of the clock model in filter_input, simulated
+	filter_input gateInputs()
+	{
+		simulation_config config;
+		config.epochs = gate_epochs;
+		config.seed = 7;
+		config.initial_state << -32186.470260709215, 26.07840844955248;
+		config.initial_covariance << 49.0, 0.0, 0.0, 0.04;
+		config.process_noise_covariance << 0.020814695877451838, 0.017740716135125494, 0.017740716135125494, 0.035481432270250989;
+		config.measurement_noise_covariance << 49.0, 0.0, 0.0, 0.04;
+
+		filter_input f_in;
+		Eigen::MatrixXd truth;
+		clockSimulator(config).simulate(0, 0, gate_epochs, truth, f_in.measurement_history);
+		f_in.initial_state_estimate = config.initial_state;
+		f_in.initial_state_estimate_covariance = config.initial_covariance;
+		f_in.process_noise_covariance = config.process_noise_covariance;
+		f_in.measurement_noise_covariance = config.measurement_noise_covariance;
+		return f_in;
+	}
+
+	/// The filter loop of main.cpp, without the statistics
+	TEST(perfGate, filter_epochs_per_s)
+	{
+		const filter_input f_in = gateInputs();
+		const int n = f_in.measurement_history.cols();
+		twoStateClockModel model(false, 1);
+		mat w_k = mat::Zero(2,1);
+		mat v_kp1 = mat::Zero(2,1);
+		mat xhat_hist = mat::Zero(2,n+1);
+
+		check("filter_epochs_per_s", [&]()
+		{
+			double best = 0.0;
+			for (int r=0; r<repetitions; ++r)
+			{
+				mat xk_est = f_in.initial_state_estimate;
+				mat xcovk_est = f_in.initial_state_estimate_covariance;
+				const auto start = std::chrono::steady_clock::now();
+				for (int kp1=0; kp1<n; ++kp1)
+				{
+					mat y_kp1 = f_in.measurement_history.col(kp1);
+					model.simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, y_kp1, v_kp1, f_in.measurement_noise_covariance);
+					xhat_hist.col(kp1+1) = model.get_xkp1();
+					xk_est = model.get_xkp1();
+					xcovk_est = model.get_xcov_kp1();
+				}
+				const double elapsed = seconds(start);
+				best = best == 0.0 ? elapsed : std::min(best, elapsed);
+			}
+			EXPECT_TRUE(xhat_hist.allFinite());
+			return n / best;
+		});
+	}
+
+	/// getInputData parsing the text file, the cache sidecar off
+	TEST(perfGate, parse_mb_per_s)
+	{
+		twoStateClockModel model(false, 1);
+		ASSERT_TRUE(model.writeToFile(history_file, gateInputs().measurement_history));
+		std::ifstream file(history_input, std::ios::binary | std::ios::ate);
+		const double megabytes = file.tellg() / 1e6;
+
+		model.setInputCache(false);
+		model.setInputDir("");
+		check("parse_mb_per_s", [&]()
+		{
+			double best = 0.0;
+			for (int r=0; r<repetitions; ++r)
+			{
+				mat history;
+				const auto start = std::chrono::steady_clock::now();
+				model.getInputData(history_input, history);
+				const double elapsed = seconds(start);
+				EXPECT_EQ(history.cols(), static_cast<int>(gate_epochs));
+				best = best == 0.0 ? elapsed : std::min(best, elapsed);
+			}
+			return megabytes / best;
+		});
+		std::remove(history_input.c_str());
+	}
+
+	/// writeToFile of a measurement history, not flushed to disk
+	TEST(perfGate, write_mb_per_s)
+	{
+		twoStateClockModel model(false, 1);
+		const mat history = gateInputs().measurement_history;
+		ASSERT_TRUE(model.writeToFile(history_file, history));
+		std::ifstream file(history_input, std::ios::binary | std::ios::ate);
+		const double megabytes = file.tellg() / 1e6;
+		file.close();
+		check("write_mb_per_s", [&]()
+		{
+			double best = 0.0;
+			for (int r=0; r<repetitions; ++r)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				EXPECT_TRUE(model.writeToFile(history_file, history));
+				const double elapsed = seconds(start);
+				best = best == 0.0 ? elapsed : std::min(best, elapsed);
+			}
+			return megabytes / best;
+		});
+		std::remove(history_input.c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	/// "--baseline <file>", "--tolerance <fraction>", "--update-baseline"
+	if (std::getenv("POINTONENAV_PERF_TOLERANCE") != NULL)
+	{
+		tolerance = std::atof(std::getenv("POINTONENAV_PERF_TOLERANCE"));
+	}
+	for (int i=1; i<argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--baseline" and i+1 < argc)
+		{
+			baseline_file = argv[++i];
+		}
+		else if (arg == "--tolerance" and i+1 < argc)
+		{
+			tolerance = std::atof(argv[++i]);
+		}
+		else if (arg == "--update-baseline")
+		{
+			update_baseline = true;
+		}
+	}
+
+	int result = RUN_ALL_TESTS();
+	if (update_baseline and result == 0)
+	{
+		std::ofstream file(baseline_file);
+		file << "# Performance gate baseline (test_perfGate --update-baseline): throughput per calibration run/s" << std::endl;
+		for (auto it=measured.begin(); it!=measured.end(); it++)
+		{
+			file << it->first << " " << std::setprecision(6) << it->second << std::endl;
+		}
+		std::cout << "Baseline written to " << baseline_file << std::endl;
+		result = file ? 0 : 1;
+	}
+	return result;
+}
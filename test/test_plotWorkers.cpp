@@ -0,0 +1,167 @@
+/**
+ * @file test_plotWorkers.cpp
+ * @brief worker processes that render the plots in the background
+ * @function plotWorkers::spawn, plotWorkers::wait, plotWorkers::running
+ * @note the jobs run in forked children, so their results are checked through the files they write and their exit status
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/plotWorkers.h"
+
+namespace
+{
+	TEST(plotWorkers, spawn_wait)
+	{
+		plotWorkers workers;
+		for (int i=0; i<3; ++i)
+		{
+			EXPECT_TRUE(workers.spawn([i]()
+			{
+				std::ofstream file_out("../filter_output/test_plotWorkers_" + std::to_string(i) + ".txt");
+				file_out << i;
+			}));
+		}
+		EXPECT_EQ(workers.running(), 3u);
+		EXPECT_TRUE(workers.wait());
+		EXPECT_EQ(workers.running(), 0u);
+
+		for (int i=0; i<3; ++i)
+		{
+			std::string file_name = "../filter_output/test_plotWorkers_" + std::to_string(i) + ".txt";
+			std::ifstream file_in(file_name);
+			int value = -1;
+			file_in >> value;
+			EXPECT_EQ(value, i);
+			remove(file_name.c_str());
+		}
+	}
+
+	/// An exception or a nonzero exit in any child is reported by wait
+	TEST(plotWorkers, failed_job)
+	{
+		plotWorkers workers;
+		workers.spawn([]() {});
+		workers.spawn([]()
+		{
+			throw std::runtime_error("test_plotWorkers");
+		});
+		EXPECT_FALSE(workers.wait());
+
+		workers.spawn([]()
+		{
+			::_exit(3);
+		});
+		EXPECT_FALSE(workers.wait());
+
+		/// Nothing left to wait for
+		EXPECT_TRUE(workers.wait());
+	}
+
+	/// The jobs run at the same time: each one marks that it started and only succeeds if it sees every other one started too,
+	/// which cannot happen if they run one after the other
+	TEST(plotWorkers, concurrent)
+	{
+		const int jobs = 3;
+		auto marker = [](int i)
+		{
+			return "../filter_output/test_plotWorkers_started_" + std::to_string(i) + ".txt";
+		};
+		for (int i=0; i<jobs; ++i)
+		{
+			remove(marker(i).c_str());
+		}
+		plotWorkers workers;
+		for (int i=0; i<jobs; ++i)
+		{
+			workers.spawn([i, jobs, marker]()
+			{
+				std::ofstream(marker(i)) << i;
+				for (int poll=0; poll<1000; ++poll)
+				{
+					int started = 0;
+					for (int j=0; j<jobs; ++j)
+					{
+						started += std::ifstream(marker(j)).good() ? 1 : 0;
+					}
+					if (started == jobs)
+					{
+						return;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				::_exit(1);
+			});
+		}
+		EXPECT_TRUE(workers.wait());
+		for (int i=0; i<jobs; ++i)
+		{
+			remove(marker(i).c_str());
+		}
+	}
+
+#ifndef POINTONENAV_NO_PLOT
+	/// The figures rendered by the workers, as main.cpp does after the filter
+	TEST(plotWorkers, matPlot)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		mat xhat_hist = mat::Random(2, 2000);
+		plotWorkers workers;
+		workers.spawn([&]()
+		{
+			clockModel->matPlot(xhat_hist.row(0), 0.0, 1.0, "test_plotWorkers_bias", "Receiver time, s", "Clock bias estimate, m", 0.0);
+		});
+		workers.spawn([&]()
+		{
+			clockModel->matPlot(xhat_hist.row(1), 0.0, 1.0, "test_plotWorkers_rate", "Receiver time, s", "Clock rate estimate, m/s", 0.0);
+		});
+		EXPECT_TRUE(workers.wait());
+
+		for (const std::string name : {"test_plotWorkers_bias", "test_plotWorkers_rate"})
+		{
+			std::ifstream png("../filter_output/" + name + ".png");
+			std::ifstream svg("../filter_output/" + name + ".svg");
+			EXPECT_TRUE(png.good());
+			EXPECT_TRUE(svg.good());
+			remove(("../filter_output/" + name + ".png").c_str());
+			remove(("../filter_output/" + name + ".svg").c_str());
+		}
+	}
+
+	/// A figure that cannot be saved fails its worker, the way main.cpp reports it
+	TEST(plotWorkers, matPlot_failed)
+	{
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setHeadless(true);
+
+		mat xhat_hist = mat::Random(2, 100);
+		EXPECT_FALSE(clockModel->matPlot(xhat_hist.row(0), 0.0, 1.0, "test_plotWorkers____dir/bias", " ", " ", 0.0));
+
+		plotWorkers workers;
+		workers.spawn([&]()
+		{
+			if (!clockModel->matPlot(xhat_hist.row(0), 0.0, 1.0, "test_plotWorkers____dir/bias", " ", " ", 0.0))
+			{
+				throw std::runtime_error("test_plotWorkers____dir/bias not saved");
+			}
+		});
+		EXPECT_FALSE(workers.wait());
+	}
+#endif
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
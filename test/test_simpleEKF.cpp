@@ -614,6 +614,31 @@ namespace
 		}
 		EXPECT_FALSE(temp_2.sum() == xcovk_est.sum());
 	}
+
+	/// A dropout epoch (nan measurement) only predicts: x = F x, P = F P F' + Q, and the innovation is nan
+	TEST(twoStateClockModel, simpleEKF_dropout)
+	{
+		filter_input f_in;
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->getInputData("initial_state_estimate.txt", f_in.initial_state_estimate);
+		clockModel->getInputData("initial_state_estimate_covariance.txt", f_in.initial_state_estimate_covariance);
+		clockModel->getInputData("measurement_noise_covariance.txt", f_in.measurement_noise_covariance);
+		clockModel->getInputData("process_noise_covariance.txt", f_in.process_noise_covariance);
+
+		mat xk_est = f_in.initial_state_estimate;
+		mat xcovk_est = f_in.initial_state_estimate_covariance;
+		mat w_k = mat::Zero(2,1);
+		mat v_kp1 = mat::Zero(2,1);
+		mat y_kp1 = mat::Constant(2, 1, std::numeric_limits<double>::quiet_NaN());
+		mat dyn(2,2);
+		dyn << 1, 1, 0, 1;
+
+		clockModel->simpleEKF(xk_est, xcovk_est, w_k, f_in.process_noise_covariance, y_kp1, v_kp1, f_in.measurement_noise_covariance);
+		EXPECT_TRUE(clockModel->get_xkp1().isApprox(dyn * xk_est));
+		EXPECT_TRUE(clockModel->get_xcov_kp1().isApprox(dyn * xcovk_est * dyn.transpose() + f_in.process_noise_covariance));
+		EXPECT_FALSE(clockModel->get_zkp1().allFinite());
+		EXPECT_TRUE(clockModel->get_xkp1().allFinite());
+	}
 }
 
 int main(int argc, char** argv)
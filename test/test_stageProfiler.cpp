@@ -0,0 +1,183 @@
+/**
+ * @file test_stageProfiler.cpp
+ * @brief per-stage instrumentation: wall time, CPU time, peak RSS growth and item count of every stage, and the JSON report
+ * @function stageProfiler::enable(std::string, std::string, size_t), stageProfiler::begin(std::string, std::string),
+ *           stageProfiler::end(stage_mark, uint64_t), stageProfiler::writeReport(uint64_t), stageScope
+ * @note test cases check the measurements of known workloads, the stages of forked children, and the report contents
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/stageProfiler.h"
+
+namespace
+{
+	const std::string report_name = "../filter_output/test_stageProfiler.json";
+
+	std::string readReport()
+	{
+		std::ifstream file(report_name);
+		std::stringstream ss;
+		ss << file.rdbuf();
+		return ss.str();
+	}
+
+	TEST(stageProfiler, disabled)
+	{
+		stageProfiler profiler;
+		EXPECT_FALSE(profiler.enabled());
+		stage_mark mark = profiler.begin("stage", "");
+		EXPECT_FALSE(mark.active);
+		profiler.end(mark, 10);
+		EXPECT_EQ(profiler.count(), 0u);
+
+		/// Nothing to report, no file is written
+		remove(report_name.c_str());
+		EXPECT_TRUE(profiler.writeReport(0));
+		EXPECT_FALSE(std::ifstream(report_name).is_open());
+	}
+
+	TEST(stageProfiler, measurements)
+	{
+		stageProfiler profiler;
+		ASSERT_TRUE(profiler.enable(report_name, "test"));
+
+		stage_mark sleeping = profiler.begin("sleep", "50 ms");
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		profiler.end(sleeping, 1);
+
+		stage_mark busy = profiler.begin("busy", "");
+		volatile double sum = 0.0;
+		for (int i=0; i<20000000; ++i)
+		{
+			sum = sum + 1e-9 * i;
+		}
+		profiler.end(busy, 20000000);
+
+		/// 64 MB touched page by page raise the peak RSS by about as much
+		stage_mark allocating = profiler.begin("allocate", "");
+		std::vector<char> block(64 << 20);
+		for (std::size_t i=0; i<block.size(); i+=4096)
+		{
+			block[i] = 1;
+		}
+		profiler.end(allocating, block.size());
+
+		ASSERT_EQ(profiler.count(), 3u);
+		const stage_record& s = profiler.record(0);
+		EXPECT_STREQ(s.name, "sleep");
+		EXPECT_STREQ(s.detail, "50 ms");
+		EXPECT_EQ(s.pid.load(), ::getpid());
+		EXPECT_EQ(s.items, 1u);
+		EXPECT_GE(s.wall, 0.049);
+		EXPECT_LT(s.cpu, 0.5 * s.wall);
+
+		const stage_record& b = profiler.record(1);
+		EXPECT_EQ(b.items, 20000000u);
+		EXPECT_GT(b.cpu, 0.0);
+		EXPECT_GE(b.start, s.start + s.wall);
+
+		const stage_record& a = profiler.record(2);
+		EXPECT_GE(a.peak_rss_delta_kb, 32 * 1024);
+		EXPECT_GE(a.peak_rss_kb, a.peak_rss_delta_kb);
+	}
+
+	TEST(stageProfiler, forked_children)
+	{
+		stageProfiler profiler;
+		ASSERT_TRUE(profiler.enable(report_name, "test"));
+
+		pid_t pid = ::fork();
+		if (pid == 0)
+		{
+			stage_mark mark = profiler.begin("child", "plot worker");
+			profiler.end(mark, 7);
+			::_exit(0);
+		}
+		ASSERT_GT(pid, 0);
+		int status = 0;
+		::waitpid(pid, &status, 0);
+
+		ASSERT_EQ(profiler.count(), 1u);
+		EXPECT_STREQ(profiler.record(0).name, "child");
+		EXPECT_EQ(profiler.record(0).pid.load(), pid);
+		EXPECT_EQ(profiler.record(0).items, 7u);
+
+		/// Only the process that enabled the profiler writes the report; the child's stage is in it, marked as a worker
+		remove(report_name.c_str());
+		ASSERT_TRUE(profiler.writeReport(5));
+		std::string report = readReport();
+		EXPECT_NE(report.find("\"name\": \"child\", \"detail\": \"plot worker\", \"pid\": " + std::to_string(pid) + ", \"worker\": true"), std::string::npos);
+		remove(report_name.c_str());
+	}
+
+	TEST(stageProfiler, report)
+	{
+		stageProfiler profiler;
+		ASSERT_TRUE(profiler.enable(report_name, "test", 2));
+		for (int i=0; i<3; ++i)
+		{
+			stage_mark mark = profiler.begin("stage_" + std::to_string(i), "a \"quoted\"\\path\n");
+			profiler.end(mark, i);
+		}
+		EXPECT_EQ(profiler.count(), 2u);
+		EXPECT_EQ(profiler.dropped(), 1u);
+
+		ASSERT_TRUE(profiler.writeReport(1000));
+		std::string report = readReport();
+		EXPECT_EQ(report.front(), '{');
+		EXPECT_NE(report.find("\"schema\": \"pointonenav.stage_report.v1\""), std::string::npos);
+		EXPECT_NE(report.find("\"program\": \"test\""), std::string::npos);
+		EXPECT_NE(report.find("\"epochs\": 1000"), std::string::npos);
+		EXPECT_NE(report.find("\"name\": \"stage_0\", \"detail\": \"a \\\"quoted\\\"\\\\path\\u000a\""), std::string::npos);
+		EXPECT_NE(report.find("\"name\": \"stage_1\""), std::string::npos);
+		EXPECT_EQ(report.find("\"name\": \"stage_2\""), std::string::npos);
+		EXPECT_NE(report.find("\"dropped_stages\": 1"), std::string::npos);
+		EXPECT_NE(report.find("\"peak_rss_delta_kb\""), std::string::npos);
+		remove(report_name.c_str());
+	}
+
+	/// The stages instrumented in twoStateClockModel are recorded by the profiler of the process
+	TEST(stageProfiler, instrumented_stages)
+	{
+#ifdef POINTONENAV_INSTRUMENT
+		ASSERT_TRUE(stageProfiler::instance().enable(report_name, "test"));
+		std::unique_ptr<twoStateClockModel> clockModel(new twoStateClockModel(false, 1));
+		clockModel->setInputCache(false);
+		mat history;
+		clockModel->getInputData("measurement_history.txt", history);
+		clockModel->writeToFile("test_stageProfiler.txt", history);
+		remove("../filter_output/test_stageProfiler.txt");
+
+		ASSERT_EQ(stageProfiler::instance().count(), 2u);
+		EXPECT_STREQ(stageProfiler::instance().record(0).name, "getInputData");
+		EXPECT_STREQ(stageProfiler::instance().record(0).detail, "measurement_history.txt");
+		EXPECT_EQ(stageProfiler::instance().record(0).items, 2000u);
+		EXPECT_STREQ(stageProfiler::instance().record(1).name, "writeToFile");
+		EXPECT_EQ(stageProfiler::instance().record(1).items, 2000u);
+#else
+		std::cout << "Built without POINTONENAV_INSTRUMENT, nothing is recorded" << std::endl;
+#endif
+	}
+
+	TEST(stageProfiler, jsonString)
+	{
+		EXPECT_EQ(stageProfiler::jsonString("plain"), "\"plain\"");
+		EXPECT_EQ(stageProfiler::jsonString("a\"b\\c"), "\"a\\\"b\\\\c\"");
+		EXPECT_EQ(stageProfiler::jsonString("tab\there"), "\"tab\\u0009here\"");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
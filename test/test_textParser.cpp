@@ -0,0 +1,184 @@
+/**
+ * @file test_textParser.cpp
+ * @brief multi-threaded chunked parsing of the text input files
+ * @function textParser::parseRows(std::vector<std::vector<double>>), textParser::parseMatrix(mat)
+ * @note test cases check the parallel parse against a serial std::getline/operator>> reference on large files, including line breaks,
+ *       blank lines, carriage returns and tokens that are not numbers
+ * @note the throughput for an increasing number of threads is measured by BM_getInputData_threads in bench/bench_fileIO.cpp
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "../src/pointOneNav.h"
+#include "../src/bufferedWriter.h"
+#include "../src/textParser.h"
+
+namespace
+{
+	const std::string file_name = "../filter_output/test_textParser.txt";
+
+	/// Reference parse, the way readFromFile used to read the input files
+	std::vector<std::vector<double> > referenceParse(const std::string name)
+	{
+		std::vector<std::vector<double> > rows;
+		std::ifstream file_in(name);
+		std::string line;
+		while (std::getline(file_in, line))
+		{
+			std::stringstream ss(line);
+			std::string token;
+			std::vector<double> row;
+			while (ss >> token)
+			{
+				double value;
+				if (std::stringstream(token) >> value)
+				{
+					row.push_back(value);
+				}
+			}
+			rows.push_back(row);
+		}
+		return rows;
+	}
+
+	/// Measurement history sized file, rows x cols values in the filter input format
+	void writeHistory(const std::string name, int rows, int cols, const char* line_end)
+	{
+		std::mt19937_64 rng(42);
+		std::uniform_real_distribution<double> dist(-4.0e4, 4.0e4);
+		mat values(rows, cols);
+		for (int i=0; i<values.size(); ++i)
+		{
+			values(i) = dist(rng);
+		}
+		bufferedWriter writer;
+		writer.open(name);
+		for (int i=0; i<rows; ++i)
+		{
+			for (int j=0; j<cols; ++j)
+			{
+				writer.putChar(' ');
+				writer.putChar(' ');
+				writer.putDouble(values(i,j), j % 2 ? number_style::shortest : number_style::fixed16);
+			}
+			for (const char* c=line_end; *c; ++c)
+			{
+				writer.putChar(*c);
+			}
+		}
+		writer.close();
+	}
+
+	TEST(textParser, parseRows_large)
+	{
+		writeHistory(file_name, 2, 300000, "\r\n");
+		std::vector<std::vector<double> > expected = referenceParse(file_name);
+
+		for (unsigned threads : {1u, 2u, 3u, 8u})
+		{
+			textParser parser(threads);
+			ASSERT_TRUE(parser.open(file_name));
+			std::vector<std::vector<double> > rows;
+			parser.parseRows(rows);
+			ASSERT_TRUE(rows == expected) << threads << " threads";
+		}
+		remove(file_name.c_str());
+	}
+
+	TEST(textParser, parseMatrix_large)
+	{
+		writeHistory(file_name, 3, 200000, "\n");
+		std::vector<std::vector<double> > expected = referenceParse(file_name);
+
+		for (unsigned threads : {1u, 4u, 7u})
+		{
+			textParser parser(threads);
+			ASSERT_TRUE(parser.open(file_name));
+			mat output;
+			ASSERT_TRUE(parser.parseMatrix(output));
+			ASSERT_EQ(output.rows(), 3);
+			ASSERT_EQ(output.cols(), 200000);
+			for (int i=0; i<3; ++i)
+			{
+				for (int j=0; j<200000; ++j)
+				{
+					ASSERT_EQ(output(i,j), expected[i][j]);
+				}
+			}
+		}
+		remove(file_name.c_str());
+	}
+
+	TEST(textParser, parseRows_irregular)
+	{
+		const char* contents[] = {
+			"",
+			"\n",
+			"1.0 2.0",
+			"1.0 2.0\n\n3.0\n",
+			"  +1.5\t-2.5e-3 \r\n 4 5 6\n   ",
+			"1.0 abc 2.0\nxyz\n3.5x 7\n",
+			"1e308 -0.0 0.1 .5 5.\n"
+		};
+		for (auto text : contents)
+		{
+			{
+				std::ofstream file(file_name);
+				file << text;
+			}
+			std::vector<std::vector<double> > expected = referenceParse(file_name);
+			textParser parser(4);
+			ASSERT_TRUE(parser.open(file_name));
+			std::vector<std::vector<double> > rows;
+			parser.parseRows(rows);
+			EXPECT_TRUE(rows == expected) << "\"" << text << "\"";
+		}
+		remove(file_name.c_str());
+	}
+
+	TEST(textParser, parseMatrix_not_rectangular)
+	{
+		{
+			std::ofstream file(file_name);
+			file << "1.0 2.0\n3.0\n";
+		}
+		textParser parser;
+		ASSERT_TRUE(parser.open(file_name));
+		mat output;
+		EXPECT_FALSE(parser.parseMatrix(output));
+		remove(file_name.c_str());
+		EXPECT_FALSE(parser.open("../filter____output/test_textParser.txt"));
+	}
+
+	TEST(textParser, getInputData_parallel)
+	{
+		std::unique_ptr<twoStateClockModel> serial(new twoStateClockModel(false, 1));
+		std::unique_ptr<twoStateClockModel> parallel(new twoStateClockModel(false, 1));
+		serial->setParseThreads(1);
+		parallel->setParseThreads(8);
+
+		mat expected, output;
+		serial->getInputData("measurement_history.txt", expected);
+		parallel->getInputData("measurement_history.txt", output);
+		ASSERT_EQ(expected.cols(), 1000);
+		EXPECT_TRUE(expected == output);
+
+		std::vector<std::vector<double> > reference = referenceParse("../filter_input/measurement_history.txt");
+		for (int j=0; j<1000; ++j)
+		{
+			EXPECT_EQ(expected(0,j), reference[0][j]);
+			EXPECT_EQ(expected(1,j), reference[1][j]);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
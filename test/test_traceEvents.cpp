@@ -0,0 +1,180 @@
+/**
+ * @file test_traceEvents.cpp
+ * @brief scoped spans recorded into per-thread chunks of a shared pool, dumped as Chrome/Perfetto trace-event JSON
+ * @function traceRecorder::enable(std::string, size_t), traceRecorder::complete(...), traceRecorder::dump(), traceScope,
+ *           traceBatches::iteration(uint64_t)
+ * @note test cases use the classes directly, the TRACE_* macros only compile to them with POINTONENAV_TRACE
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+
+#include "../src/traceEvents.h"
+
+namespace
+{
+	std::string readTrace(const std::string file_name)
+	{
+		std::ifstream file(file_name);
+		std::stringstream text;
+		text << file.rdbuf();
+		return text.str();
+	}
+
+	std::size_t occurrences(const std::string& text, const std::string& pattern)
+	{
+		std::size_t n = 0;
+		for (std::size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1))
+		{
+			n++;
+		}
+		return n;
+	}
+
+	/// Spans started before enable, or with the recorder off, are not recorded
+	TEST(traceRecorder, disabled)
+	{
+		traceRecorder recorder;
+		EXPECT_FALSE(recorder.enabled());
+		EXPECT_EQ(recorder.now(), 0u);
+		recorder.complete("span", "test", NULL, 0, -1);
+		EXPECT_EQ(recorder.count(), 0u);
+		EXPECT_TRUE(recorder.dump());
+	}
+
+	/// Every thread writes to a chunk of its own, named after the thread
+	TEST(traceRecorder, threads)
+	{
+		traceRecorder& recorder = traceRecorder::instance();
+		ASSERT_TRUE(recorder.enable("../filter_output/test_trace_threads.json", 16));
+		{
+			traceScope scope("main span", "test", "detail \"quoted\"");
+			scope.setArg(42);
+		}
+		std::vector<std::thread> threads;
+		for (int t=0; t<4; ++t)
+		{
+			threads.push_back(std::thread([&recorder]()
+			{
+				recorder.setThreadName("worker");
+				for (int i=0; i<10; ++i)
+				{
+					traceScope scope("worker span", "test");
+				}
+			}));
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		EXPECT_EQ(recorder.count(), 41u);
+		EXPECT_EQ(recorder.dropped(), 0u);
+
+		ASSERT_TRUE(recorder.dump());
+		const std::string trace = readTrace("../filter_output/test_trace_threads.json");
+		EXPECT_EQ(occurrences(trace, "\"ph\": \"X\""), 41u);
+		EXPECT_EQ(occurrences(trace, "\"name\": \"thread_name\""), 4u);
+		EXPECT_EQ(occurrences(trace, "\"name\": \"process_name\""), 1u);
+		EXPECT_NE(trace.find("\"detail\": \"detail \\\"quoted\\\"\", \"count\": 42"), std::string::npos);
+		EXPECT_EQ(trace.find("{\"displayTimeUnit\""), 0u);
+		EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+	}
+
+	/// A forked child records into chunks of its own, dumped by the parent under the child's pid
+	TEST(traceRecorder, fork)
+	{
+		traceRecorder& recorder = traceRecorder::instance();
+		ASSERT_TRUE(recorder.enable("../filter_output/test_trace_fork.json", 16));
+		{
+			traceScope scope("parent span", "test");
+		}
+		const pid_t child = ::fork();
+		ASSERT_GE(child, 0);
+		if (child == 0)
+		{
+			recorder.setThreadName("child");
+			{
+				traceScope scope("child span", "test");
+			}
+			/// Only the process that enabled the recorder writes the trace
+			recorder.dump();
+			::_exit(0);
+		}
+		int status = 0;
+		ASSERT_EQ(::waitpid(child, &status, 0), child);
+		{
+			traceScope scope("parent span", "test");
+		}
+		EXPECT_EQ(recorder.count(), 3u);
+
+		ASSERT_TRUE(recorder.dump());
+		const std::string trace = readTrace("../filter_output/test_trace_fork.json");
+		EXPECT_EQ(occurrences(trace, "\"name\": \"process_name\""), 2u);
+		EXPECT_NE(trace.find("\"pid\": " + std::to_string(child)), std::string::npos);
+		EXPECT_NE(trace.find("ekf plot worker"), std::string::npos);
+		EXPECT_EQ(occurrences(trace, "\"parent span\""), 2u);
+	}
+
+	/// A long loop gives at most max_spans spans, each counting the iterations it covers
+	TEST(traceBatches, sampling)
+	{
+		traceRecorder& recorder = traceRecorder::instance();
+		ASSERT_TRUE(recorder.enable("../filter_output/test_trace_batches.json", 16));
+		const std::uint64_t n = 100000;
+		traceBatches batches("batch", "test", n, 100, 50);
+		for (std::uint64_t k=0; k<n; ++k)
+		{
+			batches.iteration(k);
+		}
+		batches.iteration(n);
+		EXPECT_EQ(recorder.count(), 50u);
+
+		ASSERT_TRUE(recorder.dump());
+		const std::string trace = readTrace("../filter_output/test_trace_batches.json");
+		EXPECT_EQ(occurrences(trace, "\"count\": 100}"), 50u);
+
+		/// A loop shorter than a batch is a single span, closed after the loop
+		ASSERT_TRUE(recorder.enable("../filter_output/test_trace_batches.json", 16));
+		traceBatches short_loop("batch", "test", 10);
+		for (std::uint64_t k=0; k<10; ++k)
+		{
+			short_loop.iteration(k);
+		}
+		short_loop.iteration(10);
+		ASSERT_TRUE(recorder.dump());
+		EXPECT_EQ(recorder.count(), 1u);
+		EXPECT_NE(readTrace("../filter_output/test_trace_batches.json").find("\"count\": 10}"), std::string::npos);
+	}
+
+	/// Full chunks are replaced by new ones; once the pool is used up the events are counted as dropped
+	TEST(traceRecorder, pool_exhaustion)
+	{
+		traceRecorder& recorder = traceRecorder::instance();
+		ASSERT_TRUE(recorder.enable("../filter_output/test_trace_pool.json", 2));
+		const std::size_t events = 3 * trace_chunk::capacity;
+		for (std::size_t i=0; i<events; ++i)
+		{
+			traceScope scope("span", "test");
+		}
+		EXPECT_EQ(recorder.count(), 2 * trace_chunk::capacity);
+		EXPECT_EQ(recorder.dropped(), trace_chunk::capacity);
+
+		ASSERT_TRUE(recorder.dump());
+		const std::string trace = readTrace("../filter_output/test_trace_pool.json");
+		EXPECT_EQ(occurrences(trace, "\"ph\": \"X\""), 2 * trace_chunk::capacity);
+		EXPECT_NE(trace.find("\"dropped_events\": " + std::to_string(trace_chunk::capacity)), std::string::npos);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	return RUN_ALL_TESTS();
+}
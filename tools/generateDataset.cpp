@@ -0,0 +1,95 @@
+/**
+ * @file generateDataset.cpp
+ * @brief generates synthetic datasets of the two-state clock model in the filter_input layout, with their ground truth, to
+ *        test and benchmark the filter on histories of any length (up to 10^9 epochs)
+ *
+ * @note
+ *
+ * - Usage: ./bin/generateDataset [options]
+ *	 - --epochs <n>: epochs per clock (default 1000000)
+ *	 - --clocks <n>: independent clocks, each written to a clock_<i> subdirectory when more than one (default 1)
+ *	 - --dt <s>: time step of the dynamics (default 1)
+ *	 - --seed <n>: the same seed gives the same dataset, whatever the number of threads (default 1)
+ *	 - --dropouts <p>: probability of an epoch without measurement, written as nan (default 0)
+ *	 - --outliers <p>, --outlier-scale <k>: probability of a measurement whose noise is k times larger (default 0, 20)
+ *	 - --jumps <p>, --jump-size <m>: probability of a clock bias jump, and its standard deviation in meters (default 0, 0)
+ *	 - --threads <n>: 0 uses all hardware threads (default 0)
+ *	 - --binary: also write the parsed-input cache sidecars, so ekf maps the histories in instead of parsing the text
+ *	 - --from <dir>: directory the initial state, its covariance, Q and R are read from (default ../filter_input)
+ *	 - --out <dir>: output directory (default ../filter_output/synthetic)
+ *	 - truth.txt holds the simulated clock bias and clock rate after each epoch, 2xN like measurement_history.txt
+ *
+ * - Example:
+ *	 $ ./bin/generateDataset --epochs 10000000 --dropouts 0.01 --binary
+ *	 $ ./bin/ekf --input-dir ../filter_output/synthetic --no-plot
+ *
+ ******************************************************************************************************************* */
+
+/// Std includes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+/// Simulation of the clock model
+#include "../src/clockSimulator.h"
+
+int main(int argc, char** argv)
+{
+	simulation_config config;
+	config.epochs = 1000000;
+	bool binary = false;
+	std::string from_dir = "../filter_input";
+	std::string out_dir = "../filter_output/synthetic";
+
+	for (int i=1; i<argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--clocks" and i+1 < argc)
+		{
+			config.clocks = std::atoi(argv[++i]);
+		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
+		else if (arg == "--from" and i+1 < argc)
+		{
+			from_dir = argv[++i];
+		}
+		else if (arg == "--out" and i+1 < argc)
+		{
+			out_dir = argv[++i];
+		}
+		else if (!clockSimulator::parseOption(argc, argv, i, config))
+		{
+			std::cerr << "Unknown option " << arg << std::endl;
+			return -1;
+		}
+	}
+	if (config.epochs == 0 or config.clocks == 0)
+	{
+		std::cerr << "Nothing to generate, --epochs and --clocks must be positive" << std::endl;
+		return -1;
+	}
+
+	/// The noise and the initial state of the model the filter is configured with
+	if (!clockSimulator::readModel(from_dir, config))
+	{
+		return -1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	clockSimulator simulator(config);
+	if (!simulator.write(out_dir, binary))
+	{
+		return -1;
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	const double epochs = static_cast<double>(config.epochs) * config.clocks;
+	std::cout << config.clocks << " x " << config.epochs << " epochs written to " << out_dir << " in " << elapsed.count()
+		<< " s, " << epochs / elapsed.count() / 1e6 << " M epochs/s" << std::endl;
+	return 0;
+}
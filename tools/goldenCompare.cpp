@@ -0,0 +1,126 @@
+/**
+ * @file goldenCompare.cpp
+ * @brief runs the reference simpleEKF and an alternative filter engine on the same simulated inputs, and reports the first
+ *        epoch where their state, covariance or NIS diverge and the worst-case error
+ *
+ * @note
+ *
+ * - Usage: ./bin/goldenCompare [options]
+ *	 - --engine <name>: the engine compared with the reference, one of the engines listed by --list (default fixed)
+ *	 - --epochs <n>: epochs simulated (default 1000000)
+ *	 - --seed <n>, --dt <s>, --dropouts <p>, --outliers <p>, --outlier-scale <k>, --jumps <p>, --jump-size <m>: the simulated dataset,
+ *	   as for generateDataset
+ *	 - --ulps <n>: values within n units in the last place are equal (default 4)
+ *	 - --relative <r>: values within r of the larger magnitude are equal (default 1e-10)
+ *	 - --threads <n>: threads simulating and comparing, 0 uses all hardware threads (default 0)
+ *	 - --from <dir>: directory the initial state, its covariance, Q and R are read from (default ../filter_input)
+ *	 - exits with 1 when the engine diverges from the reference
+ *
+ * - Example:
+ *	 $ ./bin/goldenCompare --engine fixed --epochs 10000000 --dropouts 0.01 --outliers 0.001
+ *
+ ******************************************************************************************************************* */
+
+/// Std includes
+#include <iostream>
+#include <string>
+#include <map>
+#include <chrono>
+#include <cstdlib>
+
+/// Golden-output comparison and simulated inputs
+#include "../src/goldenHarness.h"
+#include "../src/clockSimulator.h"
+
+int main(int argc, char** argv)
+{
+	simulation_config config;
+	config.epochs = 1000000;
+	golden_tolerance tolerance;
+	std::string engine_name = "fixed";
+	std::string from_dir = "../filter_input";
+	bool list = false;
+
+	for (int i=1; i<argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--engine" and i+1 < argc)
+		{
+			engine_name = argv[++i];
+		}
+		else if (arg == "--list")
+		{
+			list = true;
+		}
+		else if (arg == "--ulps" and i+1 < argc)
+		{
+			tolerance.max_ulps = std::strtoull(argv[++i], NULL, 10);
+		}
+		else if (arg == "--relative" and i+1 < argc)
+		{
+			tolerance.max_relative = std::atof(argv[++i]);
+		}
+		else if (arg == "--from" and i+1 < argc)
+		{
+			from_dir = argv[++i];
+		}
+		else if (!clockSimulator::parseOption(argc, argv, i, config))
+		{
+			std::cerr << "Unknown option " << arg << std::endl;
+			return -1;
+		}
+	}
+
+	/// Engines compared with the reference; an alternative implementation of the filter is added here to be checked
+	std::map<std::string, filter_engine> engines;
+	engines["reference"] = goldenHarness::referenceEngine(config.dt);
+	engines["fixed"] = goldenHarness::fixedSizeEngine(config.dt);
+	if (list)
+	{
+		for (auto it=engines.begin(); it!=engines.end(); it++)
+		{
+			std::cout << it->first << std::endl;
+		}
+		return 0;
+	}
+	if (engines.count(engine_name) == 0)
+	{
+		std::cerr << "Unknown engine " << engine_name << ", --list shows the engines" << std::endl;
+		return -1;
+	}
+	if (config.epochs == 0)
+	{
+		std::cerr << "Nothing to compare, --epochs must be positive" << std::endl;
+		return -1;
+	}
+
+	/// The noise and the initial state of the model the filter is configured with
+	if (!clockSimulator::readModel(from_dir, config))
+	{
+		return -1;
+	}
+
+	filter_input f_in;
+	Eigen::MatrixXd truth;
+	if (!clockSimulator(config).simulate(0, 0, config.epochs, truth, f_in.measurement_history))
+	{
+		return -1;
+	}
+	f_in.initial_state_estimate = config.initial_state;
+	f_in.initial_state_estimate_covariance = config.initial_covariance;
+	f_in.process_noise_covariance = config.process_noise_covariance;
+	f_in.measurement_noise_covariance = config.measurement_noise_covariance;
+
+	auto start = std::chrono::steady_clock::now();
+	filter_history golden, tested;
+	engines["reference"](f_in, golden);
+	std::chrono::duration<double> reference_time = std::chrono::steady_clock::now() - start;
+	start = std::chrono::steady_clock::now();
+	engines[engine_name](f_in, tested);
+	std::chrono::duration<double> engine_time = std::chrono::steady_clock::now() - start;
+
+	golden_report report = goldenHarness::compare(golden, tested, tolerance, config.threads);
+	std::cout << "reference: " << reference_time.count() << " s, " << engine_name << ": " << engine_time.count() << " s" << std::endl;
+	std::cout << goldenHarness::describe(report);
+	return report.diverged ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file pyramidQuery.cpp
+ * @brief extracts a time window of the output pyramid written by ekf (filter_output.p1pyr) to the filter output text format
+ *
+ * @note
+ *
+ * - Usage: ./bin/pyramidQuery [--from <t>] [--to <t>] [--points <n> | --level <L>] [--out <file>] [pyramid file]
+ *	 - --from, --to: the time window, the whole run by default
+ *	 - --points: the finest level showing the window with at most n records is read (default 4000)
+ *	 - --level: read the given level instead, 0 is full resolution and level L summarizes 2^L epochs per record
+ *	 - --out: text file to write, stdout by default
+ *	 - --info: print the levels of the pyramid instead
+ *	 - the pyramid defaults to ../filter_output/filter_output.p1pyr
+ *
+ * - Output: the first row holds the start time of each record, the next rows the values: one row per series (bias, rate,
+ *   NIS) at level 0, and three rows per series (min, max, mean) at the higher levels; one column per record
+ *
+ * - Example:
+ *	 $ ./bin/pyramidQuery --from 2000 --to 3000 --points 500 --out ../filter_output/zoom.txt
+ *
+ ******************************************************************************************************************* */
+
+/// Std includes
+#include <iostream>
+#include <string>
+#include <limits>
+#include <cstdlib>
+#include <unistd.h>
+
+/// Pyramid reader and the number formatting of the filter outputs
+#include "../src/outputPyramid.h"
+#include "../src/bufferedWriter.h"
+
+int main(int argc, char** argv)
+{
+	std::string file_name = "../filter_output/filter_output.p1pyr";
+	std::string out_name;
+	double t_begin = -std::numeric_limits<double>::infinity();
+	double t_end = std::numeric_limits<double>::infinity();
+	long points = 4000;
+	long level = -1;
+	bool info = false;
+	for (int i=1; i<argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--from" and i+1 < argc)
+		{
+			t_begin = std::atof(argv[++i]);
+		}
+		else if (arg == "--to" and i+1 < argc)
+		{
+			t_end = std::atof(argv[++i]);
+		}
+		else if (arg == "--points" and i+1 < argc)
+		{
+			points = std::atol(argv[++i]);
+		}
+		else if (arg == "--level" and i+1 < argc)
+		{
+			level = std::atol(argv[++i]);
+		}
+		else if (arg == "--out" and i+1 < argc)
+		{
+			out_name = argv[++i];
+		}
+		else if (arg == "--info")
+		{
+			info = true;
+		}
+		else
+		{
+			file_name = arg;
+		}
+	}
+
+	outputPyramid pyramid;
+	if (!pyramid.open(file_name))
+	{
+		return -1;
+	}
+	const pyramid_header& header = pyramid.info();
+	if (info)
+	{
+		std::cout << header.channels << " series, " << header.epochs << " epochs from " << header.t0 << " every " << header.dt << std::endl;
+		for (std::size_t l=0; l<pyramid.levels().size(); ++l)
+		{
+			std::cout << "level " << l << ": " << pyramid.levels()[l].count << " records of " << pyramid.levels()[l].factor << " epochs" << std::endl;
+		}
+		return 0;
+	}
+
+	/// The whole run by default
+	t_begin = std::max(t_begin, header.t0);
+	t_end = std::min(t_end, header.t0 + header.dt * (header.epochs - 1));
+	if (level < 0)
+	{
+		level = pyramid.levelFor(t_begin, t_end, std::max(points, 1L));
+	}
+
+	pyramid_window window;
+	if (!pyramid.read(t_begin, t_end, static_cast<std::uint32_t>(level), window))
+	{
+		std::cerr << "Error reading the window [" << t_begin << ", " << t_end << "] at level " << level << std::endl;
+		return -1;
+	}
+
+	Eigen::MatrixXd output(window.values.rows() + 1, window.values.cols());
+	output.row(0) = Eigen::Map<const Eigen::RowVectorXd>(window.time.data(), window.time.size());
+	output.bottomRows(window.values.rows()) = window.values;
+
+	bufferedWriter file;
+	bool opened = out_name.empty() ? file.open([](const char* data, const std::size_t size)
+	{
+		return ::write(STDOUT_FILENO, data, size) == static_cast<ssize_t>(size);
+	}) : file.open(out_name);
+	if (!opened)
+	{
+		std::cerr << "Error writing to " << out_name << std::endl;
+		return -1;
+	}
+	file.putMatrix(output, matrix_layout::matrix, number_style::fixed16);
+	if (!file.close())
+	{
+		std::cerr << "Error writing to " << (out_name.empty() ? "stdout" : out_name) << std::endl;
+		return -1;
+	}
+	std::cerr << "level " << level << ", " << window.values.cols() << " records of " << window.factor << " epochs" << std::endl;
+	return 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file replay.cpp
+ * @brief replays a measurement history file one epoch at a time, to test the live filter mode (ekf --live) locally
+ *
+ * @note
+ *
+ * - Usage: ./bin/replay [--rate <Hz>] [--repeat <n>] [--to <target>] [measurement history file]
+ *	 - --rate: epochs per second, 0 sends as fast as possible (default 10)
+ *	 - --repeat: number of passes over the history (default 1)
+ *	 - --to: "stdout" (default), "fifo:<path>", "unix:<path>" or "udp:<port>", matching the ekf --live sources
+ *	 - the history defaults to ../filter_input/measurement_history.txt, 2xN with one column per epoch
+ *
+ * - Example:
+ *	 $ ./bin/ekf --live unix:/tmp/p1nav.sock &
+ *	 $ ./bin/replay --rate 1000 --to unix:/tmp/p1nav.sock
+ *
+ ******************************************************************************************************************* */
+
+/// Std includes
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+
+/// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/// Number formatting shared with the filter outputs
+#include "../src/bufferedWriter.h"
+
+/**
+ * @brief readHistory read the rows of a whitespace separated text matrix
+ * @param file_name the file name, read the values from
+ * @param rows vector to hold the values of every row
+ * @return boolean value
+ */
+bool readHistory(const std::string file_name, std::vector<std::vector<double> >& rows)
+{
+	std::ifstream file_in(file_name);
+	if (!file_in.is_open())
+	{
+		std::cerr << "Error opening the file " << file_name << std::endl;
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file_in, line))
+	{
+		std::stringstream ss(line);
+		std::vector<double> row;
+		double value;
+		while (ss >> value)
+		{
+			row.push_back(value);
+		}
+		if (!row.empty())
+		{
+			rows.push_back(row);
+		}
+	}
+	return rows.size() >= 2 and rows[0].size() == rows[1].size();
+}
+
+/**
+ * @brief openTarget connect to the target the epochs are sent to, waiting for the live filter to be ready
+ * @param target "stdout", "fifo:<path>", "unix:<path>" or "udp:<port>"
+ * @param udp_addr filled with the destination address for "udp:"
+ * @return file descriptor, -1 on error
+ */
+int openTarget(const std::string target, struct sockaddr_in& udp_addr)
+{
+	if (target == "stdout" or target == "-")
+	{
+		return STDOUT_FILENO;
+	}
+	if (target.compare(0, 5, "fifo:") == 0)
+	{
+		/// Opening a pipe for writing waits until the filter has opened it for reading
+		return ::open(target.substr(5).c_str(), O_WRONLY);
+	}
+	if (target.compare(0, 5, "unix:") == 0)
+	{
+		struct sockaddr_un addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		std::strncpy(addr.sun_path, target.substr(5).c_str(), sizeof(addr.sun_path) - 1);
+
+		/// Retry for a few seconds while the filter starts listening
+		for (int attempt=0; attempt<100; ++attempt)
+		{
+			int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+			if (fd >= 0 and ::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0)
+			{
+				return fd;
+			}
+			::close(fd);
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+		return -1;
+	}
+	if (target.compare(0, 4, "udp:") == 0)
+	{
+		std::memset(&udp_addr, 0, sizeof(udp_addr));
+		udp_addr.sin_family = AF_INET;
+		udp_addr.sin_port = htons(static_cast<uint16_t>(std::atoi(target.substr(4).c_str())));
+		udp_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		return ::socket(AF_INET, SOCK_DGRAM, 0);
+	}
+	return -1;
+}
+
+/**
+ * @brief main
+ * @return int
+ */
+int main(int argc, char** argv)
+{
+	double rate = 10.0;
+	int repeat = 1;
+	std::string target = "stdout";
+	std::string file_name = "../filter_input/measurement_history.txt";
+
+	for (int i=1; i<argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--rate" and i+1 < argc)
+		{
+			rate = std::atof(argv[++i]);
+		}
+		else if (arg == "--repeat" and i+1 < argc)
+		{
+			repeat = std::atoi(argv[++i]);
+		}
+		else if (arg == "--to" and i+1 < argc)
+		{
+			target = argv[++i];
+		}
+		else
+		{
+			file_name = arg;
+		}
+	}
+
+	std::vector<std::vector<double> > rows;
+	if (!readHistory(file_name, rows))
+	{
+		std::cerr << "Error reading the measurement history, expected two rows of equal length!" << std::endl;
+		return -1;
+	}
+
+	/// A reader going away should end the replay, not kill it
+	std::signal(SIGPIPE, SIG_IGN);
+
+	struct sockaddr_in udp_addr;
+	bool udp = target.compare(0, 4, "udp:") == 0;
+	int fd = openTarget(target, udp_addr);
+	if (fd < 0)
+	{
+		std::cerr << "Error opening the replay target " << target << std::endl;
+		return -1;
+	}
+
+	/// Epochs are sent on an absolute schedule, so slow writes do not add up to a drift
+	auto period = std::chrono::duration<double>(rate > 0.0 ? 1.0 / rate : 0.0);
+	auto start = std::chrono::steady_clock::now();
+	std::size_t sent = 0;
+	bool ok = true;
+
+	for (int pass=0; pass<repeat and ok; ++pass)
+	{
+		for (std::size_t k=0; k<rows[0].size() and ok; ++k)
+		{
+			char line[80];
+			char* last = bufferedWriter::formatDouble(line, rows[0][k], number_style::fixed16);
+			*last++ = ' ';
+			last = bufferedWriter::formatDouble(last, rows[1][k], number_style::fixed16);
+			*last++ = '\n';
+
+			if (rate > 0.0)
+			{
+				std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(period * sent));
+			}
+
+			ssize_t n = udp ? ::sendto(fd, line, last - line, 0, reinterpret_cast<struct sockaddr*>(&udp_addr), sizeof(udp_addr))
+							: ::write(fd, line, last - line);
+			ok = n == last - line;
+			sent++;
+		}
+	}
+
+	/// An empty datagram tells a UDP reader the replay is over
+	if (udp)
+	{
+		::sendto(fd, "", 0, 0, reinterpret_cast<struct sockaddr*>(&udp_addr), sizeof(udp_addr));
+	}
+	if (fd != STDOUT_FILENO)
+	{
+		::close(fd);
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::cerr << "Replayed " << sent << " epochs in " << elapsed.count() << " s" << std::endl;
+	return ok ? 0 : -1;
+}